@@ -43,7 +43,7 @@ QT_BEGIN_NAMESPACE
 // Also change the comment behind the number to describe the latest change. This has the added
 // benefit that if another patch changes the version too, it will result in a merge conflict, and
 // not get removed silently.
-#define QV4_DATA_STRUCTURE_VERSION 0x37 // Added flag for call-type method lookups
+#define QV4_DATA_STRUCTURE_VERSION 0x38 // Added flag for bindings with static dependencies
 
 class QIODevice;
 class QQmlTypeNameCache;
@@ -312,6 +312,7 @@ struct Function
         IsArrowFunction     = 0x2,
         IsGenerator         = 0x4,
         IsClosureWrapper    = 0x8,
+        HasStaticDependencies = 0x10,
     };
 
     // Absolute offset into file where the code for this function is located.
@@ -1885,8 +1885,171 @@ JSCodeGen::JSCodeGen(Document *document, const QSet<QString> &globalNames,
     _fileNameIsUrl = true;
 }
 
+static bool isComponentTypeName(QStringView name)
+{
+    return name == QLatin1String("Component") || name.endsWith(QLatin1String(".Component"));
+}
+
+static bool isComponentObject(const Document *document, const Object *object)
+{
+    return object->hasFlag(QV4::CompiledData::Object::IsComponent)
+            || isComponentTypeName(document->stringAt(object->inheritedTypeNameIndex));
+}
+
+/*
+    Returns true if \a child, assigned to \a parent through \a binding, may be
+    the root of a new component. Without type information, only properties
+    declared in this document are known not to hold components. Once
+    QQmlComponentAndAliasResolver has run, implicit components are wrapped in
+    synthetic Component objects, and \a resolved is true.
+*/
+static bool mayStartComponent(const Document *document, const Object *parent,
+                              const Binding *binding, const Object *child, bool resolved)
+{
+    if (isComponentObject(document, child))
+        return true;
+    if (binding->type() != QV4::CompiledData::Binding::Type_Object || resolved)
+        return false;
+    for (const Property *property = parent->firstProperty(); property; property = property->next) {
+        if (property->nameIndex == binding->propertyNameIndex) {
+            return !property->isBuiltinType()
+                    && isComponentTypeName(document->stringAt(property->customType()));
+        }
+    }
+    return true;
+}
+
+/*
+    Maps every object of the document to the ids of the component it is
+    created in. Those are the only ids a binding of the object is guaranteed to
+    resolve to: other names may be found on the scope object first.
+*/
+static QHash<const Object *, QStringList> idsInComponents(const Document *document)
+{
+    bool resolved = false;
+    for (const Object *object : document->objects) {
+        if (object->idNameIndex != emptyStringIndex && object->id != -1)
+            resolved = true;
+    }
+
+    // Parents in the same component, and the parents of explicit Component
+    // objects, which themselves are created in the outer component.
+    QHash<const Object *, const Object *> parents;
+    QHash<const Object *, const Object *> componentParents;
+    for (const Object *object : document->objects) {
+        for (const Binding *binding = object->firstBinding(); binding; binding = binding->next) {
+            if (binding->type() != QV4::CompiledData::Binding::Type_Object
+                    && !binding->isAttachedProperty() && !binding->isGroupProperty()) {
+                continue;
+            }
+            const Object *child = document->objects.at(binding->value.objectIndex);
+            if (!mayStartComponent(document, object, binding, child, resolved))
+                parents.insert(child, object);
+            else if (isComponentObject(document, child))
+                componentParents.insert(child, object);
+        }
+    }
+
+    auto componentRoot = [&](const Object *object) {
+        for (auto it = parents.constFind(object); it != parents.constEnd();
+             it = parents.constFind(object)) {
+            object = *it;
+        }
+        return object;
+    };
+
+    QHash<const Object *, QStringList> ids;
+    for (const Object *object : document->objects) {
+        if (object->idNameIndex == emptyStringIndex)
+            continue;
+        const Object *owner = componentParents.value(object, object);
+        ids[componentRoot(owner)].append(document->stringAt(object->idNameIndex));
+    }
+
+    QHash<const Object *, QStringList> result;
+    for (const Object *object : document->objects)
+        result.insert(object, ids.value(componentRoot(object)));
+    return result;
+}
+
+/*
+    Returns true if every evaluation of the binding expression \a node reads the
+    same properties, so that its dependencies only need to be captured once.
+
+    This holds for expressions without control flow and calls that only read
+    plain names and members of ids or types. Members of other objects are not
+    accepted, as the object itself may change between evaluations. \a idNames
+    holds the ids of the binding's component.
+*/
+static bool hasStaticDependencies(const QStringList &idNames, QQmlJS::AST::Node *node)
+{
+    using namespace QQmlJS::AST;
+
+    switch (node->kind) {
+    case Node::Kind_ExpressionStatement:
+        return hasStaticDependencies(idNames, static_cast<ExpressionStatement *>(node)->expression);
+    case Node::Kind_NestedExpression:
+        return hasStaticDependencies(idNames, static_cast<NestedExpression *>(node)->expression);
+    case Node::Kind_NumericLiteral:
+    case Node::Kind_StringLiteral:
+    case Node::Kind_TrueLiteral:
+    case Node::Kind_FalseLiteral:
+    case Node::Kind_NullExpression:
+    case Node::Kind_IdentifierExpression:
+        return true;
+    case Node::Kind_FieldMemberExpression: {
+        auto member = static_cast<FieldMemberExpression *>(node);
+        if (member->isOptional || member->base->kind != Node::Kind_IdentifierExpression)
+            return false;
+        const QStringView base = static_cast<IdentifierExpression *>(member->base)->name;
+        // Upper case names refer to types, namespaces and their attached objects
+        return base.at(0).isUpper() || idNames.contains(base);
+    }
+    case Node::Kind_UnaryMinusExpression:
+        return hasStaticDependencies(idNames, static_cast<UnaryMinusExpression *>(node)->expression);
+    case Node::Kind_UnaryPlusExpression:
+        return hasStaticDependencies(idNames, static_cast<UnaryPlusExpression *>(node)->expression);
+    case Node::Kind_NotExpression:
+        return hasStaticDependencies(idNames, static_cast<NotExpression *>(node)->expression);
+    case Node::Kind_TildeExpression:
+        return hasStaticDependencies(idNames, static_cast<TildeExpression *>(node)->expression);
+    case Node::Kind_BinaryExpression: {
+        auto binary = static_cast<BinaryExpression *>(node);
+        switch (binary->op) {
+        case QSOperator::Add:
+        case QSOperator::Sub:
+        case QSOperator::Mul:
+        case QSOperator::Div:
+        case QSOperator::Mod:
+        case QSOperator::Exp:
+        case QSOperator::BitAnd:
+        case QSOperator::BitOr:
+        case QSOperator::BitXor:
+        case QSOperator::LShift:
+        case QSOperator::RShift:
+        case QSOperator::URShift:
+        case QSOperator::Equal:
+        case QSOperator::NotEqual:
+        case QSOperator::StrictEqual:
+        case QSOperator::StrictNotEqual:
+        case QSOperator::Lt:
+        case QSOperator::Le:
+        case QSOperator::Gt:
+        case QSOperator::Ge:
+            return hasStaticDependencies(idNames, binary->left)
+                    && hasStaticDependencies(idNames, binary->right);
+        default:
+            // Short-circuiting operators only read their right hand side conditionally
+            return false;
+        }
+    }
+    default:
+        return false;
+    }
+}
+
 QVector<int> JSCodeGen::generateJSCodeForFunctionsAndBindings(
-        const QList<CompiledFunctionOrExpression> &functions)
+        const QList<CompiledFunctionOrExpression> &functions, const QStringList &idNames)
 {
     auto qmlName = [&](const CompiledFunctionOrExpression &c) {
         if (c.nameIndex != 0)
@@ -1959,6 +2122,8 @@ QVector<int> JSCodeGen::generateJSCodeForFunctionsAndBindings(
         int idx = defineFunction(name, function ? function : qmlFunction.parentNode,
                                  function ? function->formals : nullptr, body);
         runtimeFunctionIndices[i] = idx;
+        if (!function && hasStaticDependencies(idNames, node))
+            _module->functions.at(idx)->hasStaticDependencies = true;
     }
 
     return runtimeFunctionIndices;
@@ -1976,7 +2141,11 @@ bool JSCodeGen::generateRuntimeFunctions(QmlIR::Object *object)
         functionsToCompile << *foe;
     }
 
-    const auto runtimeFunctionIndices = generateJSCodeForFunctionsAndBindings(functionsToCompile);
+    if (m_idsInComponents.isEmpty())
+        m_idsInComponents = idsInComponents(document);
+
+    const auto runtimeFunctionIndices = generateJSCodeForFunctionsAndBindings(
+            functionsToCompile, m_idsInComponents.value(object));
     if (hasError())
         return false;
 
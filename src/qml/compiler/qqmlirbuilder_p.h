@@ -581,13 +581,16 @@ struct Q_QML_COMPILER_PRIVATE_EXPORT JSCodeGen : public QV4::Compiler::Codegen
               bool storeSourceLocations = false);
 
     // Returns mapping from input functions to index in IR::Module::functions / compiledData->runtimeFunctions
+    // idNames are the ids of the component the functions belong to
     QVector<int>
-    generateJSCodeForFunctionsAndBindings(const QList<CompiledFunctionOrExpression> &functions);
+    generateJSCodeForFunctionsAndBindings(const QList<CompiledFunctionOrExpression> &functions,
+                                          const QStringList &idNames = QStringList());
 
     bool generateRuntimeFunctions(QmlIR::Object *object);
 
 private:
     Document *document;
+    QHash<const Object *, QStringList> m_idsInComponents;
 };
 
 // RegisterStringN ~= std::function<int(QStringView)>
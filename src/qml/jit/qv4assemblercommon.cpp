@@ -89,7 +89,7 @@ static void printDisassembledOutputWithCalls(QByteArray processedOutput,
 JIT::PlatformAssemblerCommon::~PlatformAssemblerCommon()
 {}
 
-void PlatformAssemblerCommon::link(Function *function, const char *jitKind)
+Function::JitResult PlatformAssemblerCommon::link(Function *function, const char *jitKind)
 {
     for (const auto &jumpTarget : jumpsToLink)
         jumpTarget.jump.linkTo(labelForOffset[jumpTarget.offset], this);
@@ -121,13 +121,16 @@ void PlatformAssemblerCommon::link(Function *function, const char *jitKind)
         codeRef = linkBuffer.finalizeCodeWithoutDisassembly();
     }
 
-    function->codeRef = new JSC::MacroAssemblerCodeRef(codeRef);
-    function->jittedCode = reinterpret_cast<Function::JittedCode>(function->codeRef->code().executableAddress());
+    // This may run on a worker thread, so don't touch the function itself here.
+    Function::JitResult result;
+    result.codeRef = new JSC::MacroAssemblerCodeRef(codeRef);
+    result.jittedCode = reinterpret_cast<Function::JittedCode>(result.codeRef->code().executableAddress());
 
     generateFunctionTable(function, &codeRef);
 
     if (Q_UNLIKELY(!linkBuffer.makeExecutable()))
-        function->jittedCode = nullptr; // The function is not executable, but the coderef exists.
+        result.jittedCode = nullptr; // The function is not executable, but the coderef exists.
+    return result;
 }
 
 void PlatformAssemblerCommon::prepareCallWithArgCount(int argc)
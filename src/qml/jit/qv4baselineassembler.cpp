@@ -8,6 +8,7 @@
 #include "qv4baselineassembler_p.h"
 #include "qv4assemblercommon_p.h"
 #include <private/qv4function_p.h>
+#include <private/qv4lookup_p.h>
 #include <private/qv4runtime_p.h>
 #include <private/qv4stackframe_p.h>
 
@@ -316,6 +317,71 @@ public:
         return done;
     }
 
+    // loads an int or double value in src as a double into dest, and jumps to notNumber otherwise
+    void loadNumberAsDouble(RegisterID src, FPRegisterID dest, JumpList &notNumber)
+    {
+        urshift64(src, TrustedImm32(32), ScratchRegister2);
+        Jump notInt = branch32(NotEqual, TrustedImm32(int(IntegerTag)), ScratchRegister2);
+        convertInt32ToDouble(src, dest);
+        Jump done = jump();
+
+        notInt.link(this);
+        urshift64(src, TrustedImm32(Value::IsDouble_Shift), ScratchRegister2);
+        notNumber.append(branch32(Equal, TrustedImm32(0), ScratchRegister2));
+        move(TrustedImm64(Value::NaNEncodeMask), ScratchRegister2);
+        xor64(src, ScratchRegister2);
+        move64ToDouble(ScratchRegister2, dest);
+
+        done.link(this);
+    }
+
+    // fastPath computes FPScratchRegister = FPScratchRegister op FPScratchRegister2
+    JumpList binopBothNumberPath(Address lhsAddr, std::function<void(void)> fastPath)
+    {
+        JumpList notNumber;
+        JumpList done;
+        load64(lhsAddr, ScratchRegister);
+        loadNumberAsDouble(ScratchRegister, FPScratchRegister, notNumber);
+        loadNumberAsDouble(AccumulatorRegister, FPScratchRegister2, notNumber);
+
+        // both numbers
+        fastPath();
+        Jump isNaN = branchDouble(DoubleNotEqualOrUnordered, FPScratchRegister, FPScratchRegister);
+        encodeDoubleIntoAccumulator(FPScratchRegister);
+        done.append(jump());
+
+        // NaNs are stored in their canonical encoding, like Value::setDouble() does
+        isNaN.link(this);
+        loadValue(Value::fromDouble(qt_qnan()).asReturnedValue());
+        done.append(jump());
+
+        // all other cases
+        notNumber.link(this);
+
+        return done;
+    }
+
+    // Inline version of Lookup::getter0Inline(). The returned jumps are taken if the value is
+    // not a heap object, or if the lookup or the object's internal class have changed since.
+    JumpList getter0InlineFastPath(const Lookup *l)
+    {
+        JumpList slowPath;
+        urshift64(AccumulatorRegister, TrustedImm32(Value::IsManagedOrUndefined_Shift), ScratchRegister);
+        slowPath.append(branch32(NotEqual, TrustedImm32(0), ScratchRegister));
+        slowPath.append(branch64(Equal, AccumulatorRegister, TrustedImm64(0)));
+
+        move(TrustedImmPtr(l), ScratchRegister);
+        slowPath.append(branchPtr(NotEqual, Address(ScratchRegister, offsetof(Lookup, getter)),
+                                  TrustedImmPtr(reinterpret_cast<void *>(&Lookup::getter0Inline))));
+        loadPtr(Address(ScratchRegister, offsetof(Lookup, objectLookup.ic)), ScratchRegister2);
+        slowPath.append(branchPtr(NotEqual, Address(AccumulatorRegister, offsetof(Heap::Base, internalClass)),
+                                  ScratchRegister2));
+
+        load32(Address(ScratchRegister, offsetof(Lookup, objectLookup.offset)), ScratchRegister2);
+        load64(BaseIndex(AccumulatorRegister, ScratchRegister2, TimesEight), AccumulatorRegister);
+        return slowPath;
+    }
+
     Jump unopIntPath(std::function<Jump(void)> fastPath)
     {
         urshift64(AccumulatorRegister, TrustedImm32(Value::IsIntegerConvertible_Shift), ScratchRegister);
@@ -742,6 +808,34 @@ public:
         return done;
     }
 
+    JumpList binopBothNumberPath(Address, std::function<void(void)>)
+    {
+        // doubles are left to the runtime call on 32 bit platforms
+        return JumpList();
+    }
+
+    JumpList getter0InlineFastPath(const Lookup *l)
+    {
+        JumpList slowPath;
+        slowPath.append(branch32(NotEqual, AccumulatorRegisterTag,
+                                 TrustedImm32(Value::Managed_Type_Internal)));
+        slowPath.append(branch32(Equal, AccumulatorRegisterValue, TrustedImm32(0)));
+
+        move(TrustedImmPtr(l), ScratchRegister);
+        slowPath.append(branchPtr(NotEqual, Address(ScratchRegister, offsetof(Lookup, getter)),
+                                  TrustedImmPtr(reinterpret_cast<void *>(&Lookup::getter0Inline))));
+        loadPtr(Address(ScratchRegister, offsetof(Lookup, objectLookup.ic)), ScratchRegister);
+        slowPath.append(branchPtr(NotEqual, Address(AccumulatorRegisterValue, offsetof(Heap::Base, internalClass)),
+                                  ScratchRegister));
+
+        move(TrustedImmPtr(l), ScratchRegister);
+        load32(Address(ScratchRegister, offsetof(Lookup, objectLookup.offset)), ScratchRegister);
+        lshift32(TrustedImm32(3), ScratchRegister);
+        add32(AccumulatorRegisterValue, ScratchRegister);
+        loadAccumulator(Address(ScratchRegister, 0));
+        return slowPath;
+    }
+
     Jump unopIntPath(std::function<Jump(void)> fastPath)
     {
         Jump accNotInt = branch32(NotEqual, TrustedImm32(int(IntegerTag)), AccumulatorRegisterTag);
@@ -811,9 +905,9 @@ void BaselineAssembler::generateEpilogue()
     pasm()->generateCatchTrampoline();
 }
 
-void BaselineAssembler::link(Function *function)
+Function::JitResult BaselineAssembler::link(Function *function)
 {
-    pasm()->link(function, "BaselineJIT");
+    return pasm()->link(function, "BaselineJIT");
 }
 
 void BaselineAssembler::addLabel(int offset)
@@ -900,6 +994,19 @@ void BaselineAssembler::loadImport(int index)
     pasm()->loadAccumulator(Address(PlatformAssembler::ScratchRegister));
 }
 
+void BaselineAssembler::getter0Inline(const Lookup *l, std::function<void()> genericLookup)
+{
+    auto slowPath = pasm()->getter0InlineFastPath(l);
+    auto done = pasm()->jump();
+
+    // slow path:
+    slowPath.link(pasm());
+    genericLookup();
+
+    // done.
+    done.link(pasm());
+}
+
 void BaselineAssembler::toNumber()
 {
     pasm()->toNumber();
@@ -1004,6 +1111,10 @@ void BaselineAssembler::add(int lhs)
                                   PlatformAssembler::ScratchRegister);
         return overflowed;
     });
+    auto doubleDone = pasm()->binopBothNumberPath(regAddr(lhs), [this](){
+        pasm()->addDouble(PlatformAssembler::FPScratchRegister2,
+                          PlatformAssembler::FPScratchRegister);
+    });
 
     // slow path:
     saveAccumulatorInFrame();
@@ -1016,6 +1127,7 @@ void BaselineAssembler::add(int lhs)
 
     // done.
     done.link(pasm());
+    doubleDone.link(pasm());
 }
 
 void BaselineAssembler::bitAnd(int lhs)
@@ -1157,6 +1269,10 @@ void BaselineAssembler::mul(int lhs)
                                   PlatformAssembler::ScratchRegister);
         return overflowed;
     });
+    auto doubleDone = pasm()->binopBothNumberPath(regAddr(lhs), [this](){
+        pasm()->mulDouble(PlatformAssembler::FPScratchRegister2,
+                          PlatformAssembler::FPScratchRegister);
+    });
 
     // slow path:
     saveAccumulatorInFrame();
@@ -1168,6 +1284,7 @@ void BaselineAssembler::mul(int lhs)
 
     // done.
     done.link(pasm());
+    doubleDone.link(pasm());
 }
 
 void BaselineAssembler::div(int lhs)
@@ -1200,6 +1317,10 @@ void BaselineAssembler::sub(int lhs)
                                   PlatformAssembler::ScratchRegister);
         return overflowed;
     });
+    auto doubleDone = pasm()->binopBothNumberPath(regAddr(lhs), [this](){
+        pasm()->subDouble(PlatformAssembler::FPScratchRegister2,
+                          PlatformAssembler::FPScratchRegister);
+    });
 
     // slow path:
     saveAccumulatorInFrame();
@@ -1211,6 +1332,7 @@ void BaselineAssembler::sub(int lhs)
 
     // done.
     done.link(pasm());
+    doubleDone.link(pasm());
 }
 
 void BaselineAssembler::cmpeqNull()
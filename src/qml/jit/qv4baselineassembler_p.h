@@ -19,6 +19,8 @@
 #include <private/qv4function_p.h>
 #include <QHash>
 
+#include <functional>
+
 #if QT_CONFIG(qml_jit)
 
 QT_BEGIN_NAMESPACE
@@ -40,7 +42,7 @@ public:
     // codegen infrastructure
     void generatePrologue();
     void generateEpilogue();
-    void link(Function *function);
+    Function::JitResult link(Function *function);
     void addLabel(int offset);
 
     // loads/stores/moves
@@ -56,6 +58,9 @@ public:
     void storeHeapObject(int reg);
     void loadImport(int index);
 
+    // inline caches
+    void getter0Inline(const Lookup *l, std::function<void()> genericLookup);
+
     // numeric ops
     void unot();
     void toNumber();
@@ -5,6 +5,7 @@
 #include "qv4baselineassembler_p.h"
 #include <private/qv4lookup_p.h>
 #include <private/qv4generatorobject_p.h>
+#include <private/qv4mm_p.h>
 
 #if QT_CONFIG(qml_jit)
 
@@ -22,6 +23,11 @@ BaselineJIT::~BaselineJIT()
 {}
 
 void BaselineJIT::generate()
+{
+    function->installJittedCode(compile());
+}
+
+Function::JitResult BaselineJIT::compile()
 {
 //    qDebug()<<"jitting" << function->name()->toQString();
     const char *code = function->codeData;
@@ -36,8 +42,7 @@ void BaselineJIT::generate()
     decode(code, len);
     as->generateEpilogue();
 
-    as->link(function);
-//    qDebug()<<"done";
+    return as->link(function);
 }
 
 #define STORE_IP() as->storeInstructionPointer(nextInstructionOffset())
@@ -123,10 +128,42 @@ void BaselineJIT::generate_LoadLocal(int index)
     as->loadLocal(index);
 }
 
+// Stores emitted by storeLocal() bypass the write barrier. This is used instead while the
+// incremental or the generational GC is enabled.
+static void storeLocalWithWriteBarrier(ExecutionEngine *engine, const Value &context, int scope,
+                                       int index, const Value &value)
+{
+    Heap::ExecutionContext *ctx = static_cast<Heap::ExecutionContext *>(context.heapObject());
+    while (scope--)
+        ctx = ctx->outer;
+    Q_ASSERT(ctx->type != Heap::ExecutionContext::Type_GlobalContext);
+    static_cast<Heap::CallContext *>(ctx)->locals.set(engine, index, value);
+}
+
+void BaselineJIT::storeLocal(int scope, int index)
+{
+    const MemoryManager *mm = function->compilationUnit->engine->memoryManager;
+    if (!mm->incrementalGC && !mm->generationalGC) {
+        as->storeLocal(index, scope);
+        return;
+    }
+
+    STORE_ACC();
+    as->prepareCallWithArgCount(5);
+    as->passAccumulatorAsArg(4);
+    as->passInt32AsArg(index, 3);
+    as->passInt32AsArg(scope, 2);
+    as->passJSSlotAsArg(CallData::Context, 1);
+    as->passEngineAsArg(0);
+    as->callRuntime(reinterpret_cast<void *>(&storeLocalWithWriteBarrier),
+                    CallResultDestination::Ignore);
+    LOAD_ACC();
+}
+
 void BaselineJIT::generate_StoreLocal(int index)
 {
     as->checkException();
-    as->storeLocal(index);
+    storeLocal(0, index);
 }
 
 void BaselineJIT::generate_LoadScopedLocal(int scope, int index)
@@ -137,7 +174,7 @@ void BaselineJIT::generate_LoadScopedLocal(int scope, int index)
 void BaselineJIT::generate_StoreScopedLocal(int scope, int index)
 {
     as->checkException();
-    as->storeLocal(index, scope);
+    storeLocal(scope, index);
 }
 
 void BaselineJIT::generate_LoadRuntimeString(int stringId)
@@ -256,14 +293,23 @@ void BaselineJIT::generate_LoadOptionalProperty(int name, int offset)
 
 void BaselineJIT::generate_GetLookup(int index)
 {
-    STORE_IP();
-    STORE_ACC();
-    as->prepareCallWithArgCount(4);
-    as->passInt32AsArg(index, 3);
-    as->passAccumulatorAsArg(2);
-    as->passFunctionAsArg(1);
-    as->passEngineAsArg(0);
-    BASELINEJIT_GENERATE_RUNTIME_CALL(GetLookup, CallResultDestination::InAccumulator);
+    const auto genericLookup = [this, index]() {
+        STORE_IP();
+        STORE_ACC();
+        as->prepareCallWithArgCount(4);
+        as->passInt32AsArg(index, 3);
+        as->passAccumulatorAsArg(2);
+        as->passFunctionAsArg(1);
+        as->passEngineAsArg(0);
+        BASELINEJIT_GENERATE_RUNTIME_CALL(GetLookup, CallResultDestination::InAccumulator);
+    };
+
+    // Load an inline property of a single internal class directly. The lookup may be modified by
+    // the interpreter while the function is compiled in the background, so its state is not
+    // looked at here. The fast path checks it and the internal class at run time, and falls back
+    // to the generic lookup if the lookup has not settled on getter0Inline.
+    const Lookup *l = function->executableCompilationUnit()->runtimeLookups + index;
+    as->getter0Inline(l, genericLookup);
 }
 
 void BaselineJIT::generate_GetOptionalLookup(int index, int offset)
@@ -38,6 +38,10 @@ public:
 
     void generate();
 
+    // Generates the code without installing it into the function. This is safe to call from a
+    // worker thread, as long as the function's compilation unit stays alive.
+    Function::JitResult compile();
+
     void generate_Ret() override;
     void generate_Debug() override;
     void generate_LoadConst(int index) override;
@@ -178,6 +182,8 @@ public:
     void endInstruction(Moth::Instr::Type instr) override;
 
 private:
+    void storeLocal(int scope, int index);
+
     QV4::Function *function;
     QScopedPointer<BaselineAssembler> as;
     QSet<int> labels;
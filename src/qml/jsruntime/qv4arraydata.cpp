@@ -300,13 +300,13 @@ bool SimpleArrayData::putArray(Object *o, uint index, const Value *values, uint
 void SparseArrayData::free(Heap::ArrayData *d, uint idx)
 {
     Q_ASSERT(d && d->type == Heap::ArrayData::Sparse);
-    Value *v = d->values.values + idx;
+    QV4::ExecutionEngine *e = d->internalClass->engine;
     if (d->attrs && d->attrs[idx].isAccessor()) {
         // double slot, free both. Order is important, so we have a double slot for allocation again afterwards.
-        v[1] = d->sparse->freeList;
-        v[0] = Encode(idx + 1);
+        d->values.set(e, idx + 1, d->sparse->freeList);
+        d->values.set(e, idx, Value::fromInt32(idx + 1));
     } else {
-        *v = d->sparse->freeList;
+        d->values.set(e, idx, d->sparse->freeList);
     }
     d->sparse->freeList = Encode(idx);
     if (d->attrs)
@@ -405,13 +405,14 @@ bool SparseArrayData::del(Object *o, uint index)
         dd->attrs[pidx] = Attr_Data;
     }
 
+    QV4::ExecutionEngine *e = o->engine();
     if (isAccessor) {
         // free up both indices
-        dd->values.values[pidx + 1] = dd->sparse->freeList;
-        dd->values.values[pidx] = Encode(pidx + 1);
+        dd->values.set(e, pidx + 1, dd->sparse->freeList);
+        dd->values.set(e, pidx, Value::fromInt32(pidx + 1));
     } else {
         Q_ASSERT(dd->type == Heap::ArrayData::Sparse);
-        dd->values.values[pidx] = dd->sparse->freeList;
+        dd->values.set(e, pidx, dd->sparse->freeList);
     }
 
     dd->sparse->freeList = Encode(pidx);
@@ -86,6 +86,17 @@
 
 #include <private/qqmlengine_p.h>
 
+#if QT_CONFIG(qml_jit)
+#include <private/qv4baselinejit_p.h>
+#endif
+
+#if QT_CONFIG(thread)
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qthreadpool.h>
+#endif
+
+#include <qtqml_tracepoints_p.h>
+
 #if USE(PTHREADS)
 #  include <pthread.h>
 #if !defined(Q_OS_INTEGRITY)
@@ -118,6 +129,7 @@ using namespace QV4;
 static QBasicAtomicInt engineSerial = Q_BASIC_ATOMIC_INITIALIZER(1);
 int ExecutionEngine::s_maxCallDepth = -1;
 int ExecutionEngine::s_jitCallCountThreshold = 3;
+bool ExecutionEngine::s_jitAsync = false;
 int ExecutionEngine::s_maxJSStackSize = 4 * 1024 * 1024;
 int ExecutionEngine::s_maxGCStackSize = 2 * 1024 * 1024;
 
@@ -349,6 +361,7 @@ void ExecutionEngine::initializeStaticMembers()
         s_jitCallCountThreshold = 3;
     if (qEnvironmentVariableIsSet("QV4_FORCE_INTERPRETER"))
         s_jitCallCountThreshold = std::numeric_limits<int>::max();
+    s_jitAsync = qEnvironmentVariableIsSet("QV4_JIT_ASYNC");
 
     qMetaTypeId<QJSValue>();
     qMetaTypeId<QList<int> >();
@@ -874,6 +887,11 @@ ExecutionEngine::ExecutionEngine(QJSEngine *jsEngine)
 
 ExecutionEngine::~ExecutionEngine()
 {
+#if QT_CONFIG(qml_jit)
+    waitForQueuedJIT();
+    delete m_jitThreadPool;
+#endif
+
     modules.clear();
     for (auto val : nativeModules) {
         PersistentValueStorage::free(val);
@@ -1991,6 +2009,52 @@ QV4::ReturnedValue ExecutionEngine::metaTypeToJS(QMetaType type, const void *dat
     return fromData(type, data);
 }
 
+#if QT_CONFIG(qml_jit)
+/*!
+  \internal
+
+  Compiles \a function on a worker thread. The interpreter keeps running the function until
+  the result has been published, and the function installs it on its next call.
+ */
+void ExecutionEngine::queueJIT(Function *function)
+{
+#if QT_CONFIG(thread)
+    Q_ASSERT(!function->jitQueued);
+    function->jitQueued = true;
+
+    if (!m_jitThreadPool) {
+        m_jitThreadPool = new QThreadPool;
+        m_jitThreadPool->setMaxThreadCount(1);
+    }
+
+    QElapsedTimer queued;
+    queued.start();
+    const QString name = function->name()->toQString();
+    m_jitThreadPool->start([function, queued, name]() {
+        Q_TRACE_SCOPE(QQmlV4_jit_compile, name, queued.nsecsElapsed());
+        function->pendingJit.storeRelease(
+                    new Function::JitResult(JIT::BaselineJIT(function).compile()));
+    });
+#else
+    JIT::BaselineJIT(function).generate();
+#endif
+}
+
+/*!
+  \internal
+
+  Blocks until all functions queued with queueJIT() have been compiled. This needs to happen
+  before any compilation unit with queued functions is unlinked.
+ */
+void ExecutionEngine::waitForQueuedJIT()
+{
+#if QT_CONFIG(thread)
+    if (m_jitThreadPool)
+        m_jitThreadPool->waitForDone();
+#endif
+}
+#endif // QT_CONFIG(qml_jit)
+
 int ExecutionEngine::maxJSStackSize() const
 {
     return s_maxJSStackSize;
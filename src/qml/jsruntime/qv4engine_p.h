@@ -55,6 +55,8 @@ class PageAllocation;
 
 QT_BEGIN_NAMESPACE
 
+class QThreadPool;
+
 #if QT_CONFIG(qml_network)
 class QNetworkAccessManager;
 
@@ -498,6 +500,7 @@ public:
     MultiplyWrappedQObjectMap *m_multiplyWrappedQObjects;
 #if QT_CONFIG(qml_jit)
     const bool m_canAllocateExecutableMemory;
+    QThreadPool *m_jitThreadPool = nullptr;
 #endif
 
     quintptr protoIdCount = 1;
@@ -659,7 +662,7 @@ public:
         if (f) {
             return f->kind != Function::AotCompiled
                     && !f->isGenerator()
-                    && f->interpreterCallCount >= s_jitCallCountThreshold;
+                    && (f->wasHotBefore || f->interpreterCallCount >= s_jitCallCountThreshold);
         }
         return true;
 #else
@@ -668,6 +671,20 @@ public:
 #endif
     }
 
+#if QT_CONFIG(qml_jit)
+    bool canJITInBackground() const
+    {
+#if QT_CONFIG(thread)
+        return s_jitAsync;
+#else
+        return false;
+#endif
+    }
+
+    void queueJIT(Function *function);
+    void waitForQueuedJIT();
+#endif
+
     QV4::ReturnedValue global();
     void initQmlGlobalObject();
     void initializeGlobal();
@@ -742,6 +759,7 @@ private:
 
     static int s_maxCallDepth;
     static int s_jitCallCountThreshold;
+    static bool s_jitAsync;
     static int s_maxJSStackSize;
     static int s_maxGCStackSize;
 
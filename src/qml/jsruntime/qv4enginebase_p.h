@@ -45,7 +45,8 @@ struct Q_QML_EXPORT EngineBase {
 
     quint8 isExecutingInRegExpJIT = false;
     quint8 isInitialized = false;
-    quint8 padding[2];
+    quint8 isWriteBarrierActive = false; // set during incremental marking and for the generational GC
+    quint8 padding[1];
     MemoryManager *memoryManager = nullptr;
 
     qint32 callDepth = 0;
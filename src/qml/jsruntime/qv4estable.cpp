@@ -4,6 +4,8 @@
 #include "qv4estable_p.h"
 #include "qv4object_p.h"
 
+#include <private/qv4writebarrier_p.h>
+
 using namespace QV4;
 
 // The ES spec requires that Map/Set be implemented using a data structure that
@@ -49,12 +51,14 @@ void ESTable::clear()
 }
 
 // Update the table to contain \a value for a given \a key. The key is
-// normalized, as required by the ES spec.
-void ESTable::set(const Value &key, const Value &value)
+// normalized, as required by the ES spec. The table lives in unmanaged memory,
+// so \a owner is flagged for the write barrier instead of the slots themselves.
+void ESTable::set(EngineBase *engine, Heap::Base *owner, const Value &key, const Value &value)
 {
     for (uint i = 0; i < m_size; ++i) {
         if (m_keys[i].sameValueZero(key)) {
             m_values[i] = value;
+            WriteBarrier::markWritten(engine, owner);
             return;
         }
     }
@@ -78,6 +82,7 @@ void ESTable::set(const Value &key, const Value &value)
     m_values[m_size] = value;
 
     m_size++;
+    WriteBarrier::markWritten(engine, owner);
 }
 
 // Returns true if the table contains \a key, false otherwise.
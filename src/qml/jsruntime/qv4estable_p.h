@@ -30,7 +30,7 @@ public:
 
     void markObjects(MarkStack *s, bool isWeakMap);
     void clear();
-    void set(const Value &k, const Value &v);
+    void set(EngineBase *engine, Heap::Base *owner, const Value &k, const Value &v);
     bool has(const Value &k) const;
     ReturnedValue get(const Value &k, bool *hasValue = nullptr) const;
     bool remove(const Value &k);
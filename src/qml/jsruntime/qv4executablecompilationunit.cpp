@@ -27,6 +27,8 @@
 #include <QtQml/qqmlpropertymap.h>
 
 #include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
 #include <QtCore/qstandardpaths.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qscopeguard.h>
@@ -200,6 +202,19 @@ QV4::Function *ExecutableCompilationUnit::linkToEngine(ExecutionEngine *engine)
                                                     advanceAotFunction(i));
     }
 
+#if QT_CONFIG(qml_jit)
+    // Functions that were hot last time don't need to warm up in the interpreter again. With
+    // QV4_JIT_ASYNC, start compiling them right away, so that the code is ready when needed.
+    for (quint32 index : qAsConst(jitProfile)) {
+        if (index >= quint32(runtimeFunctions.size()))
+            continue;
+        QV4::Function *f = runtimeFunctions[index];
+        f->wasHotBefore = true;
+        if (engine->canJITInBackground() && engine->canJIT(f))
+            engine->queueJIT(f);
+    }
+#endif
+
     Scope scope(engine);
     Scoped<InternalClass> ic(scope);
 
@@ -270,8 +285,24 @@ Heap::Object *ExecutableCompilationUnit::templateObjectAt(int index) const
 
 void ExecutableCompilationUnit::unlink()
 {
-    if (engine)
+#if QT_CONFIG(qml_jit)
+    if (engine) {
+        // Don't pull the functions and lookups away from under a background JIT job.
+        for (QV4::Function *f : qAsConst(runtimeFunctions)) {
+            if (f->jitQueued && !f->codeRef && !f->pendingJit.loadAcquire()) {
+                engine->waitForQueuedJIT();
+                break;
+            }
+        }
+    }
+#endif
+
+    if (engine) {
+#if QT_CONFIG(qml_jit)
+        saveJitProfile();
+#endif
         nextCompilationUnit.remove();
+    }
 
     if (isRegistered) {
         Q_ASSERT(data && propertyCaches.count() > 0 && propertyCaches.at(/*root object*/0));
@@ -852,6 +883,9 @@ bool ExecutableCompilationUnit::loadFromDisk(const QUrl &url, const QDateTime &s
         dataPtrRevert.dismiss();
         free(const_cast<CompiledData::Unit*>(oldDataPtr));
         backingFile = std::move(cacheFile);
+#if QT_CONFIG(qml_jit)
+        loadJitProfile(localCacheFilePath(url));
+#endif
         return true;
     }
 
@@ -877,6 +911,94 @@ bool ExecutableCompilationUnit::saveToDisk(const QUrl &unitUrl, QString *errorSt
     });
 }
 
+namespace {
+struct JitProfileHeader
+{
+    enum : quint32 { Magic = 0x4a345651 /* QV4J */, Version = 1 };
+    quint32 magic;
+    quint32 version;
+    qint64 sourceTimeStamp;
+    char md5Checksum[16];
+    quint32 functionTableSize;
+    quint32 functionCount; // followed by this many function indices
+};
+}
+
+static QString jitProfileFilePath(const QString &cacheFilePath)
+{
+    return cacheFilePath + QLatin1String(".jit");
+}
+
+/*!
+    \internal
+    Reads the indices of the functions that were JIT-compiled the last time this unit was used.
+    The profile is only used if it was written for the same compilation unit data.
+ */
+void ExecutableCompilationUnit::loadJitProfile(const QString &cacheFilePath)
+{
+    jitProfilePath = jitProfileFilePath(cacheFilePath);
+    jitProfile.clear();
+
+    QFile file(jitProfilePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    JitProfileHeader header;
+    if (file.read(reinterpret_cast<char *>(&header), sizeof(header)) != sizeof(header)
+            || header.magic != JitProfileHeader::Magic
+            || header.version != JitProfileHeader::Version
+            || header.sourceTimeStamp != data->sourceTimeStamp
+            || memcmp(header.md5Checksum, data->md5Checksum, sizeof(header.md5Checksum)) != 0
+            || header.functionTableSize != data->functionTableSize
+            || header.functionCount > data->functionTableSize) {
+        return;
+    }
+
+    jitProfile.resize(header.functionCount);
+    const qint64 size = qint64(header.functionCount) * sizeof(quint32);
+    if (file.read(reinterpret_cast<char *>(jitProfile.data()), size) != size)
+        jitProfile.clear();
+}
+
+/*!
+    \internal
+    Records which functions have been JIT-compiled, so that the next process using this unit can
+    compile them right away. Nothing is written if the profile hasn't changed.
+ */
+void ExecutableCompilationUnit::saveJitProfile() const
+{
+    if (jitProfilePath.isEmpty() || !data)
+        return;
+
+    QList<quint32> hot;
+    for (int i = 0; i < runtimeFunctions.size(); ++i) {
+        const QV4::Function *f = runtimeFunctions[i];
+        if (f->codeRef || f->pendingJit.loadRelaxed() || f->wasHotBefore)
+            hot.append(quint32(i));
+    }
+
+    if (hot == jitProfile)
+        return;
+
+#if QT_CONFIG(temporaryfile)
+    // Like the disk cache, never leave a partially written profile behind.
+    QSaveFile file(jitProfilePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return;
+
+    JitProfileHeader header;
+    header.magic = JitProfileHeader::Magic;
+    header.version = JitProfileHeader::Version;
+    header.sourceTimeStamp = data->sourceTimeStamp;
+    memcpy(header.md5Checksum, data->md5Checksum, sizeof(header.md5Checksum));
+    header.functionTableSize = data->functionTableSize;
+    header.functionCount = quint32(hot.size());
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(hot.constData()), hot.size() * sizeof(quint32));
+    file.commit();
+#endif
+}
+
 /*!
     \internal
     This function creates a temporary key vector and sorts it to guarantuee a stable
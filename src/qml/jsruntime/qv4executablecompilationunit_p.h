@@ -122,6 +122,12 @@ public:
     // lookups by string (property name).
     QVector<BindingPropertyData> bindingPropertyDataPerObject;
 
+    // index is object index, then binding index. Holds the values of literal
+    // bindings that need parsing or resolving (urls, colors, points, ...),
+    // converted when the object is first created and written as they are
+    // for all further instances.
+    QVector<QVector<QVariant>> convertedLiteralsPerObject;
+
     // mapping from component object index (CompiledData::Unit object index that points to component) to identifier hash of named objects
     // this is initialized on-demand by QQmlContextData
     QHash<int, IdentifierHash> namedObjectsPerComponentCache;
@@ -153,6 +159,11 @@ public:
 
     std::unique_ptr<CompilationUnitMapper> backingFile;
 
+    // Functions that were hot enough to be JIT-compiled when this unit was last used. Stored in
+    // a small file next to the disk cache file, see loadJitProfile() and saveJitProfile().
+    QString jitProfilePath;
+    QList<quint32> jitProfile;
+
     // --- interface for QQmlPropertyCacheCreator
     using CompiledObject = CompiledData::Object;
     using CompiledFunction = CompiledData::Function;
@@ -250,6 +261,9 @@ public:
     static QString localCacheFilePath(const QUrl &url);
     bool saveToDisk(const QUrl &unitUrl, QString *errorString);
 
+    void loadJitProfile(const QString &cacheFilePath);
+    void saveJitProfile() const;
+
     QString bindingValueAsString(const CompiledData::Binding *binding) const;
 
     struct TranslationDataIndex
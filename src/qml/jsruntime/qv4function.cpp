@@ -74,6 +74,23 @@ void Function::destroy()
     delete this;
 }
 
+void Function::installJittedCode(const JitResult &result)
+{
+    Q_ASSERT(!codeRef);
+    codeRef = result.codeRef;
+    jittedCode = result.jittedCode;
+}
+
+bool Function::installPendingJittedCode()
+{
+    JitResult *result = pendingJit.fetchAndStoreAcquire(nullptr);
+    if (!result)
+        return false;
+    installJittedCode(*result);
+    delete result;
+    return true;
+}
+
 Function::Function(ExecutionEngine *engine, ExecutableCompilationUnit *unit,
                    const CompiledData::Function *function,
                    const QQmlPrivate::TypedFunction *aotFunction)
@@ -103,6 +120,8 @@ Function::Function(ExecutionEngine *engine, ExecutableCompilationUnit *unit,
 
 Function::~Function()
 {
+    if (!codeRef)
+        installPendingJittedCode();
     if (codeRef) {
         destroyFunctionTable(this, codeRef);
         delete codeRef;
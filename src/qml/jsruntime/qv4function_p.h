@@ -20,6 +20,8 @@
 #include <private/qv4context_p.h>
 #include <private/qv4string_p.h>
 
+#include <QtCore/qatomic.h>
+
 namespace JSC {
 class MacroAssemblerCodeRef;
 }
@@ -76,9 +78,20 @@ public:
     JSC::MacroAssemblerCodeRef *codeRef;
     const QQmlPrivate::TypedFunction *typedFunction = nullptr;
 
+    struct JitResult {
+        JittedCode jittedCode = nullptr;
+        JSC::MacroAssemblerCodeRef *codeRef = nullptr;
+    };
+
+    // With QV4_JIT_ASYNC the JIT runs on a worker thread and publishes its result here. The
+    // engine thread moves it to jittedCode and codeRef on the next call, see installJittedCode().
+    QAtomicPointer<JitResult> pendingJit;
+    bool jitQueued = false;
+
     // first nArguments names in internalClass are the actual arguments
     Heap::InternalClass *internalClass;
     int interpreterCallCount = 0;
+    bool wasHotBefore = false; // according to the compilation unit's JIT profile
     quint16 nFormals;
     enum Kind : quint8 { JsUntyped, JsTyped, AotCompiled, Eval };
     Kind kind = JsUntyped;
@@ -89,6 +102,9 @@ public:
                             const QQmlPrivate::TypedFunction *aotFunction);
     void destroy();
 
+    void installJittedCode(const JitResult &result);
+    bool installPendingJittedCode();
+
     // used when dynamically assigning signal handlers (QQmlConnection)
     void updateInternalClass(ExecutionEngine *engine, const QList<QByteArray> &parameters);
 
@@ -105,6 +121,7 @@ public:
     inline bool isArrowFunction() const { return compiledFunction->flags & CompiledData::Function::IsArrowFunction; }
     inline bool isGenerator() const { return compiledFunction->flags & CompiledData::Function::IsGenerator; }
     inline bool isClosureWrapper() const { return compiledFunction->flags & CompiledData::Function::IsClosureWrapper; }
+    inline bool hasStaticDependencies() const { return compiledFunction->flags & CompiledData::Function::HasStaticDependencies; }
 
     QQmlSourceLocation sourceLocation() const;
 
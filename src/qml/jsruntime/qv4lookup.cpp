@@ -140,6 +140,73 @@ static inline void setupProtoLookupTwoClasses(Lookup *l, const Lookup &first, co
     l->protoLookupTwoClasses.data2 = data2;
 }
 
+static ReturnedValue polymorphicGetterMiss(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    PolymorphicLookupTable *table = l->polymorphicLookup.table;
+    ++table->misses;
+
+    if (const Object *o = object.as<Object>()) {
+        if (!table->isFull()) {
+            // Do the resolution on a second lookup, then add it to the table.
+            Lookup second;
+            memset(&second, 0, sizeof(Lookup));
+            second.nameIndex = l->nameIndex;
+            second.forCall = l->forCall;
+            second.getter = Lookup::getterGeneric;
+            const ReturnedValue result = second.resolveGetter(engine, o);
+
+            if (second.getter == Lookup::getter0Inline) {
+                table->append(PolymorphicLookupTable::InlineProperty, second.objectLookup.ic,
+                              second.objectLookup.offset);
+                return result;
+            }
+
+            if (second.getter == Lookup::getter0MemberData) {
+                table->append(PolymorphicLookupTable::MemberDataProperty, second.objectLookup.ic,
+                              second.objectLookup.offset);
+                return result;
+            }
+
+            if (second.getter == Lookup::getterProto) {
+                table->appendProto(second.protoLookup.protoId, second.protoLookup.data);
+                return result;
+            }
+
+            // Something we cannot cache. The property has been read already, possibly through
+            // an accessor or a proxy trap, so don't read it again. This also deletes the table.
+            second.releasePropertyCache();
+            l->releasePropertyCache();
+            l->getter = Lookup::getterFallback;
+            return result;
+        }
+    }
+
+    // Megamorphic. This also deletes the table.
+    l->releasePropertyCache();
+    l->getter = Lookup::getterFallback;
+    return Lookup::getterFallback(l, engine, object);
+}
+
+static ReturnedValue switchToPolymorphicGetter(
+        Lookup *l, ExecutionEngine *engine, const Value &object,
+        PolymorphicLookupTable::EntryType type1, PolymorphicLookupTable::EntryType type2)
+{
+    PolymorphicLookupTable *table = new PolymorphicLookupTable;
+    if (type1 == PolymorphicLookupTable::ProtoProperty) {
+        Q_ASSERT(type2 == PolymorphicLookupTable::ProtoProperty);
+        table->appendProto(l->protoLookupTwoClasses.protoId, l->protoLookupTwoClasses.data);
+        table->appendProto(l->protoLookupTwoClasses.protoId2, l->protoLookupTwoClasses.data2);
+    } else {
+        table->append(type1, l->objectLookupTwoClasses.ic, l->objectLookupTwoClasses.offset);
+        table->append(type2, l->objectLookupTwoClasses.ic2, l->objectLookupTwoClasses.offset2);
+    }
+
+    l->clear();
+    l->polymorphicLookup.table = table;
+    l->getter = Lookup::getterPolymorphic;
+    return polymorphicGetterMiss(l, engine, object);
+}
+
 ReturnedValue Lookup::getterTwoClasses(Lookup *l, ExecutionEngine *engine, const Value &object)
 {
     if (const Object *o = object.as<Object>()) {
@@ -250,6 +317,8 @@ ReturnedValue Lookup::getter0Inlinegetter0Inline(Lookup *l, ExecutionEngine *eng
             return o->inlinePropertyDataWithOffset(l->objectLookupTwoClasses.offset)->asReturnedValue();
         if (l->objectLookupTwoClasses.ic2 == o->internalClass)
             return o->inlinePropertyDataWithOffset(l->objectLookupTwoClasses.offset2)->asReturnedValue();
+        return switchToPolymorphicGetter(l, engine, object, PolymorphicLookupTable::InlineProperty,
+                                         PolymorphicLookupTable::InlineProperty);
     }
     l->getter = getterFallback;
     return getterFallback(l, engine, object);
@@ -265,6 +334,8 @@ ReturnedValue Lookup::getter0Inlinegetter0MemberData(Lookup *l, ExecutionEngine
             return o->inlinePropertyDataWithOffset(l->objectLookupTwoClasses.offset)->asReturnedValue();
         if (l->objectLookupTwoClasses.ic2 == o->internalClass)
             return o->memberData->values.data()[l->objectLookupTwoClasses.offset2].asReturnedValue();
+        return switchToPolymorphicGetter(l, engine, object, PolymorphicLookupTable::InlineProperty,
+                                         PolymorphicLookupTable::MemberDataProperty);
     }
     l->getter = getterFallback;
     return getterFallback(l, engine, object);
@@ -280,6 +351,8 @@ ReturnedValue Lookup::getter0MemberDatagetter0MemberData(Lookup *l, ExecutionEng
             return o->memberData->values.data()[l->objectLookupTwoClasses.offset].asReturnedValue();
         if (l->objectLookupTwoClasses.ic2 == o->internalClass)
             return o->memberData->values.data()[l->objectLookupTwoClasses.offset2].asReturnedValue();
+        return switchToPolymorphicGetter(l, engine, object, PolymorphicLookupTable::MemberDataProperty,
+                                         PolymorphicLookupTable::MemberDataProperty);
     }
     l->getter = getterFallback;
     return getterFallback(l, engine, object);
@@ -298,12 +371,50 @@ ReturnedValue Lookup::getterProtoTwoClasses(Lookup *l, ExecutionEngine *engine,
             return l->protoLookupTwoClasses.data->asReturnedValue();
         if (l->protoLookupTwoClasses.protoId2 == o->internalClass->protoId)
             return l->protoLookupTwoClasses.data2->asReturnedValue();
-        return getterFallback(l, engine, object);
+        return switchToPolymorphicGetter(l, engine, object, PolymorphicLookupTable::ProtoProperty,
+                                         PolymorphicLookupTable::ProtoProperty);
     }
     l->getter = getterFallback;
     return getterFallback(l, engine, object);
 }
 
+ReturnedValue Lookup::getterPolymorphic(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    // we can safely cast to a QV4::Object here. If object is actually a string,
+    // the internal class won't match
+    Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
+    if (o) {
+        PolymorphicLookupTable *table = l->polymorphicLookup.table;
+        for (uint i = 0; i < table->size; ++i) {
+            const PolymorphicLookupTable::Entry &e = table->entries[i];
+            switch (e.type) {
+            case PolymorphicLookupTable::InlineProperty:
+                if (e.ic == o->internalClass) {
+                    ++table->hits;
+                    return o->inlinePropertyDataWithOffset(e.offset)->asReturnedValue();
+                }
+                break;
+            case PolymorphicLookupTable::MemberDataProperty:
+                if (e.ic == o->internalClass) {
+                    ++table->hits;
+                    return o->memberData->values.data()[e.offset].asReturnedValue();
+                }
+                break;
+            case PolymorphicLookupTable::ProtoProperty:
+                if (e.protoId == o->internalClass->protoId) {
+                    ++table->hits;
+                    return e.data->asReturnedValue();
+                }
+                break;
+            case PolymorphicLookupTable::OwnProperty:
+                Q_UNREACHABLE();
+                break;
+            }
+        }
+    }
+    return polymorphicGetterMiss(l, engine, object);
+}
+
 ReturnedValue Lookup::getterAccessor(Lookup *l, ExecutionEngine *engine, const Value &object)
 {
     // we can safely cast to a QV4::Object here. If object is actually a string,
@@ -516,6 +627,40 @@ bool Lookup::setterGeneric(Lookup *l, ExecutionEngine *engine, Value &object, co
     return o->put(name, value);
 }
 
+static bool polymorphicSetterMiss(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
+{
+    PolymorphicLookupTable *table = l->polymorphicLookup.table;
+    ++table->misses;
+
+    if (object.isObject() && !table->isFull()) {
+        // Do the resolution on a second lookup, then add it to the table.
+        Lookup second;
+        memset(&second, 0, sizeof(Lookup));
+        second.nameIndex = l->nameIndex;
+        second.setter = Lookup::setterGeneric;
+        const bool result = second.resolveSetter(engine, static_cast<Object *>(&object), value);
+
+        if (result && (second.setter == Lookup::setter0MemberData
+                       || second.setter == Lookup::setter0Inline)) {
+            table->append(PolymorphicLookupTable::OwnProperty, second.objectLookup.ic,
+                          second.objectLookup.index);
+            return true;
+        }
+
+        // The value has been stored (or the store has failed) already, but we cannot cache
+        // this kind of property. Stop caching altogether.
+        second.releasePropertyCache();
+        l->releasePropertyCache();
+        l->setter = Lookup::setterFallback;
+        return result;
+    }
+
+    // Megamorphic. This also deletes the table.
+    l->releasePropertyCache();
+    l->setter = Lookup::setterFallback;
+    return Lookup::setterFallback(l, engine, object, value);
+}
+
 bool Lookup::setterTwoClasses(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
 {
     // A precondition of this method is that l->objectLookup is the active variant of the union.
@@ -533,10 +678,12 @@ bool Lookup::setterTwoClasses(Lookup *l, ExecutionEngine *engine, Value &object,
         }
 
         if (l->setter == Lookup::setter0MemberData || l->setter == Lookup::setter0Inline) {
+            Heap::InternalClass *ic2 = l->objectLookup.ic;
+            const uint index2 = l->objectLookup.index;
             l->objectLookupTwoClasses.ic = ic;
-            l->objectLookupTwoClasses.ic2 = ic;
+            l->objectLookupTwoClasses.ic2 = ic2;
             l->objectLookupTwoClasses.offset = index;
-            l->objectLookupTwoClasses.offset2 = index;
+            l->objectLookupTwoClasses.offset2 = index2;
             l->setter = setter0setter0;
             return true;
         }
@@ -593,12 +740,41 @@ bool Lookup::setter0setter0(Lookup *l, ExecutionEngine *engine, Value &object, c
             o->setProperty(engine, l->objectLookupTwoClasses.offset2, value);
             return true;
         }
+
+        PolymorphicLookupTable *table = new PolymorphicLookupTable;
+        table->append(PolymorphicLookupTable::OwnProperty, l->objectLookupTwoClasses.ic,
+                      l->objectLookupTwoClasses.offset);
+        table->append(PolymorphicLookupTable::OwnProperty, l->objectLookupTwoClasses.ic2,
+                      l->objectLookupTwoClasses.offset2);
+        l->clear();
+        l->polymorphicLookup.table = table;
+        l->setter = setterPolymorphic;
+        return polymorphicSetterMiss(l, engine, object, value);
     }
 
     l->setter = setterFallback;
     return setterFallback(l, engine, object, value);
 }
 
+bool Lookup::setterPolymorphic(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
+{
+    Heap::Object *o = static_cast<Heap::Object *>(object.heapObject());
+    if (o) {
+        PolymorphicLookupTable *table = l->polymorphicLookup.table;
+        for (uint i = 0; i < table->size; ++i) {
+            const PolymorphicLookupTable::Entry &e = table->entries[i];
+            Q_ASSERT(e.type == PolymorphicLookupTable::OwnProperty);
+            if (o->internalClass == e.ic) {
+                ++table->hits;
+                o->setProperty(engine, e.offset, value);
+                return true;
+            }
+        }
+    }
+
+    return polymorphicSetterMiss(l, engine, object, value);
+}
+
 bool Lookup::setterInsert(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value)
 {
     // Otherwise we cannot trust the protoIds
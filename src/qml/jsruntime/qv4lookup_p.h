@@ -28,6 +28,67 @@ namespace Heap {
     struct QObjectMethod;
 }
 
+// Out-of-line cache for lookups that have seen more than two internal classes. Once it is full,
+// further misses make the lookup megamorphic and it goes through getterFallback/setterFallback.
+struct PolymorphicLookupTable
+{
+    enum { MaxEntries = 8 };
+
+    enum EntryType : quint8 {
+        InlineProperty,     // getter, offset is the inline property index including the offset
+        MemberDataProperty, // getter, offset is the index into the member data
+        ProtoProperty,      // getter, data points to the value found on the prototype chain
+        OwnProperty         // setter, offset is the property index
+    };
+
+    struct Entry {
+        union {
+            Heap::InternalClass *ic;
+            quintptr protoId;
+        };
+        union {
+            uint offset;
+            const Value *data;
+        };
+        EntryType type;
+    };
+
+    bool isFull() const { return size == MaxEntries; }
+
+    void append(EntryType type, Heap::InternalClass *ic, uint offset)
+    {
+        Q_ASSERT(!isFull() && type != ProtoProperty);
+        Entry &e = entries[size++];
+        e.ic = ic;
+        e.offset = offset;
+        e.type = type;
+    }
+
+    void appendProto(quintptr protoId, const Value *data)
+    {
+        Q_ASSERT(!isFull());
+        Entry &e = entries[size++];
+        e.protoId = protoId;
+        e.data = data;
+        e.type = ProtoProperty;
+    }
+
+    void markObjects(MarkStack *stack)
+    {
+        for (uint i = 0; i < size; ++i) {
+            if (entries[i].type != ProtoProperty)
+                entries[i].ic->mark(stack);
+        }
+    }
+
+    Entry entries[MaxEntries];
+    uint size = 0;
+
+    // statistics, to judge how well polymorphic call sites are served
+    quint64 hits = 0;
+    quint64 misses = 0;
+};
+
 // Note: We cannot hide the copy ctor and assignment operator of this class because it needs to
 //       be trivially copyable. But you should never ever copy it. There are refcounted members
 //       in there.
@@ -64,6 +125,11 @@ struct Q_QML_PRIVATE_EXPORT Lookup {
             uint offset;
             uint offset2;
         } objectLookupTwoClasses;
+        struct {
+            quintptr _unused; // must stay null, see markObjects
+            quintptr _unused2;
+            PolymorphicLookupTable *table;
+        } polymorphicLookup;
         struct {
             quintptr protoId;
             quintptr protoId2;
@@ -172,6 +238,7 @@ struct Q_QML_PRIVATE_EXPORT Lookup {
     static ReturnedValue getter0Inlinegetter0MemberData(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getter0MemberDatagetter0MemberData(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterProtoTwoClasses(Lookup *l, ExecutionEngine *engine, const Value &object);
+    static ReturnedValue getterPolymorphic(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterAccessor(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterProtoAccessor(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterProtoAccessorTwoClasses(Lookup *l, ExecutionEngine *engine, const Value &object);
@@ -194,6 +261,7 @@ struct Q_QML_PRIVATE_EXPORT Lookup {
     static bool setter0MemberData(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
     static bool setter0Inline(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
     static bool setter0setter0(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
+    static bool setterPolymorphic(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
     static bool setterInsert(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
     static bool setterQObject(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
     static bool arrayLengthSetter(Lookup *l, ExecutionEngine *engine, Value &object, const Value &value);
@@ -203,6 +271,8 @@ struct Q_QML_PRIVATE_EXPORT Lookup {
             markDef.h1->mark(stack);
         if (markDef.h2 && !(reinterpret_cast<quintptr>(markDef.h2) & 1))
             markDef.h2->mark(stack);
+        if ((getter == getterPolymorphic || setter == setterPolymorphic) && polymorphicLookup.table)
+            polymorphicLookup.table->markObjects(stack);
     }
 
     void clear() {
@@ -224,6 +294,9 @@ struct Q_QML_PRIVATE_EXPORT Lookup {
                    || qmlContextPropertyGetter == QQmlContextWrapper::lookupContextObjectMethod) {
             if (const QQmlPropertyCache *pc = qobjectMethodLookup.propertyCache)
                 pc->release();
+        } else if (getter == getterPolymorphic || setter == setterPolymorphic) {
+            delete polymorphicLookup.table;
+            polymorphicLookup.table = nullptr;
         }
     }
 };
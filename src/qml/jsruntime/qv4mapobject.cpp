@@ -215,7 +215,7 @@ ReturnedValue WeakMapPrototype::method_set(const FunctionObject *b, const Value
         (!argc || !argv[0].isObject()))
         return scope.engine->throwTypeError();
 
-    that->d()->esTable->set(argv[0], argc > 1 ? argv[1] : Value::undefinedValue());
+    that->d()->esTable->set(scope.engine, that->d(), argv[0], argc > 1 ? argv[1] : Value::undefinedValue());
     return that.asReturnedValue();
 }
 
@@ -318,7 +318,7 @@ ReturnedValue MapPrototype::method_set(const FunctionObject *b, const Value *thi
     if (!that || that->d()->isWeakMap)
         return scope.engine->throwTypeError();
 
-    that->d()->esTable->set(argc ? argv[0] : Value::undefinedValue(), argc > 1 ? argv[1] : Value::undefinedValue());
+    that->d()->esTable->set(scope.engine, that->d(), argc ? argv[0] : Value::undefinedValue(), argc > 1 ? argv[1] : Value::undefinedValue());
     return that.asReturnedValue();
 }
 
@@ -708,8 +708,8 @@ void Object::copyArrayData(Object *other)
             dd->values.size = other->d()->arrayData->values.size;
             dd->offset = other->d()->arrayData->offset;
         }
-        // ### need a write barrier
         memcpy(d()->arrayData->values.values, other->d()->arrayData->values.values, other->d()->arrayData->values.alloc*sizeof(Value));
+        WriteBarrier::markWritten(engine(), d()->arrayData);
     }
     setArrayLengthUnchecked(other->getLength());
 }
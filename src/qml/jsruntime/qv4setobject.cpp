@@ -105,7 +105,7 @@ ReturnedValue WeakSetPrototype::method_add(const FunctionObject *b, const Value
         (!argc || !argv[0].isObject()))
         return scope.engine->throwTypeError();
 
-    that->d()->esTable->set(argv[0], Value::undefinedValue());
+    that->d()->esTable->set(scope.engine, that->d(), argv[0], Value::undefinedValue());
     return that.asReturnedValue();
 }
 
@@ -193,7 +193,7 @@ ReturnedValue SetPrototype::method_add(const FunctionObject *b, const Value *thi
     if (!that || that->d()->isWeakSet)
         return scope.engine->throwTypeError();
 
-    that->d()->esTable->set(argv[0], Value::undefinedValue());
+    that->d()->esTable->set(scope.engine, that->d(), argv[0], Value::undefinedValue());
     return that.asReturnedValue();
 }
 
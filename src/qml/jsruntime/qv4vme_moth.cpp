@@ -521,11 +521,16 @@ ReturnedValue VME::exec(JSTypesStackFrame *frame, ExecutionEngine *engine)
         // Check for codeRef here. In rare cases the JIT compilation may fail, which leaves us
         // with a (useless) codeRef, but no jittedCode. In that case, don't try to JIT again every
         // time we execute the function, but just interpret instead.
+        // With QV4_JIT_ASYNC, keep interpreting until the worker thread has published the code.
         if (function->codeRef == nullptr) {
-            if (engine->canJIT(function))
-                QV4::JIT::BaselineJIT(function).generate();
-            else
+            if (function->jitQueued)
+                function->installPendingJittedCode();
+            else if (!engine->canJIT(function))
                 ++function->interpreterCallCount;
+            else if (engine->canJITInBackground())
+                engine->queueJIT(function);
+            else
+                QV4::JIT::BaselineJIT(function).generate();
         }
     }
 #endif // QT_CONFIG(qml_jit)
@@ -17,6 +17,9 @@
 #include <QElapsedTimer>
 #include <QMap>
 #include <QScopedValueRollback>
+#include <QMutex>
+#include <QThreadPool>
+#include <QWaitCondition>
 
 #include <iostream>
 #include <cstdlib>
@@ -272,9 +275,6 @@ bool Chunk::sweep(ExecutionEngine *engine)
     HeapItem *o = realBase();
     bool lastSlotFree = false;
     for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
-#if WRITEBARRIER(none)
-        Q_ASSERT((grayBitmap[i] | blackBitmap[i]) == blackBitmap[i]); // check that we don't have gray only objects
-#endif
         quintptr toFree = objectBitmap[i] ^ blackBitmap[i];
         Q_ASSERT((toFree & objectBitmap[i]) == toFree); // check all black objects are marked as being used
         quintptr e = extendsBitmap[i];
@@ -331,6 +331,49 @@ bool Chunk::sweep(ExecutionEngine *engine)
     return hasUsedSlots;
 }
 
+// Sweeps a chunk known to hold no objects with a destroy() function. Only the bitmaps in the
+// chunk header are touched, so this can safely run on a worker thread. It also resets the black
+// bits if requested, as the chunk is not available to the GC thread at that point anymore.
+// The gray bits are left alone: the write barrier keeps setting them on the mutator thread while
+// the sweep is running. They have to be reset before the chunk is handed to the worker.
+bool Chunk::sweepPlainObjects(bool resetBlackBits)
+{
+    bool hasUsedSlots = false;
+    bool lastSlotFree = false;
+    for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
+        quintptr toFree = objectBitmap[i] ^ blackBitmap[i];
+        Q_ASSERT((toFree & objectBitmap[i]) == toFree); // check all black objects are marked as being used
+        quintptr e = extendsBitmap[i];
+        if (lastSlotFree)
+            e &= (e + 1); // clear all lowest extent bits
+        while (toFree) {
+            uint index = qCountTrailingZeroBits(toFree);
+            quintptr bit = (static_cast<quintptr>(1) << index);
+
+            toFree ^= bit; // mask out freed slot
+
+            // remove all extends slots that have been freed, see sweep() above
+            quintptr mask = (bit << 1) - 1;
+            quintptr objmask = e | mask;
+            quintptr result = objmask + 1;
+            Q_ASSERT(qCountTrailingZeroBits(result) - index != 0); // ensure we freed something
+            result |= mask;
+            e &= result;
+#ifdef V4_USE_HEAPTRACK
+            heaptrack_report_free(realBase() + i * Chunk::Bits + index);
+#endif
+        }
+        objectBitmap[i] = blackBitmap[i];
+        if (resetBlackBits)
+            blackBitmap[i] = 0;
+        hasUsedSlots |= (objectBitmap[i] != 0);
+        extendsBitmap[i] = e;
+        lastSlotFree = !((objectBitmap[i]|extendsBitmap[i]) >> (sizeof(quintptr)*8 - 1));
+        Q_ASSERT((objectBitmap[i] & extendsBitmap[i]) == 0);
+    }
+    return hasUsedSlots;
+}
+
 void Chunk::freeAll(ExecutionEngine *engine)
 {
     //    DEBUG << "sweeping chunk" << this << (*freeList);
@@ -380,14 +423,16 @@ void Chunk::resetBlackBits()
     memset(blackBitmap, 0, sizeof(blackBitmap));
 }
 
+void Chunk::resetGrayBits()
+{
+    memset(grayBitmap, 0, sizeof(grayBitmap));
+}
+
 void Chunk::collectGrayItems(MarkStack *markStack)
 {
     //    DEBUG << "sweeping chunk" << this << (*freeList);
     HeapItem *o = realBase();
     for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
-#if WRITEBARRIER(none)
-        Q_ASSERT((grayBitmap[i] | blackBitmap[i]) == blackBitmap[i]); // check that we don't have gray only objects
-#endif
         quintptr toMark = blackBitmap[i] & grayBitmap[i]; // correct for a Steele type barrier
         Q_ASSERT((toMark & objectBitmap[i]) == toMark); // check all black objects are marked as being used
         //        DEBUG << hex << "   index=" << i << toFree;
@@ -476,6 +521,101 @@ void Chunk::sortIntoBins(HeapItem **bins, uint nBins)
 #endif
 }
 
+// Chunks of a BlockAllocator that are being swept in the background. Both the worker thread and
+// the allocator take chunks from the pending list. That way allocation never has to wait for
+// more than the chunk that is currently being swept by the worker.
+struct SweepJob
+{
+    SweepJob(const std::vector<Chunk *> &chunks, bool resetBlackBits)
+        : pending(chunks), resetBlackBits(resetBlackBits), unsweptChunks(int(chunks.size()))
+    {}
+
+    void run();
+    bool sweep(Chunk *c);
+    Chunk *takeSweptChunk();
+    Chunk *takeEmptyChunk();
+
+    // Can be asked without taking the mutex, and never waits for the worker.
+    bool isDone() const { return unsweptChunks.loadAcquire() == 0; }
+    size_t usedSlotsEstimate() const
+    {
+        return usedSlots.loadRelaxed() + size_t(unsweptChunks.loadRelaxed()) * Chunk::AvailableSlots;
+    }
+
+    QMutex mutex;
+    QWaitCondition chunkSwept;
+    std::vector<Chunk *> pending;
+    std::vector<Chunk *> swept;
+    std::vector<Chunk *> empty;
+    int inProgress = 0;
+    const bool resetBlackBits;
+    QAtomicInteger<size_t> usedSlots{0}; // in all chunks swept so far
+    QAtomicInt unsweptChunks; // only decremented once the chunk is in swept or empty
+};
+
+bool SweepJob::sweep(Chunk *c)
+{
+    const bool hasUsedSlots = c->sweepPlainObjects(resetBlackBits);
+    usedSlots.fetchAndAddRelaxed(c->nUsedSlots());
+    return hasUsedSlots;
+}
+
+void SweepJob::run()
+{
+    QMutexLocker locker(&mutex);
+    while (!pending.empty()) {
+        Chunk *c = pending.back();
+        pending.pop_back();
+        ++inProgress;
+        locker.unlock();
+        const bool hasUsedSlots = sweep(c);
+        locker.relock();
+        --inProgress;
+        (hasUsedSlots ? swept : empty).push_back(c);
+        unsweptChunks.fetchAndSubRelease(1);
+        chunkSwept.wakeAll();
+    }
+}
+
+// Returns the next swept chunk that still holds objects, or nullptr once there are none left.
+Chunk *SweepJob::takeSweptChunk()
+{
+    QMutexLocker locker(&mutex);
+    while (swept.empty()) {
+        if (!pending.empty()) {
+            // Don't wait for the worker, sweep the next chunk right here.
+            Chunk *c = pending.back();
+            pending.pop_back();
+            locker.unlock();
+            const bool hasUsedSlots = sweep(c);
+            locker.relock();
+            unsweptChunks.fetchAndSubRelease(1);
+            if (hasUsedSlots)
+                return c;
+            empty.push_back(c);
+        } else if (inProgress) {
+            chunkSwept.wait(&mutex);
+        } else {
+            return nullptr;
+        }
+    }
+    Chunk *c = swept.back();
+    swept.pop_back();
+    return c;
+}
+
+// Only valid once takeSweptChunk() has returned nullptr.
+Chunk *SweepJob::takeEmptyChunk()
+{
+    QMutexLocker locker(&mutex);
+    Q_ASSERT(pending.empty() && swept.empty() && !inProgress);
+    if (empty.empty())
+        return nullptr;
+    Chunk *c = empty.back();
+    empty.pop_back();
+    return c;
+}
+
 HeapItem *BlockAllocator::allocate(size_t size, bool forceAllocation) {
     Q_ASSERT((size % Chunk::SlotSize) == 0);
     size_t slotsRequired = size >> Chunk::SlotSizeShift;
@@ -487,6 +627,7 @@ HeapItem *BlockAllocator::allocate(size_t size, bool forceAllocation) {
 
     HeapItem *m;
 
+retry:
     if (slotsRequired < NumBins - 1) {
         m = freeBins[slotsRequired];
         if (m) {
@@ -556,6 +697,8 @@ HeapItem *BlockAllocator::allocate(size_t size, bool forceAllocation) {
     }
 
     if (!m) {
+        if (pendingSweep && collectSweptChunk())
+            goto retry;
         if (!forceAllocation)
             return nullptr;
         Chunk *newChunk = chunkAllocator->allocate();
@@ -606,8 +749,88 @@ void BlockAllocator::sweep()
     chunks.erase(firstEmptyChunk, chunks.end());
 }
 
+void BlockAllocator::sweepInBackground(bool resetBlackBits)
+{
+    Q_ASSERT(!pendingSweep);
+    nextFree = nullptr;
+    nFree = 0;
+    memset(freeBins, 0, sizeof(freeBins));
+    usedSlotsAfterLastSweep = 0;
+
+    if (chunks.empty())
+        return;
+
+    // The write barrier may flag objects in these chunks gray while they are being swept, so
+    // the worker must not touch the gray bits. Reset them here, before the mutator continues.
+    for (auto c : chunks)
+        c->resetGrayBits();
+
+    pendingSweep = std::make_shared<SweepJob>(chunks, resetBlackBits);
+    QThreadPool::globalInstance()->start([job = pendingSweep]() { job->run(); });
+}
+
+// Makes the memory of one more chunk swept in the background available for allocation.
+bool BlockAllocator::collectSweptChunk()
+{
+    Q_ASSERT(pendingSweep);
+    Chunk *c = pendingSweep->takeSweptChunk();
+    if (!c) {
+        // Everything with live objects in it is back, start re-using the empty chunks.
+        c = pendingSweep->takeEmptyChunk();
+        if (!c) {
+            pendingSweep.reset();
+            return false;
+        }
+    }
+    c->sortIntoBins(freeBins, NumBins);
+    usedSlotsAfterLastSweep += c->nUsedSlots();
+    return true;
+}
+
+size_t BlockAllocator::usedSlotsAfterSweep()
+{
+    if (!pendingSweep)
+        return usedSlotsAfterLastSweep;
+    // Collecting the chunks of a completed sweep doesn't wait for anything.
+    if (pendingSweep->isDone()) {
+        finishSweep();
+        return usedSlotsAfterLastSweep;
+    }
+    return pendingSweep->usedSlotsEstimate();
+}
+
+void BlockAllocator::finishSweep()
+{
+    if (!pendingSweep)
+        return;
+
+    while (Chunk *c = pendingSweep->takeSweptChunk()) {
+        c->sortIntoBins(freeBins, NumBins);
+        usedSlotsAfterLastSweep += c->nUsedSlots();
+    }
+
+    std::vector<Chunk *> emptyChunks;
+    while (Chunk *c = pendingSweep->takeEmptyChunk())
+        emptyChunks.push_back(c);
+    pendingSweep.reset();
+
+    if (emptyChunks.empty())
+        return;
+
+    std::sort(emptyChunks.begin(), emptyChunks.end());
+    auto firstEmptyChunk = std::partition(chunks.begin(), chunks.end(), [&emptyChunks](Chunk *c) {
+        return !std::binary_search(emptyChunks.begin(), emptyChunks.end(), c);
+    });
+    std::for_each(firstEmptyChunk, chunks.end(), [this](Chunk *c) {
+        Q_V4_PROFILE_DEALLOC(engine, Chunk::DataSize, Profiling::HeapPage);
+        chunkAllocator->free(c);
+    });
+    chunks.erase(firstEmptyChunk, chunks.end());
+}
+
 void BlockAllocator::freeAll()
 {
+    finishSweep();
     for (auto c : chunks)
         c->freeAll(engine);
     for (auto c : chunks) {
@@ -618,6 +841,9 @@ void BlockAllocator::freeAll()
 
 void BlockAllocator::resetBlackBits()
 {
+    // a pending sweep job resets them while sweeping
+    if (pendingSweep)
+        return;
     for (auto c : chunks)
         c->resetBlackBits();
 }
@@ -680,7 +906,7 @@ void HugeItemAllocator::sweep(ClassDestroyStatsCallback classCountPtr)
 {
     auto isBlack = [this, classCountPtr] (const HugeChunk &c) {
         bool b = c.chunk->first()->isBlack();
-        Chunk::clearBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase());
+        // the black bit is cleared in resetBlackBits(), unless the GC is generational
         if (!b) {
             Q_V4_PROFILE_DEALLOC(engine, c.size, Profiling::LargeItem);
             freeHugeChunk(chunkAllocator, c, classCountPtr);
@@ -704,9 +930,11 @@ void HugeItemAllocator::collectGrayItems(MarkStack *markStack)
         // Correct for a Steele type barrier
         if (Chunk::testBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase()) &&
             Chunk::testBit(c.chunk->grayBitmap, c.chunk->first() - c.chunk->realBase())) {
+            Chunk::clearBit(c.chunk->grayBitmap, c.chunk->first() - c.chunk->realBase());
             HeapItem *i = c.chunk->first();
             Heap::Base *b = *i;
-            b->mark(markStack);
+            // already black, so mark() would not visit it again
+            markStack->push(b);
         }
 }
 
@@ -723,21 +951,33 @@ MemoryManager::MemoryManager(ExecutionEngine *engine)
     : engine(engine)
     , chunkAllocator(new ChunkAllocator)
     , blockAllocator(chunkAllocator, engine)
+    , plainObjectAllocator(chunkAllocator, engine)
     , icAllocator(chunkAllocator, engine)
     , hugeItemAllocator(chunkAllocator, engine)
     , m_persistentValues(new PersistentValueStorage(engine))
     , m_weakValues(new PersistentValueStorage(engine))
     , unmanagedHeapSizeGCLimit(MinUnmanagedHeapSizeGCLimit)
     , aggressiveGC(!qEnvironmentVariableIsEmpty("QV4_MM_AGGRESSIVE_GC"))
+    , incrementalGC(!qEnvironmentVariableIsEmpty(QV4_MM_INCREMENTAL_GC))
+    , generationalGC(!qEnvironmentVariableIsEmpty(QV4_MM_GENERATIONAL_GC))
     , gcStats(lcGcStats().isDebugEnabled())
     , gcCollectorStats(lcGcAllocatorStats().isDebugEnabled())
 {
 #ifdef V4_USE_VALGRIND
     VALGRIND_CREATE_MEMPOOL(this, 0, true);
 #endif
+    bool ok = false;
+    const int sliceTimeLimit = qEnvironmentVariableIntValue(QV4_MM_GC_SLICE_TIME, &ok);
+    if (ok && sliceTimeLimit > 0)
+        gcSliceTimeLimit = sliceTimeLimit;
+    // make the first collection a full one
+    minorGCsSinceFullGC = MaxMinorGCs;
+    engine->isWriteBarrierActive = generationalGC;
     memset(statistics.allocations, 0, sizeof(statistics.allocations));
-    if (gcStats)
+    if (gcStats) {
         blockAllocator.allocationStats = statistics.allocations;
+        plainObjectAllocator.allocationStats = statistics.allocations;
+    }
 }
 
 Heap::Base *MemoryManager::allocString(std::size_t unmanagedSize)
@@ -751,17 +991,13 @@ Heap::Base *MemoryManager::allocString(std::size_t unmanagedSize)
 
     HeapItem *m = allocate(&blockAllocator, stringSize);
     memset(m, 0, stringSize);
-    if (gcBlocked) {
-        // If the gc is running right now, it will not have a chance to mark the newly created item
-        // and may therefore sweep it right away.
-        // Protect the new object from the current GC run to avoid this.
-        m->as<Heap::Base>()->setMarkBit();
-    }
+    if (gcBlocked || isMarking())
+        protectNewItem(m);
 
     return *m;
 }
 
-Heap::Base *MemoryManager::allocData(std::size_t size)
+Heap::Base *MemoryManager::allocData(std::size_t size, const VTable *vtable)
 {
 #ifdef MM_STATS
     lastAllocRequestedSlots = size >> Chunk::SlotSizeShift;
@@ -771,18 +1007,28 @@ Heap::Base *MemoryManager::allocData(std::size_t size)
     Q_ASSERT(size >= Chunk::SlotSize);
     Q_ASSERT(size % Chunk::SlotSize == 0);
 
-    HeapItem *m = allocate(&blockAllocator, size);
+    HeapItem *m = allocate(vtable->destroy ? &blockAllocator : &plainObjectAllocator, size);
     memset(m, 0, size);
-    if (gcBlocked) {
-        // If the gc is running right now, it will not have a chance to mark the newly created item
-        // and may therefore sweep it right away.
-        // Protect the new object from the current GC run to avoid this.
-        m->as<Heap::Base>()->setMarkBit();
-    }
+    if (gcBlocked || isMarking())
+        protectNewItem(m);
 
     return *m;
 }
 
+void MemoryManager::protectNewItem(HeapItem *m)
+{
+    // If the gc is running right now, it will not have a chance to mark the newly created item
+    // and may therefore sweep it right away.
+    // Protect the new object from the current GC run to avoid this.
+    Heap::Base *b = *m;
+    b->setMarkBit();
+
+    // During an incremental mark the new item is initialized without going through the write
+    // barrier. Flag it gray, so that its members get marked before the mark phase finishes.
+    if (isMarking())
+        b->setGrayBit();
+}
+
 Heap::Object *MemoryManager::allocObjectWithMemberData(const QV4::VTable *vtable, uint nMembers)
 {
     uint size = (vtable->nInlineProperties + vtable->inlinePropertyOffset)*sizeof(Value);
@@ -790,7 +1036,7 @@ Heap::Object *MemoryManager::allocObjectWithMemberData(const QV4::VTable *vtable
 
     Heap::Object *o;
     if (nMembers <= vtable->nInlineProperties) {
-        o = static_cast<Heap::Object *>(allocData(size));
+        o = static_cast<Heap::Object *>(allocData(size, vtable));
     } else {
         // Allocate both in one go through the block allocator
         nMembers -= vtable->nInlineProperties;
@@ -798,10 +1044,10 @@ Heap::Object *MemoryManager::allocObjectWithMemberData(const QV4::VTable *vtable
         size_t totalSize = size + memberSize;
         Heap::MemberData *m;
         if (totalSize > Chunk::DataSize) {
-            o = static_cast<Heap::Object *>(allocData(size));
+            o = static_cast<Heap::Object *>(allocData(size, vtable));
             m = hugeItemAllocator.allocate(memberSize)->as<Heap::MemberData>();
         } else {
-            HeapItem *mh = reinterpret_cast<HeapItem *>(allocData(totalSize));
+            HeapItem *mh = reinterpret_cast<HeapItem *>(allocData(totalSize, vtable));
             Heap::Base *b = *mh;
             o = static_cast<Heap::Object *>(b);
             mh += (size >> Chunk::SlotSizeShift);
@@ -845,6 +1091,22 @@ void MarkStack::drain()
     }
 }
 
+bool MarkStack::drain(QDeadlineTimer deadline)
+{
+    enum { DeadlineCheckInterval = 64 }; // don't query the clock for every single object
+    do {
+        for (int i = 0; i < DeadlineCheckInterval; ++i) {
+            if (m_top == m_base)
+                return true;
+            Heap::Base *h = pop();
+            ++markStackSize;
+            Q_ASSERT(h);
+            h->internalClass->vtable->markObjects(h, this);
+        }
+    } while (!deadline.hasExpired());
+    return m_top == m_base;
+}
+
 void MemoryManager::collectRoots(MarkStack *markStack)
 {
     engine->markObjects(markStack);
@@ -889,12 +1151,49 @@ void MemoryManager::collectRoots(MarkStack *markStack)
 
 void MemoryManager::mark()
 {
+    if (isMarking()) {
+        finishIncrementalMark();
+        return;
+    }
+
     markStackSize = 0;
     MarkStack markStack(engine);
     collectRoots(&markStack);
     // dtor of MarkStack drains
 }
 
+void MemoryManager::startIncrementalMark()
+{
+    Q_ASSERT(!isMarking());
+    plainObjectAllocator.finishSweep();
+    if (generationalGC)
+        resetBlackBits();
+    markStackSize = 0;
+    m_markStack = std::make_unique<MarkStack>(engine);
+    engine->isWriteBarrierActive = true;
+    collectRoots(m_markStack.get());
+}
+
+void MemoryManager::finishIncrementalMark()
+{
+    Q_ASSERT(isMarking());
+    MarkStack *markStack = m_markStack.get();
+
+    // The roots are modified without going through the write barrier, so scan them again.
+    // Then re-visit all objects that got written to or allocated since marking started.
+    collectRoots(markStack);
+    do {
+        markStack->drain();
+        blockAllocator.collectGrayItems(markStack);
+        plainObjectAllocator.collectGrayItems(markStack);
+        hugeItemAllocator.collectGrayItems(markStack);
+        icAllocator.collectGrayItems(markStack);
+    } while (!markStack->isEmpty());
+
+    engine->isWriteBarrierActive = generationalGC;
+    m_markStack.reset();
+}
+
 void MemoryManager::sweep(bool lastSweep, ClassDestroyStatsCallback classCountPtr)
 {
     for (PersistentValueStorage::Iterator it = m_weakValues->begin(); it != m_weakValues->end(); ++it) {
@@ -969,13 +1268,61 @@ void MemoryManager::sweep(bool lastSweep, ClassDestroyStatsCallback classCountPt
         blockAllocator.sweep(/*classCountPtr*/);
         hugeItemAllocator.sweep(classCountPtr);
         icAllocator.sweep(/*classCountPtr*/);
+
+        // Start this last, nothing may look at the mark bits of these objects anymore.
+        if (canSweepInBackground())
+            plainObjectAllocator.sweepInBackground(/*resetBlackBits*/ !generationalGC);
+        else
+            plainObjectAllocator.sweep();
+    }
+}
+
+bool MemoryManager::isFullGCDue()
+{
+    const size_t used = usedSlotsAfterLastFullSweep + plainObjectAllocator.usedSlotsAfterSweep();
+    if (minorGCsSinceFullGC == 0) {
+        // First decision after a full collection. Everything that survived it is old.
+        usedSlotsAfterLastFullGC = used;
+    }
+
+    // Dead old objects are only freed by a full collection.
+    return minorGCsSinceFullGC >= MaxMinorGCs
+            || used * 100 > usedSlotsAfterLastFullGC * OldGenerationGrowth;
+}
+
+void MemoryManager::resetBlackBits()
+{
+    blockAllocator.resetBlackBits();
+    plainObjectAllocator.resetBlackBits();
+    hugeItemAllocator.resetBlackBits();
+    icAllocator.resetBlackBits();
+}
+
+bool MemoryManager::canSweepInBackground() const
+{
+#if QT_CONFIG(thread)
+    // The statistics and the allocation profiler need precise numbers right after the sweep.
+    if (gcStats || gcCollectorStats || aggressiveGC)
+        return false;
+#if QT_CONFIG(qml_debug)
+    if (engine->profiler()
+            && (engine->profiler()->featuresEnabled & (1 << Profiling::FeatureMemoryAllocation))) {
+        return false;
     }
+#endif
+    return true;
+#else
+    return false;
+#endif
 }
 
-bool MemoryManager::shouldRunGC() const
+bool MemoryManager::shouldRunGC()
 {
-    size_t total = blockAllocator.totalSlots() + icAllocator.totalSlots();
-    if (total > MinSlotsGCLimit && usedSlotsAfterLastFullSweep * GCOverallocation < total * 100)
+    // the decision is based on the number of used slots after the last sweep
+    size_t total = blockAllocator.totalSlots() + plainObjectAllocator.totalSlots()
+            + icAllocator.totalSlots();
+    size_t used = usedSlotsAfterLastFullSweep + plainObjectAllocator.usedSlotsAfterSweep();
+    if (total > MinSlotsGCLimit && used * GCOverallocation < total * 100)
         return true;
     return false;
 }
@@ -1019,6 +1366,90 @@ void MemoryManager::runGC()
     QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
 //    qDebug() << "runGC";
 
+    QElapsedTimer pauseTimer;
+    pauseTimer.start();
+    collectGarbage();
+    recordGCPause(pauseTimer.nsecsElapsed());
+}
+
+void MemoryManager::runGCSlice()
+{
+    if (!incrementalGC) {
+        runGC();
+        return;
+    }
+
+    if (gcBlocked)
+        return;
+
+    QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
+    allocationsSinceGCSlice = 0;
+
+    QElapsedTimer pauseTimer;
+    pauseTimer.start();
+    if (!isMarking())
+        startIncrementalMark();
+    if (m_markStack->drain(QDeadlineTimer(gcSliceTimeLimit, Qt::PreciseTimer)))
+        collectGarbage();
+    recordGCPause(pauseTimer.nsecsElapsed());
+}
+
+void MemoryManager::recordGCPause(qint64 nsecs)
+{
+    statistics.maxGCPause = qMax(statistics.maxGCPause, nsecs);
+}
+
+void MemoryManager::runMinorGC()
+{
+    if (gcBlocked || isMarking())
+        return;
+
+    QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
+    QElapsedTimer pauseTimer;
+    pauseTimer.start();
+
+    plainObjectAllocator.finishSweep();
+    const size_t usedBefore = gcCollectorStats ? getUsedMem() + getLargeItemsMem() : 0;
+
+    markStackSize = 0;
+    {
+        MarkStack markStack(engine);
+        // Old objects are black already. This only marks young objects reachable from the roots,
+        collectRoots(&markStack);
+        // ... and the ones reachable from old objects written to since the last collection.
+        blockAllocator.collectGrayItems(&markStack);
+        plainObjectAllocator.collectGrayItems(&markStack);
+        hugeItemAllocator.collectGrayItems(&markStack);
+        icAllocator.collectGrayItems(&markStack);
+        // dtor of MarkStack drains
+    }
+    const qint64 markTime = pauseTimer.nsecsElapsed() / 1000;
+
+    // The survivors keep their black bits, they are old now.
+    sweep(false, gcCollectorStats ? increaseFreedCountForClass : nullptr);
+    usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep + icAllocator.usedSlotsAfterLastSweep;
+    ++minorGCsSinceFullGC;
+
+    if (gcCollectorStats) {
+        const QLoggingCategory &stats = lcGcAllocatorStats();
+        qDebug(stats) << "========== Minor GC ==========";
+        qDebug(stats) << "Marked" << markStackSize << "young objects in" << markTime << "us.";
+        qDebug(stats) << "Freed up bytes:" << (usedBefore - getUsedMem() - getLargeItemsMem());
+        qDebug(stats) << "Minor collections since last full GC:" << minorGCsSinceFullGC;
+        freedObjectStatsGlobal()->clear();
+    }
+
+    recordGCPause(pauseTimer.nsecsElapsed());
+}
+
+void MemoryManager::collectGarbage()
+{
+    plainObjectAllocator.finishSweep();
+    if (generationalGC && !isMarking()) {
+        // a full collection re-marks everything, including the old generation
+        resetBlackBits();
+    }
+
     if (gcStats) {
         statistics.maxReservedMem = qMax(statistics.maxReservedMem, getAllocatedMem());
         statistics.maxAllocatedMem = qMax(statistics.maxAllocatedMem, getUsedMem() + getLargeItemsMem());
@@ -1042,10 +1473,13 @@ void MemoryManager::runGC()
         qDebug(stats) << "    Allocations since last GC" << allocationCount;
         allocationCount = 0;
 #endif
-        size_t oldChunks = blockAllocator.chunks.size();
+        size_t oldChunks = blockAllocator.chunks.size() + plainObjectAllocator.chunks.size();
+        if (isMarking())
+            qDebug(stats) << "    Finishing incremental mark," << markStackSize << "objects marked so far";
         qDebug(stats) << "Allocated" << totalMem << "bytes in" << oldChunks << "chunks";
         qDebug(stats) << "Fragmented memory before GC" << (totalMem - usedBefore);
         dumpBins(&blockAllocator, "Block");
+        dumpBins(&plainObjectAllocator, "PlainObject");
         dumpBins(&icAllocator, "InternalClass");
 
         QElapsedTimer t;
@@ -1065,6 +1499,7 @@ void MemoryManager::runGC()
             qDebug(stats) << "   unmanaged heap limit:" << unmanagedHeapSizeGCLimit;
         }
         size_t memInBins = dumpBins(&blockAllocator, "Block")
+                + dumpBins(&plainObjectAllocator, "PlainObject")
                 + dumpBins(&icAllocator, "InternalClasss");
         qDebug(stats) << "Marked object in" << markTime << "us.";
         qDebug(stats) << "   " << markStackSize << "objects marked";
@@ -1086,8 +1521,10 @@ void MemoryManager::runGC()
         qDebug(stats) << "Used memory before GC:" << usedBefore;
         qDebug(stats) << "Used memory after GC:" << usedAfter;
         qDebug(stats) << "Freed up bytes      :" << (usedBefore - usedAfter);
-        qDebug(stats) << "Freed up chunks     :" << (oldChunks - blockAllocator.chunks.size());
-        size_t lost = blockAllocator.allocatedMem() + icAllocator.allocatedMem()
+        qDebug(stats) << "Freed up chunks     :" << (oldChunks - blockAllocator.chunks.size()
+                                                     - plainObjectAllocator.chunks.size());
+        size_t lost = blockAllocator.allocatedMem() + plainObjectAllocator.allocatedMem()
+                + icAllocator.allocatedMem()
                 - memInBins - usedAfter;
         if (lost)
             qDebug(stats) << "!!!!!!!!!!!!!!!!!!!!! LOST MEM:" << lost << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!";
@@ -1111,26 +1548,34 @@ void MemoryManager::runGC()
         // ensure we don't 'loose' any memory
         Q_ASSERT(blockAllocator.allocatedMem()
                  == blockAllocator.usedMem() + dumpBins(&blockAllocator, nullptr));
+        Q_ASSERT(plainObjectAllocator.allocatedMem()
+                 == plainObjectAllocator.usedMem() + dumpBins(&plainObjectAllocator, nullptr));
         Q_ASSERT(icAllocator.allocatedMem()
                  == icAllocator.usedMem() + dumpBins(&icAllocator, nullptr));
     }
 
+    // plainObjectAllocator is added in shouldRunGC(), it may still be sweeping
     usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep + icAllocator.usedSlotsAfterLastSweep;
 
+    if (generationalGC) {
+        // everything that is left is old now
+        minorGCsSinceFullGC = 0;
+        return;
+    }
+
     // reset all black bits
-    blockAllocator.resetBlackBits();
-    hugeItemAllocator.resetBlackBits();
-    icAllocator.resetBlackBits();
+    resetBlackBits();
 }
 
 size_t MemoryManager::getUsedMem() const
 {
-    return blockAllocator.usedMem() + icAllocator.usedMem();
+    return blockAllocator.usedMem() + plainObjectAllocator.usedMem() + icAllocator.usedMem();
 }
 
 size_t MemoryManager::getAllocatedMem() const
 {
-    return blockAllocator.allocatedMem() + icAllocator.allocatedMem() + hugeItemAllocator.usedMem();
+    return blockAllocator.allocatedMem() + plainObjectAllocator.allocatedMem()
+            + icAllocator.allocatedMem() + hugeItemAllocator.usedMem();
 }
 
 size_t MemoryManager::getLargeItemsMem() const
@@ -1152,12 +1597,21 @@ void MemoryManager::registerWeakSet(Heap::SetObject *set)
 
 MemoryManager::~MemoryManager()
 {
+    plainObjectAllocator.finishSweep();
+
+    // Abandon an unfinished incremental mark. With the generational GC, the old objects are
+    // still marked. The last sweep expects nothing to be marked.
+    m_markStack.reset();
+    engine->isWriteBarrierActive = false;
+    resetBlackBits();
+
     delete m_persistentValues;
 
     dumpStats();
 
     sweep(/*lastSweep*/true);
     blockAllocator.freeAll();
+    plainObjectAllocator.freeAll();
     hugeItemAllocator.freeAll();
     icAllocator.freeAll();
 
@@ -1179,6 +1633,7 @@ void MemoryManager::dumpStats() const
     qDebug(stats) << "Total memory allocated:" << statistics.maxReservedMem;
     qDebug(stats) << "Max memory used before a GC run:" << statistics.maxAllocatedMem;
     qDebug(stats) << "Max memory used after a GC run:" << statistics.maxUsedMem;
+    qDebug(stats) << "Longest GC pause (us):" << statistics.maxGCPause / 1000;
     qDebug(stats) << "Requests for different item sizes:";
     for (int i = 1; i < BlockAllocator::NumBins - 1; ++i)
         qDebug(stats) << "     <" << (i << Chunk::SlotSizeShift) << " bytes: " << statistics.allocations[i];
@@ -22,9 +22,14 @@
 #include <private/qv4mmdefs_p.h>
 #include <QVector>
 
+#include <memory>
+
 #define QV4_MM_MAXBLOCK_SHIFT "QV4_MM_MAXBLOCK_SHIFT"
 #define QV4_MM_MAX_CHUNK_SIZE "QV4_MM_MAX_CHUNK_SIZE"
 #define QV4_MM_STATS "QV4_MM_STATS"
+#define QV4_MM_INCREMENTAL_GC "QV4_MM_INCREMENTAL_GC"
+#define QV4_MM_GC_SLICE_TIME "QV4_MM_GC_SLICE_TIME"
+#define QV4_MM_GENERATIONAL_GC "QV4_MM_GENERATIONAL_GC"
 
 #define MM_DEBUG 0
 
@@ -34,6 +39,7 @@ namespace QV4 {
 
 struct ChunkAllocator;
 struct MemorySegment;
+struct SweepJob;
 
 struct BlockAllocator {
     BlockAllocator(ChunkAllocator *chunkAllocator, ExecutionEngine *engine)
@@ -65,6 +71,14 @@ struct BlockAllocator {
     }
 
     void sweep();
+    // Only for allocators that hold no objects with a destroy() function. The chunks are swept
+    // on a worker thread and handed back to the allocator one by one as it runs out of memory.
+    void sweepInBackground(bool resetBlackBits);
+    // Doesn't wait for a sweep still running in the background. The chunks it hasn't got to
+    // yet are counted as full.
+    size_t usedSlotsAfterSweep();
+    void finishSweep();
+    bool collectSweptChunk();
     void freeAll();
     void resetBlackBits();
     void collectGrayItems(MarkStack *markStack);
@@ -77,6 +91,7 @@ struct BlockAllocator {
     ChunkAllocator *chunkAllocator;
     ExecutionEngine *engine;
     std::vector<Chunk *> chunks;
+    std::shared_ptr<SweepJob> pendingSweep;
     uint *allocationStats = nullptr;
 };
 
@@ -128,7 +143,8 @@ public:
     {
         Q_STATIC_ASSERT(std::is_trivial_v<typename ManagedType::Data>);
         size = align(size);
-        typename ManagedType::Data *d = static_cast<typename ManagedType::Data *>(allocData(size));
+        typename ManagedType::Data *d = static_cast<typename ManagedType::Data *>(
+                    allocData(size, ManagedType::staticVTable()));
         d->internalClass.set(engine, ic);
         Q_ASSERT(d->internalClass && d->internalClass->vtable);
         Q_ASSERT(ic->vtable == ManagedType::staticVTable());
@@ -219,7 +235,13 @@ public:
         return t->d();
     }
 
+    // Runs a full collection. Finishes an incremental collection that is in progress.
     void runGC();
+    // Only collects the objects allocated since the last collection. See generationalGC.
+    void runMinorGC();
+    // Advances an incremental collection by one slice of at most gcSliceTimeLimit ms of marking.
+    void runGCSlice();
+    bool isMarking() const { return m_markStack != nullptr; }
 
     void dumpStats() const;
 
@@ -234,7 +256,10 @@ public:
     template<typename ManagedType>
     typename ManagedType::Data *allocIC()
     {
-        Heap::Base *b = *allocate(&icAllocator, align(sizeof(typename ManagedType::Data)));
+        HeapItem *m = allocate(&icAllocator, align(sizeof(typename ManagedType::Data)));
+        if (isMarking())
+            protectNewItem(m);
+        Heap::Base *b = *m;
         return static_cast<typename ManagedType::Data *>(b);
     }
 
@@ -244,18 +269,44 @@ public:
 protected:
     /// expects size to be aligned
     Heap::Base *allocString(std::size_t unmanagedSize);
-    Heap::Base *allocData(std::size_t size);
+    Heap::Base *allocData(std::size_t size, const VTable *vtable);
     Heap::Object *allocObjectWithMemberData(const QV4::VTable *vtable, uint nMembers);
 
 private:
     enum {
-        MinUnmanagedHeapSizeGCLimit = 128 * 1024
+        MinUnmanagedHeapSizeGCLimit = 128 * 1024,
+        GCSliceAllocationInterval = 1024,
+        DefaultGCSliceTimeLimit = 5, // ms
+        MaxMinorGCs = 16, // minor collections between two full ones
+        OldGenerationGrowth = 200 // Max growth of the old generation between full collections in %
     };
 
     void collectFromJSStack(MarkStack *markStack) const;
+    void collectGarbage();
+    void startIncrementalMark();
+    void finishIncrementalMark();
+    void protectNewItem(HeapItem *m);
+    void recordGCPause(qint64 nsecs);
+    bool isFullGCDue();
+    void resetBlackBits();
+    void triggerFullGC()
+    {
+        if (incrementalGC)
+            runGCSlice();
+        else
+            runGC();
+    }
+    void triggerGC()
+    {
+        if (generationalGC && !isFullGCDue())
+            runMinorGC();
+        else
+            triggerFullGC();
+    }
     void mark();
     void sweep(bool lastSweep = false, ClassDestroyStatsCallback classCountPtr = nullptr);
-    bool shouldRunGC() const;
+    bool shouldRunGC();
+    bool canSweepInBackground() const;
     void collectRoots(MarkStack *markStack);
 
     HeapItem *allocate(BlockAllocator *allocator, std::size_t size)
@@ -264,13 +315,22 @@ private:
         if (aggressiveGC) {
             runGC();
             didGCRun = true;
+        } else if (Q_UNLIKELY(isMarking())) {
+            // An incremental collection is in progress. Advance it at a steady pace and let
+            // the heap grow until it is done.
+            if (++allocationsSinceGCSlice >= GCSliceAllocationInterval)
+                runGCSlice();
+            didGCRun = true;
         }
 
-        if (unmanagedHeapSize > unmanagedHeapSizeGCLimit) {
+        if (unmanagedHeapSize > unmanagedHeapSizeGCLimit && !isMarking()) {
+            // A minor collection would not free unmanaged memory held by old objects
             if (!didGCRun)
-                runGC();
+                triggerFullGC();
 
-            if (3*unmanagedHeapSizeGCLimit <= 4 * unmanagedHeapSize) {
+            if (isMarking()) {
+                // the limit is adjusted once the collection is complete
+            } else if (3*unmanagedHeapSizeGCLimit <= 4 * unmanagedHeapSize) {
                 // more than 75% full, raise limit
                 unmanagedHeapSizeGCLimit = std::max(unmanagedHeapSizeGCLimit,
                                                     unmanagedHeapSize) * 2;
@@ -289,7 +349,7 @@ private:
             return m;
 
         if (!didGCRun && shouldRunGC())
-            runGC();
+            triggerGC();
 
         return allocator->allocate(size, true);
     }
@@ -298,6 +358,7 @@ public:
     QV4::ExecutionEngine *engine;
     ChunkAllocator *chunkAllocator;
     BlockAllocator blockAllocator;
+    BlockAllocator plainObjectAllocator; // objects without a destroy() function, swept in the background
     BlockAllocator icAllocator;
     HugeItemAllocator hugeItemAllocator;
     PersistentValueStorage *m_persistentValues;
@@ -309,12 +370,23 @@ public:
     std::size_t unmanagedHeapSize = 0; // the amount of bytes of heap that is not managed by the memory manager, but which is held onto by managed items.
     std::size_t unmanagedHeapSizeGCLimit;
     std::size_t usedSlotsAfterLastFullSweep = 0;
+    std::size_t usedSlotsAfterLastFullGC = 0;
+    int minorGCsSinceFullGC = 0;
 
     bool gcBlocked = false;
     bool aggressiveGC = false;
+    bool incrementalGC = false;
+    // Objects that survive a collection keep their mark bit and are considered old. Minor
+    // collections only mark from the roots and from old objects written to since the last
+    // collection, and only free unmarked, young objects. Full collections clear all mark bits.
+    bool generationalGC = false;
     bool gcStats = false;
     bool gcCollectorStats = false;
 
+    int gcSliceTimeLimit = DefaultGCSliceTimeLimit; // in ms
+    int allocationsSinceGCSlice = 0;
+    std::unique_ptr<MarkStack> m_markStack; // only set while an incremental mark is in progress
+
     int allocationCount = 0;
     size_t lastAllocRequestedSlots = 0;
 
@@ -322,6 +394,7 @@ public:
         size_t maxReservedMem = 0;
         size_t maxAllocatedMem = 0;
         size_t maxUsedMem = 0;
+        qint64 maxGCPause = 0; // in ns
         uint allocations[BlockAllocator::NumBins];
     } statistics;
 };
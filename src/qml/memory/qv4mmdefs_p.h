@@ -17,6 +17,7 @@
 #include <private/qv4global_p.h>
 #include <private/qv4runtimeapi_p.h>
 #include <QtCore/qalgorithms.h>
+#include <QtCore/qdeadlinetimer.h>
 #include <QtCore/qmath.h>
 
 QT_BEGIN_NAMESPACE
@@ -152,8 +153,10 @@ struct Chunk {
 
     bool sweep(ClassDestroyStatsCallback classCountPtr);
     void resetBlackBits();
+    void resetGrayBits();
     void collectGrayItems(QV4::MarkStack *markStack);
     bool sweep(ExecutionEngine *engine);
+    bool sweepPlainObjects(bool resetBlackBits);
     void freeAll(ExecutionEngine *engine);
 
     void sortIntoBins(HeapItem **bins, uint nBins);
@@ -259,9 +262,14 @@ struct Q_QML_PRIVATE_EXPORT MarkStack {
 
     ExecutionEngine *engine() const { return m_engine; }
 
+    bool isEmpty() const { return m_top == m_base; }
+
+    void drain();
+    // Returns true if the stack was drained completely before the deadline expired
+    bool drain(QDeadlineTimer deadline);
+
 private:
     Heap::Base *pop() { return *(--m_top); }
-    void drain();
 
     Heap::Base **m_top = nullptr;
     Heap::Base **m_base = nullptr;
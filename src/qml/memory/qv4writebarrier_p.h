@@ -15,10 +15,12 @@
 //
 
 #include <private/qv4global_p.h>
+#include <private/qv4enginebase_p.h>
+#include <private/qv4mmdefs_p.h>
 
 QT_BEGIN_NAMESPACE
 
-#define WRITEBARRIER_none 1
+#define WRITEBARRIER_steele 1
 
 #define WRITEBARRIER(x) (1/WRITEBARRIER_##x == 1)
 
@@ -41,25 +43,42 @@ enum NewValueType {
 // ### this needs to be filled with a real memory fence once marking is concurrent
 Q_ALWAYS_INLINE void fence() {}
 
-#if WRITEBARRIER(none)
+#if WRITEBARRIER(steele)
 
 template <NewValueType type>
 static constexpr inline bool isRequired() {
-    return false;
+    return type != Primitive;
+}
+
+// A Steele type barrier: while it is active, every object that gets written to is flagged gray.
+// The incremental GC re-visits all black and gray objects before it finishes marking. For the
+// generational GC, the black and gray objects form the remembered set of old objects that may
+// point to young ones.
+Q_ALWAYS_INLINE void markGray(Heap::Base *base)
+{
+    HeapItem *h = reinterpret_cast<HeapItem *>(base);
+    Chunk *c = h->chunk();
+    Chunk::setBit(c->grayBitmap, h - c->realBase());
+}
+
+// For stores that cannot go through write(): bulk copies, or values that \a base keeps in
+// unmanaged memory. Call it after the values have been stored.
+inline void markWritten(EngineBase *engine, Heap::Base *base)
+{
+    if (Q_UNLIKELY(engine->isWriteBarrierActive) && base)
+        markGray(base);
 }
 
 inline void write(EngineBase *engine, Heap::Base *base, ReturnedValue *slot, ReturnedValue value)
 {
-    Q_UNUSED(engine);
-    Q_UNUSED(base);
     *slot = value;
+    markWritten(engine, base);
 }
 
 inline void write(EngineBase *engine, Heap::Base *base, Heap::Base **slot, Heap::Base *value)
 {
-    Q_UNUSED(engine);
-    Q_UNUSED(base);
     *slot = value;
+    markWritten(engine, base);
 }
 
 #endif
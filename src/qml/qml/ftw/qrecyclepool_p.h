@@ -179,6 +179,52 @@ void QRecyclePoolPrivate<T, Step>::dispose(T *t)
     This->releaseIfPossible();
 }
 
+/*
+    Storage of up to Size bytes, recycled through a QRecyclePool of the
+    allocating thread. Larger requests, as made by bigger subclasses, are
+    passed on to the global heap. This is meant to back class specific
+    operator new and delete of objects that are created and destroyed in the
+    thread of their engine.
+
+    The pool does not give memory back to the heap while the thread runs:
+    freed storage is only kept for reuse, so the peak number of objects a
+    thread has had alive stays allocated. The pages are released once the
+    thread has exited and all storage allocated from them has been freed.
+*/
+template<size_t Size, int Step = 1024>
+class QRecyclePoolAllocator
+{
+public:
+    static void *allocate(size_t size)
+    {
+        if (size > Size)
+            return ::operator new(size);
+        return pool().New();
+    }
+
+    static void deallocate(void *ptr, size_t size)
+    {
+        if (size > Size)
+            ::operator delete(ptr);
+        else
+            QRecyclePool<Storage, Step>::Delete(static_cast<Storage *>(ptr));
+    }
+
+private:
+    union Storage {
+        char data[Size];
+        qint64 q_for_alignment_1;
+        double q_for_alignment_2;
+        void *q_for_alignment_3;
+    };
+
+    static QRecyclePool<Storage, Step> &pool()
+    {
+        static thread_local QRecyclePool<Storage, Step> threadPool;
+        return threadPool;
+    }
+};
+
 QT_END_NAMESPACE
 
 #endif // QRECYCLEPOOL_P_H
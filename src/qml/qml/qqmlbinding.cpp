@@ -20,15 +20,40 @@
 #include <private/qv4variantobject_p.h>
 #include <private/qv4jscall_p.h>
 #include <private/qjsvalue_p.h>
+#include <private/qrecyclepool_p.h>
 
 #include <qtqml_tracepoints_p.h>
 
 #include <QVariant>
 #include <QtCore/qdebug.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qvarlengtharray.h>
 #include <QVector>
 
 QT_BEGIN_NAMESPACE
 
+Q_LOGGING_CATEGORY(lcBindingUpdates, "qt.qml.binding.updates")
+
+// Engines of this thread with queued binding updates
+Q_CONSTINIT static thread_local QQmlEnginePrivate *enginesWithBindingUpdates = nullptr;
+
+// Bindings that are still changing after this many passes of a flush are
+// taken to be binding loops and evaluated right away, so that the usual loop
+// detection in QQmlBinding::update() reports them.
+static const quint16 MaxBindingUpdatePasses = 1000;
+
+static void removeFromBindingUpdateList(QQmlEnginePrivate *ep)
+{
+    for (QQmlEnginePrivate **e = &enginesWithBindingUpdates; *e; e = &(*e)->nextWithBindingUpdates) {
+        if (*e == ep) {
+            *e = ep->nextWithBindingUpdates;
+            break;
+        }
+    }
+    ep->nextWithBindingUpdates = nullptr;
+}
+
 QQmlBinding *QQmlBinding::create(const QQmlPropertyData *property, const QQmlScriptString &script, QObject *obj, QQmlContext *ctxt)
 {
     QQmlBinding *b = newBinding(property);
@@ -597,9 +622,187 @@ QVariant QQmlBinding::evaluate()
 
 void QQmlBinding::expressionChanged()
 {
+    if (QQmlEngine *qmlEngine = engine()) {
+        QQmlEnginePrivate *ep = QQmlEnginePrivate::get(qmlEngine);
+        if (ep->deferBindingUpdates) {
+            ep->queueBindingUpdate(this);
+            return;
+        }
+    }
     update();
 }
 
+void QQmlEnginePrivate::queueBindingUpdate(QQmlBinding *binding)
+{
+    // The target object has been destroyed, and only the queue keeps the binding alive
+    if (!binding->isAddedToObject())
+        return;
+
+    if (flushingBindingUpdates && bindingUpdatePass >= MaxBindingUpdatePasses) {
+        binding->update();
+        return;
+    }
+
+    // A binding still waiting for its turn in this pass or the next one gets
+    // to see the new value anyway.
+    if (binding->m_updateQueued) {
+        ++avoidedBindingEvaluations;
+        return;
+    }
+    binding->m_updateQueued = true;
+
+    // While flushing, the engine stays in the list until the flush is done
+    if (!flushingBindingUpdates && queuedBindingUpdates.isEmpty()) {
+        nextWithBindingUpdates = enginesWithBindingUpdates;
+        enginesWithBindingUpdates = this;
+        QMetaObject::invokeMethod(q_func(), [this]() { flushBindingUpdates(); },
+                                  Qt::QueuedConnection);
+    }
+    queuedBindingUpdates.append(QQmlAbstractBinding::Ptr(binding));
+}
+
+void QQmlEnginePrivate::flushBindingUpdates()
+{
+    if (flushingBindingUpdates || queuedBindingUpdates.isEmpty())
+        return;
+
+    flushingBindingUpdates = true;
+    const quint64 avoidedBefore = avoidedBindingEvaluations;
+    int evaluated = 0;
+    // Bindings queued while a pass is evaluated, because a dependency changed
+    // after they were done or in a way the captured dependencies did not show,
+    // are evaluated in the next pass.
+    for (bindingUpdatePass = 0; !queuedBindingUpdates.isEmpty(); ++bindingUpdatePass) {
+        QVector<QQmlAbstractBinding::Ptr> bindings = std::exchange(queuedBindingUpdates, {});
+
+        // The queue keeps bindings alive after QQmlData::destroyed() has
+        // removed them from their target. Their target must not be touched.
+        bindings.removeIf([](const QQmlAbstractBinding::Ptr &b) {
+            if (b->isAddedToObject())
+                return false;
+            static_cast<QQmlBinding *>(b.data())->m_updateQueued = false;
+            return true;
+        });
+
+        bindings = QQmlBinding::sortedByDependencies(bindings);
+        for (const QQmlAbstractBinding::Ptr &b : std::as_const(bindings)) {
+            QQmlBinding *binding = static_cast<QQmlBinding *>(b.data());
+            binding->m_updateQueued = false;
+            // The target may have been destroyed by an earlier update
+            if (!binding->isAddedToObject())
+                continue;
+            binding->update();
+            ++evaluated;
+        }
+    }
+    bindingUpdatePass = 0;
+    flushingBindingUpdates = false;
+
+    removeFromBindingUpdateList(this);
+
+    qCDebug(lcBindingUpdates) << "evaluated" << evaluated << "bindings,"
+                              << (avoidedBindingEvaluations - avoidedBefore) << "evaluations avoided,"
+                              << avoidedBindingEvaluations << "in total";
+}
+
+void QQmlEnginePrivate::clearBindingUpdates()
+{
+    if (queuedBindingUpdates.isEmpty())
+        return;
+
+    for (const QQmlAbstractBinding::Ptr &b : std::as_const(queuedBindingUpdates))
+        static_cast<QQmlBinding *>(b.data())->m_updateQueued = false;
+    queuedBindingUpdates.clear();
+
+    removeFromBindingUpdateList(this);
+}
+
+/*
+    Evaluates the queued binding updates of all engines living in the current
+    thread. Called before items are polished so that they see final values.
+ */
+void QQmlEnginePrivate::flushBindingUpdatesForCurrentThread()
+{
+    while (QQmlEnginePrivate *ep = enginesWithBindingUpdates) {
+        if (ep->flushingBindingUpdates)
+            break;
+        ep->flushBindingUpdates();
+    }
+}
+
+/*
+    Orders \a bindings so that each one comes after the ones it read from
+    during its last evaluation, going by the guards it holds. All of them
+    must still be added to their target object. A binding that
+    writes to a property whose notify signal another binding is connected to
+    is evaluated first, so the other one sees its final value. Cycles are
+    broken in queue order.
+ */
+QVector<QQmlAbstractBinding::Ptr> QQmlBinding::sortedByDependencies(
+        const QVector<QQmlAbstractBinding::Ptr> &bindings)
+{
+    if (bindings.size() < 2)
+        return bindings;
+
+    const auto bindingAt = [&bindings](int i) {
+        return static_cast<const QQmlBinding *>(bindings.at(i).data());
+    };
+
+    // The queued bindings, by the notify signal of their target property
+    QHash<QPair<QObject *, int>, int> bindingForSignal;
+    for (int i = 0; i < bindings.size(); ++i) {
+        const QQmlBinding *binding = bindingAt(i);
+        Q_ASSERT(binding->isAddedToObject());
+        QObject *target = binding->targetObject();
+        if (!target || QQmlData::wasDeleted(target))
+            continue;
+        const QQmlPropertyData *propertyData = nullptr;
+        QQmlPropertyData valueTypeData;
+        binding->getPropertyData(&propertyData, &valueTypeData);
+        if (propertyData && propertyData->notifyIndex() != -1)
+            bindingForSignal.insert(qMakePair(target, propertyData->notifyIndex()), i);
+    }
+
+    if (bindingForSignal.isEmpty())
+        return bindings;
+
+    enum VisitState : quint8 { Unvisited, Visiting, Visited };
+    QVector<quint8> state(bindings.size(), Unvisited);
+    QVector<QQmlAbstractBinding::Ptr> sorted;
+    sorted.reserve(bindings.size());
+
+    // Depth first, without recursion, as chains can be long
+    QVarLengthArray<QPair<int, QQmlJavaScriptExpressionGuard *>, 16> stack;
+    for (int root = 0; root < bindings.size(); ++root) {
+        if (state[root] != Unvisited)
+            continue;
+        state[root] = Visiting;
+        stack.append(qMakePair(root, bindingAt(root)->activeGuards.first()));
+        while (!stack.isEmpty()) {
+            const int index = stack.last().first;
+            QQmlJavaScriptExpressionGuard *guard = stack.last().second;
+            if (!guard) {
+                state[index] = Visited;
+                sorted.append(bindings.at(index));
+                stack.removeLast();
+                continue;
+            }
+            stack.last().second = bindingAt(index)->activeGuards.next(guard);
+
+            // The guard's sender is a QQmlNotifier, not a QObject
+            if (guard->signalIndex() == -1)
+                continue;
+            const auto dependency = bindingForSignal.constFind(
+                        qMakePair(guard->senderAsObject(), guard->signalIndex()));
+            if (dependency == bindingForSignal.constEnd() || state[*dependency] != Unvisited)
+                continue;
+            state[*dependency] = Visiting;
+            stack.append(qMakePair(*dependency, bindingAt(*dependency)->activeGuards.first()));
+        }
+    }
+    return sorted;
+}
+
 void QQmlBinding::refresh()
 {
     update();
@@ -822,6 +1025,21 @@ private:
     }
 };
 
+// One slot fits all the bindings newBinding() creates. Translation bindings
+// are larger and come from the heap.
+using QQmlBindingAllocator = QRecyclePoolAllocator<sizeof(QObjectPointerBinding), 256>;
+static_assert(sizeof(GenericBinding<QMetaType::UnknownType>) <= sizeof(QObjectPointerBinding));
+
+void *QQmlBinding::operator new(size_t size)
+{
+    return QQmlBindingAllocator::allocate(size);
+}
+
+void QQmlBinding::operator delete(void *ptr, size_t size)
+{
+    QQmlBindingAllocator::deallocate(ptr, size);
+}
+
 QQmlBinding *QQmlBinding::newBinding(const QQmlPropertyData *property)
 {
     return newBinding(property ? property->propType() : QMetaType());
@@ -33,6 +33,7 @@ class Q_QML_PRIVATE_EXPORT QQmlBinding : public QQmlJavaScriptExpression,
                                          public QQmlAbstractBinding
 {
     friend class QQmlAbstractBinding;
+    friend class QQmlEnginePrivate;
 public:
     typedef QExplicitlySharedDataPointer<QQmlBinding> Ptr;
 
@@ -66,6 +67,9 @@ public:
 
     ~QQmlBinding() override;
 
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
     bool mustCaptureBindableProperty() const final {return true;}
     void refresh() override;
 
@@ -127,6 +131,10 @@ private:
 
     QQmlSourceLocation *m_sourceLocation = nullptr; // used for Qt.binding() created functions
     QV4::PersistentValue m_boundFunction; // used for Qt.binding() that are created from a bound function object
+    // Used by QQmlEnginePrivate for deferred updates
+    bool m_updateQueued = false;
+    static QVector<QQmlAbstractBinding::Ptr> sortedByDependencies(
+            const QVector<QQmlAbstractBinding::Ptr> &bindings);
     void handleWriteError(const void *result, QMetaType resultType, QMetaType metaType);
 };
 
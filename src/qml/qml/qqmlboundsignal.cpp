@@ -13,6 +13,7 @@
 #include "qqmlinfo.h"
 
 #include <private/qjsvalue_p.h>
+#include <private/qrecyclepool_p.h>
 #include <private/qv4value_p.h>
 #include <private/qv4jscall_p.h>
 #include <private/qv4qobjectwrapper_p.h>
@@ -130,6 +131,19 @@ QQmlBoundSignalExpression::~QQmlBoundSignalExpression()
 {
 }
 
+using QQmlBoundSignalExpressionAllocator
+        = QRecyclePoolAllocator<sizeof(QQmlBoundSignalExpression), 256>;
+
+void *QQmlBoundSignalExpression::operator new(size_t size)
+{
+    return QQmlBoundSignalExpressionAllocator::allocate(size);
+}
+
+void QQmlBoundSignalExpression::operator delete(void *ptr, size_t size)
+{
+    QQmlBoundSignalExpressionAllocator::deallocate(ptr, size);
+}
+
 QString QQmlBoundSignalExpression::expressionIdentifier() const
 {
     QQmlSourceLocation loc = sourceLocation();
@@ -228,6 +242,18 @@ QQmlBoundSignal::~QQmlBoundSignal()
     removeFromObject();
 }
 
+using QQmlBoundSignalAllocator = QRecyclePoolAllocator<sizeof(QQmlBoundSignal), 256>;
+
+void *QQmlBoundSignal::operator new(size_t size)
+{
+    return QQmlBoundSignalAllocator::allocate(size);
+}
+
+void QQmlBoundSignal::operator delete(void *ptr, size_t size)
+{
+    QQmlBoundSignalAllocator::deallocate(ptr, size);
+}
+
 void QQmlBoundSignal::addToObject(QObject *obj)
 {
     Q_ASSERT(!m_prevSignal);
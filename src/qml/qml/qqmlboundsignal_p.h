@@ -48,6 +48,9 @@ public:
     QString expression() const;
     const QObject *target() const { return m_target; }
 
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
 private:
     ~QQmlBoundSignalExpression() override;
 
@@ -65,6 +68,9 @@ public:
     QQmlBoundSignal(QObject *target, int signal, QObject *owner, QQmlEngine *engine);
     ~QQmlBoundSignal();
 
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
     void removeFromObject();
 
     QQmlBoundSignalExpression *expression() const;
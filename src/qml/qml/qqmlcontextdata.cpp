@@ -7,6 +7,7 @@
 #include <QtQml/private/qqmlcomponentattached_p.h>
 #include <QtQml/private/qqmljavascriptexpression_p.h>
 #include <QtQml/private/qqmlguardedcontextdata_p.h>
+#include <QtQml/private/qrecyclepool_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -131,6 +132,20 @@ void QQmlContextData::clearContext()
     m_expressions = nullptr;
 }
 
+// Every component instance has at least one context. They are recycled
+// rather than allocated one by one.
+using QQmlContextDataAllocator = QRecyclePoolAllocator<sizeof(QQmlContextData), 256>;
+
+void *QQmlContextData::operator new(size_t size)
+{
+    return QQmlContextDataAllocator::allocate(size);
+}
+
+void QQmlContextData::operator delete(void *ptr, size_t size)
+{
+    QQmlContextDataAllocator::deallocate(ptr, size);
+}
+
 QQmlContextData::~QQmlContextData()
 {
     Q_ASSERT(refCount() == 0);
@@ -184,8 +199,11 @@ void QQmlContextData::refreshExpressionsRecursive(QQmlJavaScriptExpression *expr
     if (expression->m_nextExpression)
         refreshExpressionsRecursive(expression->m_nextExpression);
 
-    if (!w.wasDeleted())
+    if (!w.wasDeleted()) {
+        // Names may resolve to different objects now
+        expression->resetDependenciesSettled();
         expression->refresh();
+    }
 }
 
 void QQmlContextData::refreshExpressionsRecursive(bool isGlobal)
@@ -48,6 +48,9 @@ public:
         return QQmlRefPointer<QQmlContextData>(new QQmlContextData(OwnedByParent, nullptr, parent));
     }
 
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
     void addref() const { ++m_refCount; }
     void release() const { if (--m_refCount == 0) delete this; }
     int count() const { return m_refCount; }
@@ -457,6 +457,10 @@ void QQmlEnginePrivate::init()
     q->handle()->setQmlEngine(q);
 
     rootContext = new QQmlContext(q,true);
+
+    static const bool deferredBindingUpdates
+            = qEnvironmentVariableIntValue("QML_DEFERRED_BINDING_UPDATES") > 0;
+    deferBindingUpdates = deferredBindingUpdates;
 }
 
 /*!
@@ -536,6 +540,8 @@ QQmlEngine::~QQmlEngine()
     // XXX TODO: performance -- store list of singleton types separately?
     d->singletonInstances.clear();
 
+    d->clearBindingUpdates();
+
     delete d->rootContext;
     d->rootContext = nullptr;
 
@@ -21,6 +21,7 @@
 #include <private/qintrusivelist_p.h>
 #include <private/qjsengine_p.h>
 #include <private/qjsvalue_p.h>
+#include <private/qqmlabstractbinding_p.h>
 #include <private/qpodvector_p.h>
 #include <private/qqmldirparser_p.h>
 #include <private/qqmlimport_p.h>
@@ -49,6 +50,7 @@
 QT_BEGIN_NAMESPACE
 
 class QNetworkAccessManager;
+class QQmlBinding;
 class QQmlDelayedError;
 class QQmlIncubator;
 class QQmlMetaObject;
@@ -169,6 +171,20 @@ public:
     QQmlIncubationController *incubationController = nullptr;
     void incubate(QQmlIncubator &, const QQmlRefPointer<QQmlContextData> &);
 
+    // Deferred binding updates (QML_DEFERRED_BINDING_UPDATES). Bindings whose
+    // dependencies changed are queued, and evaluated once per flush in the
+    // order of the dependencies they captured.
+    bool deferBindingUpdates = false;
+    bool flushingBindingUpdates = false;
+    quint16 bindingUpdatePass = 0;
+    quint64 avoidedBindingEvaluations = 0;
+    QVector<QQmlAbstractBinding::Ptr> queuedBindingUpdates;
+    QQmlEnginePrivate *nextWithBindingUpdates = nullptr;
+    void queueBindingUpdate(QQmlBinding *binding);
+    void flushBindingUpdates();
+    void clearBindingUpdates();
+    static void flushBindingUpdatesForCurrentThread();
+
     // These methods may be called from any thread
     QString offlineStorageDatabaseDirectory() const;
 
@@ -113,6 +113,12 @@ void QQmlJavaScriptExpression::resetNotifyOnValueChanged()
     setNotifyOnValueChanged(false);
 }
 
+void QQmlJavaScriptExpression::resetDependenciesSettled()
+{
+    if (dependenciesSettled())
+        activeGuards.setTag(NotifyOnValueChanged);
+}
+
 QQmlSourceLocation QQmlJavaScriptExpression::sourceLocation() const
 {
     if (m_v4Function)
@@ -131,6 +137,7 @@ void QQmlJavaScriptExpression::setContext(const QQmlRefPointer<QQmlContextData>
     }
 
     m_context = context.data();
+    resetDependenciesSettled();
 
     if (context)
         context->addExpression(this);
@@ -167,14 +174,18 @@ public:
         Q_ASSERT(expression->notifyOnValueChanged() || expression->activeGuards.isEmpty());
 
         lastPropertyCapture = ep->propertyCapture;
-        ep->propertyCapture = expression->notifyOnValueChanged() ? &capture : nullptr;
+        capturing = expression->notifyOnValueChanged()
+                && !(expression->dependenciesSettled() && !expression->hasUnresolvedNames());
+        ep->propertyCapture = capturing ? &capture : nullptr;
 
-        if (expression->notifyOnValueChanged())
+        if (capturing)
             capture.guards.copyAndClearPrepend(expression->activeGuards);
     }
 
     ~QQmlJavaScriptExpressionCapture()
     {
+        const bool settled = !capture.errorString && isSettledAfterCapture();
+
         if (capture.errorString) {
             for (int ii = 0; ii < capture.errorString->count(); ++ii)
                 qWarning("%s", qPrintable(capture.errorString->at(ii)));
@@ -185,6 +196,9 @@ public:
         while (QQmlJavaScriptExpressionGuard *g = capture.guards.takeFirst())
             g->Delete();
 
+        if (settled)
+            capture.expression->activeGuards.setTag(QQmlJavaScriptExpression::DependenciesSettled);
+
         ep->propertyCapture = lastPropertyCapture;
     }
 
@@ -204,10 +218,23 @@ public:
     }
 
 private:
+    // Once a function with static dependencies has been evaluated without
+    // errors, its guards cover everything it can read.
+    bool isSettledAfterCapture() const
+    {
+        if (!capturing || watcher.wasDeleted())
+            return false;
+        const QQmlJavaScriptExpression *expression = capture.expression;
+        const QV4::Function *function = expression->function();
+        return function && function->hasStaticDependencies()
+                && !expression->hasError() && !expression->hasUnresolvedNames();
+    }
+
     QQmlJavaScriptExpression::DeleteWatcher watcher;
     QQmlPropertyCapture capture;
     QQmlEnginePrivate *ep;
     QQmlPropertyCapture *lastPropertyCapture;
+    bool capturing = false;
 };
 
 QV4::ReturnedValue QQmlJavaScriptExpression::evaluate(QV4::CallData *callData, bool *isUndefined)
@@ -501,6 +528,7 @@ void QQmlJavaScriptExpression::setupFunction(QV4::ExecutionContext *qmlContext,
     m_qmlScope.set(qmlContext->engine(), *qmlContext);
     m_v4Function = f;
     m_compilationUnit.reset(m_v4Function->executableCompilationUnit());
+    resetDependenciesSettled();
 }
 
 void QQmlJavaScriptExpression::setCompilationUnit(const QQmlRefPointer<QV4::ExecutableCompilationUnit> &compilationUnit)
@@ -538,12 +566,21 @@ void QQmlJavaScriptExpression::clearActiveGuards()
 {
     while (QQmlJavaScriptExpressionGuard *g = activeGuards.takeFirst())
         g->Delete();
+    resetDependenciesSettled();
 }
 
 void QQmlJavaScriptExpressionGuard_callback(QQmlNotifierEndpoint *e, void **)
 {
-    QQmlJavaScriptExpression *expression =
-        static_cast<QQmlJavaScriptExpressionGuard *>(e)->expression;
+    QQmlJavaScriptExpressionGuard *guard = static_cast<QQmlJavaScriptExpressionGuard *>(e);
+    QQmlJavaScriptExpression *expression = guard->expression;
+
+    // Ids and context properties can be replaced by other objects. Their
+    // members have to be captured again on the next evaluation.
+    if (expression->dependenciesSettled()
+            && (guard->signalIndex() == -1
+                || qobject_cast<QQmlContext *>(guard->senderAsObject()))) {
+        expression->resetDependenciesSettled();
+    }
 
     expression->expressionChanged();
 }
@@ -123,6 +123,8 @@ public:
     QQmlError error(QQmlEngine *) const;
     void clearError();
     void clearActiveGuards();
+    bool dependenciesSettled() const { return activeGuards.tag() == DependenciesSettled; }
+    void resetDependenciesSettled();
     QQmlDelayedError *delayedError();
     virtual bool mustCaptureBindableProperty() const {return true;}
 
@@ -142,13 +144,15 @@ protected:
     void setCompilationUnit(const QQmlRefPointer<QV4::ExecutableCompilationUnit> &compilationUnit);
 
     // We store some flag bits in the following flag pointers.
-    //    activeGuards:flag1  - notifyOnValueChanged
-    //    activeGuards:flag2  - useSharedContext
+    //    activeGuards:tag  - notifyOnValueChanged, dependencies settled
     QBiPointer<QObject, DeleteWatcher> m_scopeObject;
 
     enum GuardTag {
         NoGuardTag,
-        NotifyOnValueChanged
+        NotifyOnValueChanged,
+        // The active guards hold all dependencies of a function compiled with
+        // static dependencies. They are kept as they are on re-evaluation.
+        DependenciesSettled
     };
 
     QForwardFieldList<QQmlJavaScriptExpressionGuard, &QQmlJavaScriptExpressionGuard::next, GuardTag> activeGuards;
@@ -237,7 +241,7 @@ bool QQmlJavaScriptExpression::DeleteWatcher::wasDeleted() const
 
 bool QQmlJavaScriptExpression::notifyOnValueChanged() const
 {
-    return activeGuards.tag() == NotifyOnValueChanged;
+    return activeGuards.tag() != NoGuardTag;
 }
 
 QObject *QQmlJavaScriptExpression::scopeObject() const
@@ -250,6 +254,7 @@ void QQmlJavaScriptExpression::setScopeObject(QObject *v)
 {
     if (m_scopeObject.isT1()) m_scopeObject = v;
     else m_scopeObject.asT2()->_c = v;
+    resetDependenciesSettled();
 }
 
 bool QQmlJavaScriptExpression::hasError() const
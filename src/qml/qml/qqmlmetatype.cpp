@@ -13,6 +13,7 @@
 
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qreadwritelock.h>
 #include <QtCore/qloggingcategory.h>
 
 Q_DECLARE_LOGGING_CATEGORY(DBG_DISK_CACHE)
@@ -49,11 +50,17 @@ CompositeMetaTypeIds::~CompositeMetaTypeIds()
 struct LockedData : private QQmlMetaTypeData
 {
     friend class QQmlMetaTypeDataPtr;
+    friend class QQmlMetaTypeLookupPtr;
 };
 
 Q_GLOBAL_STATIC(LockedData, metaTypeData)
 Q_GLOBAL_STATIC(QRecursiveMutex, metaTypeDataLock)
 
+// Guards the type lookup tables (idToType, nameToType, urlToType, urlToNonFileImportType and
+// metaObjectToType). Anything modifying them has to hold both metaTypeDataLock and this lock
+// for writing, so that the hot lookups can run concurrently under the read lock alone.
+Q_GLOBAL_STATIC(QReadWriteLock, metaTypeLookupLock)
+
 struct ModuleUri : public QString
 {
     ModuleUri(const QString &string) : QString(string) {}
@@ -82,6 +89,38 @@ private:
     LockedData *data = nullptr;
 };
 
+// Read-only access to the type lookup tables. This does not take metaTypeDataLock, so lookups
+// by name, URL, meta object and meta type don't serialize on each other or on unrelated users of
+// QQmlMetaTypeDataPtr. Only the lookup tables may be accessed through it, and nothing that could
+// take metaTypeDataLock may be called while it is alive.
+class QQmlMetaTypeLookupPtr
+{
+    Q_DISABLE_COPY_MOVE(QQmlMetaTypeLookupPtr)
+public:
+    QQmlMetaTypeLookupPtr() : locker(metaTypeLookupLock()), data(metaTypeData()) {}
+    ~QQmlMetaTypeLookupPtr() = default;
+
+    const QQmlMetaTypeData &operator*() const { return *data; }
+    const QQmlMetaTypeData *operator->() const { return data; }
+
+    bool isValid() const { return data != nullptr; }
+
+private:
+    QReadLocker locker;
+    const LockedData *data = nullptr;
+};
+
+// Modification of the type lookup tables. The caller must hold a QQmlMetaTypeDataPtr.
+class QQmlMetaTypeLookupWriteLocker
+{
+    Q_DISABLE_COPY_MOVE(QQmlMetaTypeLookupWriteLocker)
+public:
+    QQmlMetaTypeLookupWriteLocker() : locker(metaTypeLookupLock()) {}
+
+private:
+    QWriteLocker locker;
+};
+
 static QQmlTypePrivate *createQQmlType(QQmlMetaTypeData *data,
                                        const QQmlPrivate::RegisterInterface &type)
 {
@@ -308,14 +347,18 @@ void QQmlMetaType::clearTypeRegistrations()
     //Only cleans global static, assumed no running engine
     QQmlMetaTypeDataPtr data;
 
+    {
+        QQmlMetaTypeLookupWriteLocker lookupLocker;
+        data->idToType.clear();
+        data->nameToType.clear();
+        data->urlToType.clear();
+        data->urlToNonFileImportType.clear();
+        data->metaObjectToType.clear();
+    }
+
     data->uriToModule.clear();
     data->types.clear();
-    data->idToType.clear();
-    data->nameToType.clear();
-    data->urlToType.clear();
     data->typePropertyCaches.clear();
-    data->urlToNonFileImportType.clear();
-    data->metaObjectToType.clear();
     data->undeletableTypes.clear();
 }
 
@@ -346,9 +389,11 @@ QQmlType QQmlMetaType::registerInterface(const QQmlPrivate::RegisterInterface &t
     QQmlTypePrivate *priv = createQQmlType(data, type);
     Q_ASSERT(priv);
 
-
-    data->idToType.insert(priv->typeId.id(), priv);
-    data->idToType.insert(priv->listId.id(), priv);
+    {
+        QQmlMetaTypeLookupWriteLocker lookupLocker;
+        data->idToType.insert(priv->typeId.id(), priv);
+        data->idToType.insert(priv->listId.id(), priv);
+    }
 
     data->interfaces.insert(type.typeId.id());
 
@@ -437,21 +482,25 @@ static void addTypeToData(QQmlTypePrivate *type, QQmlMetaTypeData *data)
 {
     Q_ASSERT(type);
 
-    if (!type->elementName.isEmpty())
-        data->nameToType.insert(type->elementName, type);
+    {
+        QQmlMetaTypeLookupWriteLocker lookupLocker;
 
-    if (type->baseMetaObject)
-        data->metaObjectToType.insert(type->baseMetaObject, type);
+        if (!type->elementName.isEmpty())
+            data->nameToType.insert(type->elementName, type);
 
-    if (type->regType == QQmlType::SequentialContainerType) {
-        if (type->listId.isValid())
-            data->idToType.insert(type->listId.id(), type);
-    } else {
-        if (type->typeId.isValid())
-            data->idToType.insert(type->typeId.id(), type);
+        if (type->baseMetaObject)
+            data->metaObjectToType.insert(type->baseMetaObject, type);
 
-        if (type->listId.flags().testFlag(QMetaType::IsQmlList))
-            data->idToType.insert(type->listId.id(), type);
+        if (type->regType == QQmlType::SequentialContainerType) {
+            if (type->listId.isValid())
+                data->idToType.insert(type->listId.id(), type);
+        } else {
+            if (type->typeId.isValid())
+                data->idToType.insert(type->typeId.id(), type);
+
+            if (type->listId.flags().testFlag(QMetaType::IsQmlList))
+                data->idToType.insert(type->listId.id(), type);
+        }
     }
 
     if (!type->module.isEmpty()) {
@@ -522,8 +571,10 @@ QQmlType QQmlMetaType::registerCompositeSingletonType(const QQmlPrivate::Registe
     QQmlTypePrivate *priv = createQQmlType(data, typeName, type);
     addTypeToData(priv, data);
 
+    const QUrl url = QQmlTypeLoader::normalize(type.url);
     QQmlMetaTypeData::Files *files = fileImport ? &(data->urlToType) : &(data->urlToNonFileImportType);
-    files->insert(QQmlTypeLoader::normalize(type.url), priv);
+    QQmlMetaTypeLookupWriteLocker lookupLocker;
+    files->insert(url, priv);
 
     return QQmlType(priv);
 }
@@ -548,8 +599,10 @@ QQmlType QQmlMetaType::registerCompositeType(const QQmlPrivate::RegisterComposit
     QQmlTypePrivate *priv = createQQmlType(data, typeName, type);
     addTypeToData(priv, data);
 
+    const QUrl url = QQmlTypeLoader::normalize(type.url);
     QQmlMetaTypeData::Files *files = fileImport ? &(data->urlToType) : &(data->urlToNonFileImportType);
-    files->insert(QQmlTypeLoader::normalize(type.url), priv);
+    QQmlMetaTypeLookupWriteLocker lookupLocker;
+    files->insert(url, priv);
 
     return QQmlType(priv);
 }
@@ -927,7 +980,10 @@ QQmlType QQmlMetaType::typeForUrl(const QString &urlString,
 
         data->registerType(priv);
         addTypeToData(priv, data);
-        data->urlToType.insert(url, priv);
+        {
+            QQmlMetaTypeLookupWriteLocker lookupLocker;
+            data->urlToType.insert(url, priv);
+        }
         return QQmlType(priv);
     }
 
@@ -1172,7 +1228,7 @@ QQmlType QQmlMetaType::qmlType(const QString &qualifiedName, QTypeRevision versi
 QQmlType QQmlMetaType::qmlType(const QHashedStringRef &name, const QHashedStringRef &module,
                                QTypeRevision version)
 {
-    const QQmlMetaTypeDataPtr data;
+    const QQmlMetaTypeLookupPtr data;
 
     const QHashedString key(QString::fromRawData(name.constData(), name.length()), name.hash());
     QQmlMetaTypeData::Names::ConstIterator it = data->nameToType.constFind(key);
@@ -1192,7 +1248,7 @@ QQmlType QQmlMetaType::qmlType(const QHashedStringRef &name, const QHashedString
 */
 QQmlType QQmlMetaType::qmlType(const QMetaObject *metaObject)
 {
-    const QQmlMetaTypeDataPtr data;
+    const QQmlMetaTypeLookupPtr data;
     return QQmlType(data->metaObjectToType.value(metaObject));
 }
 
@@ -1204,7 +1260,7 @@ QQmlType QQmlMetaType::qmlType(const QMetaObject *metaObject)
 QQmlType QQmlMetaType::qmlType(const QMetaObject *metaObject, const QHashedStringRef &module,
                                QTypeRevision version)
 {
-    const QQmlMetaTypeDataPtr data;
+    const QQmlMetaTypeLookupPtr data;
 
     const auto range = data->metaObjectToType.equal_range(metaObject);
     for (auto it = range.first; it != range.second; ++it) {
@@ -1235,14 +1291,14 @@ QQmlType QQmlMetaType::qmlTypeById(int qmlTypeId)
 */
 QQmlType QQmlMetaType::qmlType(QMetaType metaType)
 {
-    const QQmlMetaTypeDataPtr data;
+    const QQmlMetaTypeLookupPtr data;
     QQmlTypePrivate *type = data->idToType.value(metaType.id());
     return (type && type->typeId == metaType) ? QQmlType(type) : QQmlType();
 }
 
 QQmlType QQmlMetaType::qmlListType(QMetaType metaType)
 {
-    const QQmlMetaTypeDataPtr data;
+    const QQmlMetaTypeLookupPtr data;
     QQmlTypePrivate *type = data->idToType.value(metaType.id());
     return (type && type->listId == metaType) ? QQmlType(type) : QQmlType();
 }
@@ -1256,11 +1312,14 @@ QQmlType QQmlMetaType::qmlListType(QMetaType metaType)
 QQmlType QQmlMetaType::qmlType(const QUrl &unNormalizedUrl, bool includeNonFileImports /* = false */)
 {
     const QUrl url = QQmlTypeLoader::normalize(unNormalizedUrl);
-    const QQmlMetaTypeDataPtr data;
 
-    QQmlType type(data->urlToType.value(url));
-    if (!type.isValid() && includeNonFileImports)
-        type = QQmlType(data->urlToNonFileImportType.value(url));
+    QQmlType type;
+    {
+        const QQmlMetaTypeLookupPtr data;
+        type = QQmlType(data->urlToType.value(url));
+        if (!type.isValid() && includeNonFileImports)
+            type = QQmlType(data->urlToNonFileImportType.value(url));
+    }
 
     if (type.sourceUrl() == url)
         return type;
@@ -1395,11 +1454,14 @@ void QQmlMetaType::unregisterType(int typeIndex)
     QQmlMetaTypeDataPtr data;
     const QQmlType type = data->types.value(typeIndex);
     if (const QQmlTypePrivate *d = type.priv()) {
-        removeQQmlTypePrivate(data->idToType, d);
-        removeQQmlTypePrivate(data->nameToType, d);
-        removeQQmlTypePrivate(data->urlToType, d);
-        removeQQmlTypePrivate(data->urlToNonFileImportType, d);
-        removeQQmlTypePrivate(data->metaObjectToType, d);
+        {
+            QQmlMetaTypeLookupWriteLocker lookupLocker;
+            removeQQmlTypePrivate(data->idToType, d);
+            removeQQmlTypePrivate(data->nameToType, d);
+            removeQQmlTypePrivate(data->urlToType, d);
+            removeQQmlTypePrivate(data->urlToNonFileImportType, d);
+            removeQQmlTypePrivate(data->metaObjectToType, d);
+        }
         for (auto & module : data->uriToModule)
             module->remove(d);
         data->clearPropertyCachesForVersion(typeIndex);
@@ -1413,6 +1475,7 @@ void QQmlMetaType::registerMetaObjectForType(const QMetaObject *metaobject, QQml
     Q_ASSERT(type);
 
     QQmlMetaTypeDataPtr data;
+    QQmlMetaTypeLookupWriteLocker lookupLocker;
     data->metaObjectToType.insert(metaobject, type);
 }
 
@@ -1434,44 +1497,56 @@ void QQmlMetaType::freeUnusedTypesAndCaches()
     if (!data.isValid())
         return;
 
+    // Lookups holding only the read lock can take a new reference to anything that is still in
+    // the lookup tables. Test the reference counts and remove the entries under the write lock,
+    // so that nothing gets resurrected in between. The last references are dropped only after
+    // the lock is released, so no destructor runs while it is held.
     bool deletedAtLeastOneType;
     do {
-        deletedAtLeastOneType = false;
-        QList<QQmlType>::Iterator it = data->types.begin();
-        while (it != data->types.end()) {
-            const QQmlTypePrivate *d = (*it).priv();
-            if (d && d->count() == 1 && !hasActiveInlineComponents(d)) {
-                deletedAtLeastOneType = true;
+        QList<QQmlType> unusedTypes;
+        {
+            QQmlMetaTypeLookupWriteLocker lookupLocker;
+            for (QQmlType &type : data->types) {
+                const QQmlTypePrivate *d = type.priv();
+                if (!d || d->count() != 1 || hasActiveInlineComponents(d))
+                    continue;
 
                 removeQQmlTypePrivate(data->idToType, d);
                 removeQQmlTypePrivate(data->nameToType, d);
                 removeQQmlTypePrivate(data->urlToType, d);
                 removeQQmlTypePrivate(data->urlToNonFileImportType, d);
                 removeQQmlTypePrivate(data->metaObjectToType, d);
+                unusedTypes.append(std::exchange(type, QQmlType()));
+            }
+        }
 
-                for (auto &module : data->uriToModule)
-                    module->remove(d);
+        for (const QQmlType &type : qAsConst(unusedTypes)) {
+            const QQmlTypePrivate *d = type.priv();
+            for (auto &module : data->uriToModule)
+                module->remove(d);
 
-                data->clearPropertyCachesForVersion(d->index);
-                *it = QQmlType();
-            } else {
-                ++it;
-            }
+            data->clearPropertyCachesForVersion(d->index);
         }
+
+        deletedAtLeastOneType = !unusedTypes.isEmpty();
     } while (deletedAtLeastOneType);
 
     bool deletedAtLeastOneCache;
     do {
-        deletedAtLeastOneCache = false;
-        auto it = data->propertyCaches.begin();
-        while (it != data->propertyCaches.end()) {
-            if ((*it)->count() == 1) {
-                it = data->propertyCaches.erase(it);
-                deletedAtLeastOneCache = true;
-            } else {
-                ++it;
+        QList<QQmlPropertyCache::ConstPtr> unusedCaches;
+        {
+            QQmlMetaTypeLookupWriteLocker lookupLocker;
+            auto it = data->propertyCaches.begin();
+            while (it != data->propertyCaches.end()) {
+                if ((*it)->count() == 1) {
+                    unusedCaches.append(std::move(*it));
+                    it = data->propertyCaches.erase(it);
+                } else {
+                    ++it;
+                }
             }
         }
+        deletedAtLeastOneCache = !unusedCaches.isEmpty();
     } while (deletedAtLeastOneCache);
 }
 
@@ -281,6 +281,241 @@ void QQmlObjectCreator::finalizePopulateDeferred()
     phase = ObjectsCreated;
 }
 
+namespace {
+// How literals are converted for properties of a given type
+enum class LiteralConversion {
+    Direct,     // cheap, converted for every instance
+    Replayed,   // converted on the first instantiation, and replayed for further instances
+    Prepared    // like Replayed, but can also be converted ahead by the type loader
+};
+}
+
+static LiteralConversion literalConversion(QMetaType type)
+{
+    switch (type.id()) {
+    case QMetaType::QUrl:
+#if QT_CONFIG(datestring)
+    case QMetaType::QDate:
+    case QMetaType::QTime:
+    case QMetaType::QDateTime:
+#endif
+    case QMetaType::QPoint:
+    case QMetaType::QPointF:
+    case QMetaType::QSize:
+    case QMetaType::QSizeF:
+    case QMetaType::QRect:
+    case QMetaType::QRectF:
+        return LiteralConversion::Prepared;
+    case QMetaType::QVariant:
+    case QMetaType::QString:
+    case QMetaType::QStringList:
+    case QMetaType::QByteArray:
+    case QMetaType::UInt:
+    case QMetaType::Int:
+    case QMetaType::Float:
+    case QMetaType::Double:
+    case QMetaType::Bool:
+        return LiteralConversion::Direct;
+    default:
+        // Colors, vectors and other value types go through QQmlValueTypeProvider.
+        // The cheap lists and QJSValue are not worth remembering.
+        if (type == QMetaType::fromType<QList<qreal>>()
+                || type == QMetaType::fromType<QList<int>>()
+                || type == QMetaType::fromType<QList<bool>>()
+                || type == QMetaType::fromType<QList<QString>>()
+                || type == QMetaType::fromType<QJSValue>()) {
+            return LiteralConversion::Direct;
+        }
+        return LiteralConversion::Replayed;
+    }
+}
+
+/*
+    Returns the slot in the compilation unit's creation plan holding the
+    converted value of the literal \a binding of the current object, or
+    nullptr if the binding is not part of the object's binding table (the
+    synthesized id binding).
+ */
+QVariant *QQmlObjectCreator::convertedLiteralSlot(const QV4::CompiledData::Binding *binding)
+{
+    const QV4::CompiledData::Binding *table = _compiledObject->bindingTable();
+    if (binding < table || binding >= table + _compiledObject->nBindings)
+        return nullptr;
+
+    QVector<QVector<QVariant>> &plan = compilationUnit->convertedLiteralsPerObject;
+    if (plan.isEmpty())
+        plan.resize(compilationUnit->objectCount());
+    QVector<QVariant> &literals = plan[_compiledObjectIndex];
+    if (literals.isEmpty())
+        literals.resize(_compiledObject->nBindings);
+    return &literals[binding - table];
+}
+
+/*
+    Converts the literal \a binding for a property of \a type, which
+    literalConversion() does not list as Direct. The result depends neither on
+    the engine nor on the object being created. Returns an invalid QVariant if
+    the literal cannot be converted.
+ */
+static QVariant convertLiteral(
+        QV4::ExecutableCompilationUnit *compilationUnit, QMetaType type,
+        const QV4::CompiledData::Binding *binding)
+{
+    Q_ASSERT(literalConversion(type) != LiteralConversion::Direct);
+
+    // Apart from generic value types, all of them are parsed from strings
+    bool parsed = true;
+    bool ok = binding->type() == QV4::CompiledData::Binding::Type_String;
+    auto string = [&]() { return compilationUnit->bindingValueAsString(binding); };
+
+    QVariant value;
+    switch (type.id()) {
+    case QMetaType::QUrl:
+        if (ok) {
+            const QString url = string();
+            value = (!url.isEmpty() && QQmlPropertyPrivate::resolveUrlsOnAssignment())
+                    ? compilationUnit->finalUrl().resolved(QUrl(url))
+                    : QUrl(url);
+        }
+        break;
+    case QMetaType::QColor:
+    case QMetaType::QVector2D:
+    case QMetaType::QVector3D:
+    case QMetaType::QVector4D:
+    case QMetaType::QQuaternion:
+        value = QVariant(type);
+        ok = ok && QQmlValueTypeProvider::createValueType(string(), type, value.data());
+        break;
+#if QT_CONFIG(datestring)
+    case QMetaType::QDate:
+        if (ok)
+            value = QQmlStringConverters::dateFromString(string(), &ok);
+        break;
+    case QMetaType::QTime:
+        if (ok)
+            value = QQmlStringConverters::timeFromString(string(), &ok);
+        break;
+    case QMetaType::QDateTime:
+        if (ok)
+            value = QQmlStringConverters::dateTimeFromString(string(), &ok);
+        break;
+#endif
+    case QMetaType::QPoint:
+        if (ok)
+            value = QQmlStringConverters::pointFFromString(string(), &ok).toPoint();
+        break;
+    case QMetaType::QPointF:
+        if (ok)
+            value = QQmlStringConverters::pointFFromString(string(), &ok);
+        break;
+    case QMetaType::QSize:
+        if (ok)
+            value = QQmlStringConverters::sizeFFromString(string(), &ok).toSize();
+        break;
+    case QMetaType::QSizeF:
+        if (ok)
+            value = QQmlStringConverters::sizeFFromString(string(), &ok);
+        break;
+    case QMetaType::QRect:
+        if (ok)
+            value = QQmlStringConverters::rectFFromString(string(), &ok).toRect();
+        break;
+    case QMetaType::QRectF:
+        if (ok)
+            value = QQmlStringConverters::rectFFromString(string(), &ok);
+        break;
+    default:
+        // generate single literal value assignment to a list property if required
+        if (type == QMetaType::fromType<QList<QUrl>>()) {
+            if (ok) {
+                const QUrl url(string());
+                value = QVariant::fromValue(QList<QUrl> {
+                    QQmlPropertyPrivate::resolveUrlsOnAssignment()
+                            ? compilationUnit->finalUrl().resolved(url)
+                            : url
+                });
+            }
+            break;
+        }
+
+        QVariant source;
+        switch (binding->type()) {
+        case QV4::CompiledData::Binding::Type_Boolean:
+            source = binding->valueAsBoolean();
+            break;
+        case QV4::CompiledData::Binding::Type_Number: {
+            const double n = compilationUnit->bindingValueAsNumber(binding);
+            if (double(int(n)) == n)
+                source = int(n);
+            else
+                source = n;
+            break;
+        }
+        case QV4::CompiledData::Binding::Type_Null:
+            source = QVariant::fromValue<std::nullptr_t>(nullptr);
+            break;
+        case QV4::CompiledData::Binding::Type_Invalid:
+            break;
+        default:
+            source = string();
+            break;
+        }
+
+        parsed = false;
+        value = QVariant(type);
+        ok = QQmlValueTypeProvider::createValueType(source, type, value.data());
+        break;
+    }
+
+    if (ok)
+        return value;
+
+    // The type compiler only warns about null for types parsed from strings
+    return (parsed && binding->type() == QV4::CompiledData::Binding::Type_Null)
+            ? QVariant(type)
+            : QVariant();
+}
+
+/*
+    Fills the creation plan of \a compilationUnit with the literals of types
+    that literalConversion() lists as Prepared. The type loader calls this once the unit is
+    compiled, on its own thread when loading asynchronously, so that the
+    conversion is not part of the first instantiation on the engine thread.
+    The unit must not be in use by the engine yet.
+ */
+void QQmlObjectCreator::prepareConvertedLiterals(QV4::ExecutableCompilationUnit *compilationUnit)
+{
+    QVector<QVector<QVariant>> &plan = compilationUnit->convertedLiteralsPerObject;
+    const int objectCount = compilationUnit->objectCount();
+    for (int objectIndex = 0; objectIndex < objectCount; ++objectIndex) {
+        const QV4::CompiledData::Object *object = compilationUnit->objectAt(objectIndex);
+        const QV4::BindingPropertyData &propertyData
+                = compilationUnit->bindingPropertyDataPerObject.at(objectIndex);
+        if (propertyData.size() < int(object->nBindings))
+            continue;
+
+        const QV4::CompiledData::Binding *binding = object->bindingTable();
+        for (quint32 i = 0; i < object->nBindings; ++i, ++binding) {
+            const QQmlPropertyData *property = propertyData.at(i);
+            if (!property || property->isEnum()
+                    || literalConversion(property->propType()) != LiteralConversion::Prepared) {
+                continue;
+            }
+
+            QVariant value = convertLiteral(compilationUnit, property->propType(), binding);
+            if (!value.isValid())
+                continue;
+
+            if (plan.isEmpty())
+                plan.resize(objectCount);
+            QVector<QVariant> &literals = plan[objectIndex];
+            if (literals.isEmpty())
+                literals.resize(object->nBindings);
+            literals[i] = std::move(value);
+        }
+    }
+}
+
 void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const QV4::CompiledData::Binding *binding)
 {
     QQmlPropertyData::WriteFlags propertyWriteFlags = QQmlPropertyData::BypassInterceptor | QQmlPropertyData::RemoveBindingOnAliasWrite;
@@ -323,6 +558,28 @@ void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const
         }
     }
 
+    // Literals that need parsing or resolving are converted once, on the first
+    // instantiation, and the result is replayed for every further instance.
+    if (literalConversion(propertyType) != LiteralConversion::Direct) {
+        QVariant converted;
+        QVariant *value = convertedLiteralSlot(binding);
+        if (!value)
+            value = &converted;
+        if (value->metaType() != propertyType)
+            *value = convertLiteral(compilationUnit, propertyType, binding);
+
+        if (value->isValid()) {
+            property->writeProperty(_qobject, value->data(), propertyWriteFlags);
+        } else {
+            // string converters are not exposed, so ending up here indicates an error
+            QString stringValue = compilationUnit->bindingValueAsString(binding);
+            QMetaProperty metaProperty = _qobject->metaObject()->property(property->coreIndex());
+            recordError(binding->location, tr("Cannot assign value %1 to property"
+" %2").arg(stringValue, QString::fromUtf8(metaProperty.name())));
+        }
+        return;
+    }
+
     switch (propertyType.id()) {
     case QMetaType::QVariant: {
         if (binding->type() == QV4::CompiledData::Binding::Type_Number) {
@@ -387,15 +644,6 @@ void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const
         property->writeProperty(_qobject, &value, propertyWriteFlags);
     }
     break;
-    case QMetaType::QUrl: {
-        assertType(QV4::CompiledData::Binding::Type_String);
-        const QString string = compilationUnit->bindingValueAsString(binding);
-        QUrl value = (!string.isEmpty() && QQmlPropertyPrivate::resolveUrlsOnAssignment())
-                ? compilationUnit->finalUrl().resolved(QUrl(string))
-                : QUrl(string);
-        property->writeProperty(_qobject, &value, propertyWriteFlags);
-    }
-    break;
     case QMetaType::UInt: {
         assertType(QV4::CompiledData::Binding::Type_Number);
         double d = compilationUnit->bindingValueAsNumber(binding);
@@ -424,99 +672,12 @@ void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const
         property->writeProperty(_qobject, &value, propertyWriteFlags);
     }
     break;
-    case QMetaType::QColor: {
-        QVariant data(propertyType);
-        if (QQmlValueTypeProvider::createValueType(
-                    compilationUnit->bindingValueAsString(binding), propertyType, data.data())) {
-            property->writeProperty(_qobject, data.data(), propertyWriteFlags);
-        }
-    }
-    break;
-#if QT_CONFIG(datestring)
-    case QMetaType::QDate: {
-        bool ok = false;
-        QDate value = QQmlStringConverters::dateFromString(compilationUnit->bindingValueAsString(binding), &ok);
-        assertOrNull(ok);
-        property->writeProperty(_qobject, &value, propertyWriteFlags);
-    }
-    break;
-    case QMetaType::QTime: {
-        bool ok = false;
-        QTime value = QQmlStringConverters::timeFromString(compilationUnit->bindingValueAsString(binding), &ok);
-        assertOrNull(ok);
-        property->writeProperty(_qobject, &value, propertyWriteFlags);
-    }
-    break;
-    case QMetaType::QDateTime: {
-        bool ok = false;
-        QDateTime value = QQmlStringConverters::dateTimeFromString(
-                    compilationUnit->bindingValueAsString(binding), &ok);
-        assertOrNull(ok);
-        property->writeProperty(_qobject, &value, propertyWriteFlags);
-    }
-    break;
-#endif // datestring
-    case QMetaType::QPoint: {
-        bool ok = false;
-        QPoint value = QQmlStringConverters::pointFFromString(compilationUnit->bindingValueAsString(binding), &ok).toPoint();
-        assertOrNull(ok);
-        property->writeProperty(_qobject, &value, propertyWriteFlags);
-    }
-    break;
-    case QMetaType::QPointF: {
-        bool ok = false;
-        QPointF value = QQmlStringConverters::pointFFromString(compilationUnit->bindingValueAsString(binding), &ok);
-        assertOrNull(ok);
-        property->writeProperty(_qobject, &value, propertyWriteFlags);
-    }
-    break;
-    case QMetaType::QSize: {
-        bool ok = false;
-        QSize value = QQmlStringConverters::sizeFFromString(compilationUnit->bindingValueAsString(binding), &ok).toSize();
-        assertOrNull(ok);
-        property->writeProperty(_qobject, &value, propertyWriteFlags);
-    }
-    break;
-    case QMetaType::QSizeF: {
-        bool ok = false;
-        QSizeF value = QQmlStringConverters::sizeFFromString(compilationUnit->bindingValueAsString(binding), &ok);
-        assertOrNull(ok);
-        property->writeProperty(_qobject, &value, propertyWriteFlags);
-    }
-    break;
-    case QMetaType::QRect: {
-        bool ok = false;
-        QRect value = QQmlStringConverters::rectFFromString(compilationUnit->bindingValueAsString(binding), &ok).toRect();
-        assertOrNull(ok);
-        property->writeProperty(_qobject, &value, propertyWriteFlags);
-    }
-    break;
-    case QMetaType::QRectF: {
-        bool ok = false;
-        QRectF value = QQmlStringConverters::rectFFromString(compilationUnit->bindingValueAsString(binding), &ok);
-        assertOrNull(ok);
-        property->writeProperty(_qobject, &value, propertyWriteFlags);
-    }
-    break;
     case QMetaType::Bool: {
         assertType(QV4::CompiledData::Binding::Type_Boolean);
         bool value = binding->valueAsBoolean();
         property->writeProperty(_qobject, &value, propertyWriteFlags);
     }
     break;
-    case QMetaType::QVector2D:
-    case QMetaType::QVector3D:
-    case QMetaType::QVector4D:
-    case QMetaType::QQuaternion: {
-        QVariant result(propertyType);
-        bool ok = QQmlValueTypeProvider::createValueType(
-                    compilationUnit->bindingValueAsString(binding),
-                    result.metaType(), result.data());
-        assertOrNull(ok);
-        Q_UNUSED(ok);
-        property->writeProperty(_qobject, result.data(), propertyWriteFlags);
-        break;
-    }
     default: {
         // generate single literal value assignment to a list property if required
         if (propertyType == QMetaType::fromType<QList<qreal>>()) {
@@ -538,23 +699,14 @@ void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const
             value.append(binding->valueAsBoolean());
             property->writeProperty(_qobject, &value, propertyWriteFlags);
             break;
-        } else if (propertyType == QMetaType::fromType<QList<QUrl>>()) {
-            assertType(QV4::CompiledData::Binding::Type_String);
-            const QUrl url(compilationUnit->bindingValueAsString(binding));
-            QList<QUrl> value {
-                QQmlPropertyPrivate::resolveUrlsOnAssignment()
-                        ? compilationUnit->finalUrl().resolved(url)
-                        : url
-            };
-            property->writeProperty(_qobject, &value, propertyWriteFlags);
-            break;
         } else if (propertyType == QMetaType::fromType<QList<QString>>()) {
             assertOrNull(binding->evaluatesToString());
             QList<QString> value;
             value.append(compilationUnit->bindingValueAsString(binding));
             property->writeProperty(_qobject, &value, propertyWriteFlags);
             break;
-        } else if (propertyType == QMetaType::fromType<QJSValue>()) {
+        } else {
+            Q_ASSERT(propertyType == QMetaType::fromType<QJSValue>());
             QJSValue value;
             switch (binding->type()) {
             case QV4::CompiledData::Binding::Type_Boolean:
@@ -576,43 +728,7 @@ void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const
                 break;
             }
             property->writeProperty(_qobject, &value, propertyWriteFlags);
-            break;
-        } else {
-            QVariant source;
-            switch (binding->type()) {
-            case QV4::CompiledData::Binding::Type_Boolean:
-                source = binding->valueAsBoolean();
-                break;
-            case QV4::CompiledData::Binding::Type_Number: {
-                const double n = compilationUnit->bindingValueAsNumber(binding);
-                if (double(int(n)) == n)
-                    source = int(n);
-                else
-                    source = n;
-                break;
-            }
-            case QV4::CompiledData::Binding::Type_Null:
-                source = QVariant::fromValue<std::nullptr_t>(nullptr);
-                break;
-            case QV4::CompiledData::Binding::Type_Invalid:
-                break;
-            default:
-                source = compilationUnit->bindingValueAsString(binding);
-                break;
-            }
-
-            QVariant target(propertyType);
-            if (QQmlValueTypeProvider::createValueType(source, propertyType, target.data())) {
-                property->writeProperty(_qobject, target.data(), propertyWriteFlags);
-                break;
-            }
         }
-
-        // string converters are not exposed, so ending up here indicates an error
-        QString stringValue = compilationUnit->bindingValueAsString(binding);
-        QMetaProperty metaProperty = _qobject->metaObject()->property(property->coreIndex());
-        recordError(binding->location, tr("Cannot assign value %1 to property"
-" %2").arg(stringValue, QString::fromUtf8(metaProperty.name())));
     }
     break;
     }
@@ -121,6 +121,8 @@ public:
                                           int index, QObject *parent,
                                           const QQmlRefPointer<QQmlContextData> &context);
 
+    static void prepareConvertedLiterals(QV4::ExecutableCompilationUnit *compilationUnit);
+
 private:
     QQmlObjectCreator(QQmlRefPointer<QQmlContextData> contextData,
                       const QQmlRefPointer<QV4::ExecutableCompilationUnit> &compilationUnit,
@@ -152,6 +154,7 @@ private:
     void setupBindings(BindingSetupFlags mode = BindingMode::ApplyImmediate);
     bool setPropertyBinding(const QQmlPropertyData *property, const QV4::CompiledData::Binding *binding);
     void setPropertyValue(const QQmlPropertyData *property, const QV4::CompiledData::Binding *binding);
+    QVariant *convertedLiteralSlot(const QV4::CompiledData::Binding *binding);
     void setupFunctions();
 
     QString stringAt(int idx) const { return compilationUnit->stringAt(idx); }
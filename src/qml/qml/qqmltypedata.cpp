@@ -7,6 +7,7 @@
 #include <private/qqmlpropertyvalidator_p.h>
 #include <private/qqmlirbuilder_p.h>
 #include <private/qqmlirloader_p.h>
+#include <private/qqmlobjectcreator_p.h>
 #include <private/qqmlscriptblob_p.h>
 #include <private/qqmlscriptdata_p.h>
 #include <private/qqmltypecompiler_p.h>
@@ -434,6 +435,7 @@ void QQmlTypeData::done()
         }
 
         m_compiledData->finalizeCompositeType(enginePrivate, typeIds());
+        QQmlObjectCreator::prepareConvertedLiterals(m_compiledData.data());
     }
 
     {
@@ -586,11 +588,6 @@ void QQmlTypeData::initializeFromCachedUnit(const QQmlPrivate::CachedQmlUnit *un
 
 bool QQmlTypeData::loadFromSource()
 {
-    m_document.reset(new QmlIR::Document(isDebugging()));
-    m_document->jsModule.sourceTimeStamp = m_backupSourceCode.sourceTimeStamp();
-    QQmlEngine *qmlEngine = typeLoader()->engine();
-    QmlIR::IRBuilder compiler(qmlEngine->handle()->illegalNames());
-
     QString sourceError;
     const QString source = m_backupSourceCode.readAll(&sourceError);
     if (!sourceError.isEmpty()) {
@@ -598,6 +595,18 @@ bool QQmlTypeData::loadFromSource()
         return false;
     }
 
+    if (auto prefetched = typeLoader()->takePrefetchedDocument(
+                finalUrlString(), source, isDebugging())) {
+        m_document.reset(prefetched.release());
+        m_document->jsModule.sourceTimeStamp = m_backupSourceCode.sourceTimeStamp();
+        return true;
+    }
+
+    m_document.reset(new QmlIR::Document(isDebugging()));
+    m_document->jsModule.sourceTimeStamp = m_backupSourceCode.sourceTimeStamp();
+    QQmlEngine *qmlEngine = typeLoader()->engine();
+    QmlIR::IRBuilder compiler(qmlEngine->handle()->illegalNames());
+
     if (!compiler.generateFromQml(source, finalUrlString(), m_document.data())) {
         QList<QQmlError> errors;
         errors.reserve(compiler.errors.count());
@@ -824,6 +833,11 @@ void QQmlTypeData::resolveTypes()
         }
     }
 
+    // Composite types are loaded one after another below. Resolve them all first, so that the
+    // documents not loaded yet can be parsed in parallel in the meantime.
+    QList<int> compositeRefs;
+    QList<QUrl> compositeUrls;
+
     for (QV4::CompiledData::TypeReferenceMap::ConstIterator unresolvedRef = m_typeReferences.constBegin(), end = m_typeReferences.constEnd();
          unresolvedRef != end; ++unresolvedRef) {
 
@@ -843,8 +857,8 @@ void QQmlTypeData::resolveTypes()
             return;
 
         if (ref.type.isComposite() && !ref.selfReference) {
-            ref.typeData = typeLoader()->getType(ref.type.sourceUrl());
-            addDependency(ref.typeData.data());
+            compositeRefs.append(unresolvedRef.key());
+            compositeUrls.append(ref.type.sourceUrl());
         }
         if (ref.type.isInlineComponentType()) {
             auto containingType = ref.type.containingType();
@@ -864,6 +878,19 @@ void QQmlTypeData::resolveTypes()
         m_resolvedTypes.insert(unresolvedRef.key(), ref);
     }
 
+    if (compositeUrls.size() > 1)
+        typeLoader()->prefetchTypes(compositeUrls);
+
+    for (qsizetype i = 0, count = compositeRefs.size(); i < count; ++i) {
+        QQmlRefPointer<QQmlTypeData> typeData = typeLoader()->getType(compositeUrls.at(i));
+        addDependency(typeData.data());
+
+        // Inline components refer to the type data of their containing type instead.
+        TypeReference &ref = m_resolvedTypes[compositeRefs.at(i)];
+        if (!ref.typeData)
+            ref.typeData = typeData;
+    }
+
     // ### this allows enums to work without explicit import or instantiation of the type
     if (!m_implicitImportLoaded)
         loadImplicitImport();
@@ -10,6 +10,8 @@
 #include <private/qqmltypeloaderqmldircontent_p.h>
 #include <private/qqmltypeloaderthread_p.h>
 #include <private/qqmlsourcecoordinate_p.h>
+#include <private/qqmlirbuilder_p.h>
+#include <private/qqmlglobal_p.h>
 
 #include <QtQml/qqmlabstracturlinterceptor.h>
 #include <QtQml/qqmlengine.h>
@@ -23,6 +25,11 @@
 #include <QtCore/qfile.h>
 #include <QtCore/qthread.h>
 
+#if QT_CONFIG(thread)
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
+#endif
+
 #include <functional>
 
 // #define DATABLOB_DEBUG
@@ -35,6 +42,8 @@
 
 QT_BEGIN_NAMESPACE
 
+DEFINE_BOOL_CONFIG_OPTION(disableParallelParsing, QML_DISABLE_PARALLEL_PARSING);
+
 namespace {
 
     template<typename LockType>
@@ -84,6 +93,12 @@ void QQmlTypeLoader::invalidate()
         m_thread = nullptr;
     }
 
+    clearPrefetchedDocuments();
+#if QT_CONFIG(thread)
+    delete m_parserThreadPool;
+    m_parserThreadPool = nullptr;
+#endif
+
 #if QT_CONFIG(qml_network)
     // Need to delete the network replies after
     // the loader thread is shutdown as it could be
@@ -432,6 +447,155 @@ void QQmlTypeLoader::setCachedUnit(const QQmlDataBlob::Ptr &blob, const QQmlPriv
     blob->tryDone();
 }
 
+#if QT_CONFIG(thread)
+/*!
+\internal
+A QML document that is parsed on one of the parser threads ahead of its blob being loaded. The
+loader thread adopts the document when the blob reads the very same source, and parses it
+itself if the job hasn't been picked up by a parser thread yet.
+*/
+struct QQmlTypeLoader::PrefetchedDocument
+{
+    enum State { Pending, Running, Done, Cancelled };
+
+    QString url;
+    QString fileName;
+    QSet<QString> illegalNames;
+    bool debugMode = false;
+
+    QAtomicInt state = Pending;
+    QSemaphore finished;
+
+    // Written by the parser thread, only read after finished has been acquired.
+    QString source;
+    std::unique_ptr<QmlIR::Document> document;
+
+    void run()
+    {
+        if (!state.testAndSetAcquire(Pending, Running))
+            return;
+
+        QFile file(fileName);
+        if (file.open(QIODevice::ReadOnly)) {
+            source = QString::fromUtf8(file.readAll());
+            document = std::make_unique<QmlIR::Document>(debugMode);
+            QmlIR::IRBuilder compiler(illegalNames);
+            // Errors are reported when the loader thread parses the document again.
+            if (!compiler.generateFromQml(source, url, document.get()))
+                document.reset();
+        }
+
+        state.storeRelease(Done);
+        finished.release();
+    }
+
+    void cancelOrWait()
+    {
+        if (!state.testAndSetAcquire(Pending, Cancelled))
+            finished.acquire();
+    }
+};
+#else
+struct QQmlTypeLoader::PrefetchedDocument
+{
+};
+#endif
+
+/*!
+Starts parsing the QML documents at \a urls on the parser threads, so that they are ready by the
+time the type loader gets to them. Only local files that are neither loaded yet nor available
+from a compilation unit cache are considered. Type compilation itself stays on the loader
+thread, as it relies on the results of the documents' dependencies.
+*/
+void QQmlTypeLoader::prefetchTypes(const QList<QUrl> &urls)
+{
+#if QT_CONFIG(thread)
+    if (disableParallelParsing())
+        return;
+
+    QV4::ExecutionEngine *v4 = engine()->handle();
+    LockHolder<QQmlTypeLoader> holder(this);
+
+    for (const QUrl &unNormalizedUrl : urls) {
+        const QUrl url = normalize(unNormalizedUrl);
+        if (url.hasFragment() || !QQmlFile::isSynchronous(url) || m_typeCache.contains(url))
+            continue;
+
+        const QString urlString = url.toString();
+        if (m_prefetchedDocuments.contains(urlString))
+            continue;
+
+        if (v4->diskCacheEnabled()
+                && (QQmlMetaType::findCachedCompilationUnit(url, nullptr)
+                    || QFile::exists(QV4::ExecutableCompilationUnit::localCacheFilePath(url)))) {
+            continue;
+        }
+
+        if (!m_parserThreadPool) {
+            const int threadCount = QThread::idealThreadCount() - 1;
+            if (threadCount < 1)
+                return;
+            m_parserThreadPool = new QThreadPool;
+            m_parserThreadPool->setObjectName(QStringLiteral("QQmlTypeLoaderParser"));
+            m_parserThreadPool->setMaxThreadCount(threadCount);
+        }
+
+        auto prefetched = std::make_shared<PrefetchedDocument>();
+        prefetched->url = urlString;
+        prefetched->fileName = QQmlFile::urlToLocalFileOrQrc(url);
+        prefetched->illegalNames = v4->illegalNames();
+        prefetched->debugMode = v4->debugger() != nullptr;
+        m_prefetchedDocuments.insert(urlString, prefetched);
+        m_parserThreadPool->start([prefetched]() { prefetched->run(); });
+    }
+#else
+    Q_UNUSED(urls);
+#endif
+}
+
+/*!
+Returns the document prefetched for \a finalUrl if it was parsed from \a source in the given
+\a debugMode, or nullptr if the caller has to parse it itself.
+*/
+std::unique_ptr<QmlIR::Document> QQmlTypeLoader::takePrefetchedDocument(
+        const QString &finalUrl, const QString &source, bool debugMode)
+{
+#if QT_CONFIG(thread)
+    std::shared_ptr<PrefetchedDocument> prefetched;
+    {
+        LockHolder<QQmlTypeLoader> holder(this);
+        if (m_prefetchedDocuments.isEmpty())
+            return nullptr;
+        prefetched = m_prefetchedDocuments.take(finalUrl);
+    }
+
+    if (!prefetched)
+        return nullptr;
+
+    prefetched->cancelOrWait();
+    if (prefetched->state.loadAcquire() != PrefetchedDocument::Done
+            || prefetched->debugMode != debugMode || prefetched->source != source) {
+        return nullptr;
+    }
+
+    return std::move(prefetched->document);
+#else
+    Q_UNUSED(finalUrl);
+    Q_UNUSED(source);
+    Q_UNUSED(debugMode);
+    return nullptr;
+#endif
+}
+
+void QQmlTypeLoader::clearPrefetchedDocuments()
+{
+#if QT_CONFIG(thread)
+    for (const auto &prefetched : qAsConst(m_prefetchedDocuments))
+        prefetched->cancelOrWait();
+#endif
+    m_prefetchedDocuments.clear();
+}
+
 void QQmlTypeLoader::shutdownThread()
 {
     if (m_thread && !m_thread->isShutdown())
@@ -1245,6 +1409,7 @@ void QQmlTypeLoader::clearCache()
     m_importDirCache.clear();
     m_importQmlDirCache.clear();
     m_checksumCache.clear();
+    clearPrefetchedDocuments();
     QQmlMetaType::freeUnusedTypesAndCaches();
 }
 
@@ -1282,6 +1447,20 @@ void QQmlTypeLoader::trimCache()
             break;
     }
 
+#if QT_CONFIG(thread)
+    // Drop documents that were prefetched but never picked up, for example because the type was
+    // loaded from a cache after all.
+    for (auto iter = m_prefetchedDocuments.begin(); iter != m_prefetchedDocuments.end();) {
+        const QQmlTypeData *typeData = m_typeCache.value(QUrl((*iter)->url));
+        if (typeData && typeData->isCompleteOrError()) {
+            (*iter)->cancelOrWait();
+            iter = m_prefetchedDocuments.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+#endif
+
     updateTypeCacheTrimThreshold();
 
     QQmlMetaType::freeUnusedTypesAndCaches();
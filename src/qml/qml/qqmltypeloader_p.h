@@ -37,6 +37,11 @@ class QQmlExtensionInterface;
 class QQmlProfiler;
 class QQmlTypeLoaderThread;
 class QQmlEngine;
+class QThreadPool;
+
+namespace QmlIR {
+struct Document;
+}
 
 class Q_QML_PRIVATE_EXPORT QQmlTypeLoader
 {
@@ -138,6 +143,10 @@ public:
     void clearCache();
     void trimCache();
 
+    void prefetchTypes(const QList<QUrl> &urls);
+    std::unique_ptr<QmlIR::Document> takePrefetchedDocument(
+            const QString &finalUrl, const QString &source, bool debugMode);
+
     bool isTypeLoaded(const QUrl &url) const;
     bool isScriptLoaded(const QUrl &url) const;
 
@@ -186,11 +195,15 @@ private:
     void setData(const QQmlDataBlob::Ptr &, const QQmlDataBlob::SourceCodeData &);
     void setCachedUnit(const QQmlDataBlob::Ptr &blob, const QQmlPrivate::CachedQmlUnit *unit);
 
+    struct PrefetchedDocument;
+    void clearPrefetchedDocuments();
+
     typedef QHash<QUrl, QQmlTypeData *> TypeCache;
     typedef QHash<QUrl, QQmlScriptBlob *> ScriptCache;
     typedef QHash<QUrl, QQmlQmldirData *> QmldirCache;
     typedef QCache<QString, QCache<QString, bool> > ImportDirCache;
     typedef QStringHash<QQmlTypeLoaderQmldirContent *> ImportQmlDirCache;
+    typedef QHash<QString, std::shared_ptr<PrefetchedDocument>> PrefetchedDocuments;
 
     QQmlEngine *m_engine;
     QQmlTypeLoaderThread *m_thread;
@@ -210,6 +223,8 @@ private:
     ImportDirCache m_importDirCache;
     ImportQmlDirCache m_importQmlDirCache;
     ChecksumCache m_checksumCache;
+    PrefetchedDocuments m_prefetchedDocuments;
+    QThreadPool *m_parserThreadPool = nullptr;
 
     template<typename Loader>
     void doLoad(const Loader &loader, QQmlDataBlob *blob, Mode mode);
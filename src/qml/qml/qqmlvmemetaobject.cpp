@@ -5,6 +5,7 @@
 #include "qqmlvmemetaobject_p.h"
 
 #include <private/qqmlrefcount_p.h>
+#include <private/qrecyclepool_p.h>
 #include "qqmlpropertyvalueinterceptor_p.h"
 #include <qqmlinfo.h>
 
@@ -393,6 +394,19 @@ QQmlVMEMetaObject::~QQmlVMEMetaObject()
     qDeleteAll(varObjectGuards);
 }
 
+// Subclasses, like the one of the designer, are larger and use the heap.
+using QQmlVMEMetaObjectAllocator = QRecyclePoolAllocator<sizeof(QQmlVMEMetaObject), 256>;
+
+void *QQmlVMEMetaObject::operator new(size_t size)
+{
+    return QQmlVMEMetaObjectAllocator::allocate(size);
+}
+
+void QQmlVMEMetaObject::operator delete(void *ptr, size_t size)
+{
+    QQmlVMEMetaObjectAllocator::deallocate(ptr, size);
+}
+
 QV4::MemberData *QQmlVMEMetaObject::propertyAndMethodStorageAsMemberData() const
 {
     if (propertyAndMethodStorage.isUndefined()) {
@@ -132,6 +132,9 @@ public:
                       int qmlObjectId);
     ~QQmlVMEMetaObject() override;
 
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
     bool aliasTarget(int index, QObject **target, int *coreIndex, int *valueTypeIndex) const;
     QV4::ReturnedValue vmeMethod(int index) const;
     void setVmeMethod(int index, const QV4::Value &function);
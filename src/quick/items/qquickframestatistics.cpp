@@ -0,0 +1,185 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qquickframestatistics_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QQuickFrameStatistics
+    \since 6.5
+    \inmodule QtQuick
+
+    \brief QQuickFrameStatistics reports where the CPU time of the last frame
+    of a QQuickWindow was spent.
+
+    The statistics are collected for every frame with very little overhead,
+    so unlike the output enabled by the \c qt.scenegraph.time.renderloop and
+    \c qt.scenegraph.time.renderer logging categories, they are suitable for
+    sampling in production builds, for example to gather telemetry.
+
+    The times are reported in milliseconds, and cover the following phases:
+
+    \list
+    \li polishTime() - calling QQuickItem::updatePolish() on the items on the
+    GUI thread. This includes all polishing done since the previous frame was
+    synchronized.
+    \li syncTime() - synchronizing the items into the scene graph, including
+    QQuickItem::updatePaintNode().
+    \li renderPrepareTime() - building render lists and batches, and uploading
+    vertex and index data in the scene graph renderer.
+    \li renderRecordTime() - recording the draw calls of the render pass.
+    \endlist
+
+    The batch, node, and upload counts are those of the default scene graph
+    renderer. With other renderers, such as the \c software backend, the
+    render phase times and counts are reported as zero.
+
+    In QML the same data is available through the \c frameStatistics value
+    type returned by \c{Window.frameStatistics()}.
+
+    \sa QQuickWindow::frameStatistics()
+*/
+
+/*!
+    Constructs an invalid QQuickFrameStatistics with all values set to zero.
+ */
+QQuickFrameStatistics::QQuickFrameStatistics()
+    : d(new QQuickFrameStatisticsPrivate)
+{
+}
+
+/*!
+    \internal
+ */
+QQuickFrameStatistics::QQuickFrameStatistics(const QQuickFrameStatistics &other)
+    : d(other.d)
+{
+    d->ref.ref();
+}
+
+/*!
+    \internal
+ */
+QQuickFrameStatistics &QQuickFrameStatistics::operator=(const QQuickFrameStatistics &other)
+{
+    qAtomicAssign(d, other.d);
+    return *this;
+}
+
+/*!
+    Destructor.
+ */
+QQuickFrameStatistics::~QQuickFrameStatistics()
+{
+    if (!d->ref.deref())
+        delete d;
+}
+
+/*!
+    \return true if the statistics describe a rendered frame. This is false
+    until the window has rendered its first frame.
+ */
+bool QQuickFrameStatistics::isValid() const
+{
+    return d->frameNumber > 0;
+}
+
+/*!
+    \return the number of the frame the statistics describe, counting from 1
+    for the first frame rendered by the window.
+ */
+qint64 QQuickFrameStatistics::frameNumber() const
+{
+    return d->frameNumber;
+}
+
+/*!
+    \return the time, in milliseconds, spent polishing items for the frame.
+ */
+qreal QQuickFrameStatistics::polishTime() const
+{
+    return d->polishTime / 1000000.0;
+}
+
+/*!
+    \return the time, in milliseconds, spent synchronizing the items into the
+    scene graph for the frame.
+ */
+qreal QQuickFrameStatistics::syncTime() const
+{
+    return d->syncTime / 1000000.0;
+}
+
+/*!
+    \return the time, in milliseconds, the renderer spent preparing the frame.
+ */
+qreal QQuickFrameStatistics::renderPrepareTime() const
+{
+    return d->renderPrepareTime / 1000000.0;
+}
+
+/*!
+    \return the time, in milliseconds, the renderer spent recording the draw
+    calls for the frame.
+ */
+qreal QQuickFrameStatistics::renderRecordTime() const
+{
+    return d->renderRecordTime / 1000000.0;
+}
+
+/*!
+    \return the number of opaque batches drawn in the frame.
+ */
+int QQuickFrameStatistics::opaqueBatchCount() const
+{
+    return d->opaqueBatchCount;
+}
+
+/*!
+    \return the number of alpha blended batches drawn in the frame.
+ */
+int QQuickFrameStatistics::alphaBatchCount() const
+{
+    return d->alphaBatchCount;
+}
+
+/*!
+    \return the number of geometry nodes in the batches of the frame.
+ */
+int QQuickFrameStatistics::nodeCount() const
+{
+    return d->nodeCount;
+}
+
+/*!
+    \return the number of bytes of vertex and index data uploaded by the
+    renderer in the frame.
+ */
+qint64 QQuickFrameStatistics::uploadedBytes() const
+{
+    return d->uploadedBytes;
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+QDebug operator<<(QDebug dbg, const QQuickFrameStatistics &stats)
+{
+    QDebugStateSaver saver(dbg);
+    dbg.nospace() << "QQuickFrameStatistics("
+                  << "frame=" << stats.frameNumber()
+                  << " polish=" << stats.polishTime()
+                  << " sync=" << stats.syncTime()
+                  << " renderPrepare=" << stats.renderPrepareTime()
+                  << " renderRecord=" << stats.renderRecordTime()
+                  << " opaqueBatches=" << stats.opaqueBatchCount()
+                  << " alphaBatches=" << stats.alphaBatchCount()
+                  << " nodes=" << stats.nodeCount()
+                  << " uploadedBytes=" << stats.uploadedBytes()
+                  << ')';
+    return dbg;
+}
+#endif // QT_NO_DEBUG_STREAM
+
+QT_END_NAMESPACE
+
+#include "moc_qquickframestatistics.cpp"
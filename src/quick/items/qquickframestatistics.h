@@ -0,0 +1,59 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQUICKFRAMESTATISTICS_H
+#define QQUICKFRAMESTATISTICS_H
+
+#include <QtQuick/qtquickglobal.h>
+#include <QtCore/qobjectdefs.h>
+#include <QtCore/qdebug.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQuickFrameStatisticsPrivate;
+
+class Q_QUICK_EXPORT QQuickFrameStatistics
+{
+    Q_GADGET
+    Q_PROPERTY(qint64 frameNumber READ frameNumber CONSTANT FINAL)
+    Q_PROPERTY(qreal polishTime READ polishTime CONSTANT FINAL)
+    Q_PROPERTY(qreal syncTime READ syncTime CONSTANT FINAL)
+    Q_PROPERTY(qreal renderPrepareTime READ renderPrepareTime CONSTANT FINAL)
+    Q_PROPERTY(qreal renderRecordTime READ renderRecordTime CONSTANT FINAL)
+    Q_PROPERTY(int opaqueBatchCount READ opaqueBatchCount CONSTANT FINAL)
+    Q_PROPERTY(int alphaBatchCount READ alphaBatchCount CONSTANT FINAL)
+    Q_PROPERTY(int nodeCount READ nodeCount CONSTANT FINAL)
+    Q_PROPERTY(qint64 uploadedBytes READ uploadedBytes CONSTANT FINAL)
+
+public:
+    QQuickFrameStatistics();
+    ~QQuickFrameStatistics();
+    QQuickFrameStatistics(const QQuickFrameStatistics &other);
+    QQuickFrameStatistics &operator=(const QQuickFrameStatistics &other);
+
+    bool isValid() const;
+
+    qint64 frameNumber() const;
+
+    qreal polishTime() const;
+    qreal syncTime() const;
+    qreal renderPrepareTime() const;
+    qreal renderRecordTime() const;
+
+    int opaqueBatchCount() const;
+    int alphaBatchCount() const;
+    int nodeCount() const;
+    qint64 uploadedBytes() const;
+
+private:
+    QQuickFrameStatisticsPrivate *d;
+    friend class QQuickFrameStatisticsPrivate;
+};
+
+#ifndef QT_NO_DEBUG_STREAM
+Q_QUICK_EXPORT QDebug operator<<(QDebug dbg, const QQuickFrameStatistics &stats);
+#endif
+
+QT_END_NAMESPACE
+
+#endif // QQUICKFRAMESTATISTICS_H
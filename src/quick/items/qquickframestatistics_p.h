@@ -0,0 +1,46 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQUICKFRAMESTATISTICS_P_H
+#define QQUICKFRAMESTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick/private/qtquickglobal_p.h>
+#include <QAtomicInt>
+#include "qquickframestatistics.h"
+
+QT_BEGIN_NAMESPACE
+
+class Q_QUICK_PRIVATE_EXPORT QQuickFrameStatisticsPrivate
+{
+public:
+    static QQuickFrameStatisticsPrivate *get(QQuickFrameStatistics *p) { return p->d; }
+    static const QQuickFrameStatisticsPrivate *get(const QQuickFrameStatistics *p) { return p->d; }
+
+    QAtomicInt ref = 1;
+
+    // Times are in nanoseconds
+    qint64 frameNumber = 0;
+    qint64 polishTime = 0;
+    qint64 syncTime = 0;
+    qint64 renderPrepareTime = 0;
+    qint64 renderRecordTime = 0;
+    int opaqueBatchCount = 0;
+    int alphaBatchCount = 0;
+    int nodeCount = 0;
+    qint64 uploadedBytes = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQUICKFRAMESTATISTICS_P_H
@@ -41,6 +41,19 @@ bool QQuickImageBasePrivate::updateDevicePixelRatio(qreal targetDevicePixelRatio
     return setDevicePixelRatio;
 }
 
+// Images that are not shown, such as those in the delegates a view keeps in its cache buffer,
+// are overtaken by visible images in the pixmap reader.
+bool QQuickImageBasePrivate::isLoadedWithLowPriority() const
+{
+    Q_Q(const QQuickImageBase);
+    return !q->isVisible() || isCulledInTree();
+}
+
+void QQuickImageBasePrivate::culledInTreeChanged()
+{
+    pix.setLowPriority(isLoadedWithLowPriority());
+}
+
 QQuickImageBase::QQuickImageBase(QQuickItem *parent)
 : QQuickImplicitSizeItem(*(new QQuickImageBasePrivate), parent)
 {
@@ -281,6 +294,8 @@ void QQuickImageBase::loadPixmap(const QUrl &url, LoadPixmapOptions loadOptions)
         options |= QQuickPixmap::Asynchronous;
     if (d->cache)
         options |= QQuickPixmap::Cache;
+    if (d->isLoadedWithLowPriority())
+        options |= QQuickPixmap::LowPriority;
     d->pix.clear(this);
     QUrl loadUrl = url;
     const QQmlContext *context = qmlContext(this);
@@ -414,6 +429,8 @@ void QQuickImageBase::itemChange(ItemChange change, const ItemChangeData &value)
             if (d->devicePixelRatio == oldDpr)
                 d->updateDevicePixelRatio(value.realValue);
         }
+    } else if (change == ItemVisibleHasChanged || change == ItemParentHasChanged) {
+        d->pix.setLowPriority(d->isLoadedWithLowPriority());
     }
     QQuickItem::itemChange(change, value);
 }
@@ -43,6 +43,8 @@ public:
     }
 
     virtual bool updateDevicePixelRatio(qreal targetDevicePixelRatio);
+    bool isLoadedWithLowPriority() const;
+    void culledInTreeChanged() override;
 
     QQuickPixmap pix;
     QQuickImageBase::Status status;
@@ -6584,6 +6584,17 @@ void QQuickItemPrivate::derefFromEffectItem(bool unhide)
     recursiveRefFromEffectItem(-1);
 }
 
+static void notifyCulledInTreeChanged(QQuickItemPrivate *d)
+{
+    d->culledInTreeChanged();
+    for (QQuickItem *child : std::as_const(d->childItems)) {
+        QQuickItemPrivate *childPrivate = QQuickItemPrivate::get(child);
+        // The subtree of a culled child stays culled
+        if (!childPrivate->culled)
+            notifyCulledInTreeChanged(childPrivate);
+    }
+}
+
 void QQuickItemPrivate::setCulled(bool cull)
 {
     if (cull == culled)
@@ -6592,6 +6603,23 @@ void QQuickItemPrivate::setCulled(bool cull)
     culled = cull;
     if ((cull && ++extra.value().hideRefCount == 1) || (!cull && --extra.value().hideRefCount == 0))
         dirty(HideReference);
+
+    notifyCulledInTreeChanged(this);
+}
+
+/*!
+    \internal
+
+    Returns true if the item or one of its ancestors has been culled by a view,
+    so that the item is not rendered although it is visible.
+*/
+bool QQuickItemPrivate::isCulledInTree() const
+{
+    for (const QQuickItemPrivate *d = this; d; d = d->parentItem ? get(d->parentItem) : nullptr) {
+        if (d->culled)
+            return true;
+    }
+    return false;
 }
 
 void QQuickItemPrivate::itemChange(QQuickItem::ItemChange change, const QQuickItem::ItemChangeData &data)
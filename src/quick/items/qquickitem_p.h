@@ -530,6 +530,9 @@ public:
     QQuickItem**prevDirtyItem;
 
     void setCulled(bool);
+    bool isCulledInTree() const;
+    // Called when the item or one of its ancestors is culled or no longer culled
+    virtual void culledInTreeChanged() {}
 
     QQuickWindow *window;
     int windowRefCount;
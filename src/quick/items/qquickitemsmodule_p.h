@@ -16,6 +16,7 @@
 //
 
 #include <private/qtquickglobal_p.h>
+#include <QtQuick/qquickframestatistics.h>
 #include <QtGui/qevent.h>
 #include <QtGui/qpointingdevice.h>
 #include <qqml.h>
@@ -55,6 +56,15 @@ struct QPointingDeviceUniqueIdForeign
     QML_UNCREATABLE("pointingDeviceUniqueId cannot be created in QML.")
 };
 
+struct QQuickFrameStatisticsForeign
+{
+    Q_GADGET
+    QML_FOREIGN(QQuickFrameStatistics)
+    QML_VALUE_TYPE(frameStatistics)
+    QML_ADDED_IN_VERSION(6, 5)
+    QML_UNCREATABLE("frameStatistics cannot be created in QML.")
+};
+
 #if !QT_CONFIG(quick_animatedimage)
 struct QQuickAnimatedImageNotAvailable
 {
@@ -32,9 +32,11 @@
 #include <QtCore/qabstractanimation.h>
 #include <QtCore/QLibraryInfo>
 #include <QtCore/QRunnable>
+#include <QtCore/QElapsedTimer>
 #include <QtQml/qqmlincubator.h>
 #include <QtQml/qqmlinfo.h>
 #include <QtQml/private/qqmlmetatype_p.h>
+#include <QtQml/private/qqmlengine_p.h>
 
 #include <QtQuick/private/qquickpixmapcache_p.h>
 
@@ -334,6 +336,13 @@ void QQuickWindowPrivate::polishItems()
     // or indirectly, we use a PolishLoopDetector to determine if a warning should
     // be printed to the user.
 
+    // With deferred binding updates enabled, let the pending bindings settle
+    // first so that items get polished with their final values.
+    QQmlEnginePrivate::flushBindingUpdatesForCurrentThread();
+
+    QElapsedTimer polishTimer;
+    polishTimer.start();
+
     PolishLoopDetector polishLoopDetector(itemsToPolish);
     while (!itemsToPolish.isEmpty()) {
         QQuickItem *item = itemsToPolish.takeLast();
@@ -346,6 +355,8 @@ void QQuickWindowPrivate::polishItems()
             break;
     }
 
+    pendingPolishTime += polishTimer.nsecsElapsed();
+
 #if QT_CONFIG(im)
     if (QQuickItem *focusItem = q_func()->activeFocusItem()) {
         // If the current focus item, or any of its anchestors, has changed location
@@ -516,6 +527,9 @@ void QQuickWindowPrivate::syncSceneGraph()
 {
     Q_Q(QQuickWindow);
 
+    QElapsedTimer syncTimer;
+    syncTimer.start();
+
     ensureCustomRenderTarget();
 
     QRhiCommandBuffer *cb = nullptr;
@@ -570,6 +584,12 @@ void QQuickWindowPrivate::syncSceneGraph()
 
     emit q->afterSynchronizing();
     runAndClearJobs(&afterSynchronizingJobs);
+
+    // The gui thread is blocked (or this is the gui thread), so picking up
+    // the polish time is safe here.
+    syncedPolishTime = pendingPolishTime;
+    pendingPolishTime = 0;
+    syncTime = syncTimer.nsecsElapsed();
 }
 
 void QQuickWindowPrivate::emitBeforeRenderPassRecording(void *ud)
@@ -664,6 +684,8 @@ void QQuickWindowPrivate::renderSceneGraph(const QSize &size, const QSize &surfa
 
     context->endNextFrame(renderer);
 
+    publishFrameStatistics();
+
     if (renderer && renderer->hasVisualizationModeWithContinuousUpdate()) {
         // For the overdraw visualizer. This update is not urgent so avoid a
         // direct update() call, this is only here to keep the overdraw
@@ -672,6 +694,29 @@ void QQuickWindowPrivate::renderSceneGraph(const QSize &size, const QSize &surfa
     }
 }
 
+void QQuickWindowPrivate::publishFrameStatistics()
+{
+    QQuickFrameStatistics stats;
+    QQuickFrameStatisticsPrivate *sd = QQuickFrameStatisticsPrivate::get(&stats);
+    sd->frameNumber = ++renderedFrameCount;
+    sd->polishTime = syncedPolishTime;
+    sd->syncTime = syncTime;
+    const QSGRenderer::FrameStatistics &rs(renderer->frameStatistics());
+    sd->renderPrepareTime = rs.prepareTime;
+    sd->renderRecordTime = rs.recordTime;
+    sd->opaqueBatchCount = rs.opaqueBatchCount;
+    sd->alphaBatchCount = rs.alphaBatchCount;
+    sd->nodeCount = rs.nodeCount;
+    sd->uploadedBytes = rs.uploadedBytes;
+
+    // A frame rendered without a sync did no polishing or syncing
+    syncedPolishTime = 0;
+    syncTime = 0;
+
+    QMutexLocker locker(&frameStatisticsMutex);
+    frameStatistics = stats;
+}
+
 QQuickWindowPrivate::QQuickWindowPrivate()
     : contentItem(nullptr)
     , dirtyItemList(nullptr)
@@ -3558,6 +3603,30 @@ void QQuickWindow::endExternalCommands()
     \endqml
 */
 
+/*!
+    \qmlmethod frameStatistics QtQuick::Window::frameStatistics()
+    \since 6.5
+
+    Returns the CPU time breakdown of the most recently rendered frame, in
+    milliseconds, together with the batch, node, and upload counts of the
+    scene graph renderer. The returned value has the properties
+    \c frameNumber, \c polishTime, \c syncTime, \c renderPrepareTime,
+    \c renderRecordTime, \c opaqueBatchCount, \c alphaBatchCount,
+    \c nodeCount, and \c uploadedBytes.
+
+    \qml
+    Timer {
+        interval: 1000; running: true; repeat: true
+        onTriggered: {
+            let stats = window.frameStatistics()
+            console.log(stats.frameNumber, stats.syncTime, stats.renderPrepareTime)
+        }
+    }
+    \endqml
+
+    \sa QQuickFrameStatistics
+ */
+
 /*!
     \qmlmethod QtQuick::Window::requestActivate()
     \since 5.1
@@ -4095,6 +4164,29 @@ QQuickGraphicsConfiguration QQuickWindow::graphicsConfiguration() const
     return d->graphicsConfig;
 }
 
+/*!
+    \return the CPU time breakdown, batch and node counts, and upload volume
+    of the most recently rendered frame of this window.
+
+    The statistics are collected for every frame, and this function is cheap
+    to call, so it can be sampled periodically, for example from a timer,
+    without affecting rendering. It is safe to call from the GUI thread while
+    the threaded render loop is rendering.
+
+    Before the first frame is rendered the returned object is not
+    \l{QQuickFrameStatistics::isValid()}{valid}.
+
+    \since 6.5
+
+    \sa QQuickFrameStatistics
+ */
+QQuickFrameStatistics QQuickWindow::frameStatistics() const
+{
+    Q_D(const QQuickWindow);
+    QMutexLocker locker(&d->frameStatisticsMutex);
+    return d->frameStatistics;
+}
+
 /*!
     Creates a simple rectangle node. When the scenegraph is not initialized, the return value is null.
 
@@ -6,6 +6,7 @@
 
 #include <QtQuick/qtquickglobal.h>
 #include <QtQuick/qsgrendererinterface.h>
+#include <QtQuick/qquickframestatistics.h>
 
 #include <QtCore/qmetatype.h>
 #include <QtGui/qwindow.h>
@@ -148,6 +149,8 @@ public:
     void setGraphicsConfiguration(const QQuickGraphicsConfiguration &config);
     QQuickGraphicsConfiguration graphicsConfiguration() const;
 
+    Q_REVISION(6, 5) Q_INVOKABLE QQuickFrameStatistics frameStatistics() const;
+
     QSGRectangleNode *createRectangleNode() const;
     QSGImageNode *createImageNode() const;
     QSGNinePatchNode *createNinePatchNode() const;
@@ -22,6 +22,7 @@
 #include <QtQuick/private/qquickrendertarget_p.h>
 #include <QtQuick/private/qquickgraphicsdevice_p.h>
 #include <QtQuick/private/qquickgraphicsconfiguration_p.h>
+#include <QtQuick/private/qquickframestatistics_p.h>
 #include <QtQuick/qquickitem.h>
 #include <QtQuick/qquickwindow.h>
 
@@ -208,6 +209,16 @@ public:
 
     QQuickGraphicsConfiguration graphicsConfig;
 
+    // Times in nanoseconds. Polish time accumulates on the gui thread until
+    // the next sync picks it up, the rest is only touched while syncing or
+    // rendering. The published statistics are guarded by the mutex.
+    qint64 pendingPolishTime = 0;
+    qint64 syncedPolishTime = 0;
+    qint64 syncTime = 0;
+    qint64 renderedFrameCount = 0;
+    mutable QMutex frameStatisticsMutex;
+    QQuickFrameStatistics frameStatistics;
+
     mutable QQuickWindowIncubationController *incubationController;
 
     static bool defaultAlphaBuffer;
@@ -234,6 +245,8 @@ public:
                                           QString *translatedMessage,
                                           QString *untranslatedMessage);
 
+    void publishFrameStatistics();
+
     static void emitBeforeRenderPassRecording(void *ud);
     static void emitAfterRenderPassRecording(void *ud);
 
@@ -9,13 +9,43 @@
 #include "qsgsoftwarerenderablenode_p.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
 #include <QtGui/QWindow>
 #include <QtQuick/QSGSimpleRectNode>
 
+#if QT_CONFIG(thread)
+#include <QtCore/QMutex>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#endif
+
 Q_LOGGING_CATEGORY(lc2DRender, "qt.scenegraph.softwarecontext.abstractrenderer")
 
 QT_BEGIN_NAMESPACE
 
+#if QT_CONFIG(thread)
+Q_GLOBAL_STATIC(QThreadPool, bandPainterPool)
+// The glyph caches of the font engines are shared and not thread-safe
+Q_GLOBAL_STATIC(QMutex, glyphPaintMutex)
+
+// Updates smaller than this (in device pixels) are not worth splitting up
+static const int minimumConcurrentPaintArea = 256 * 256;
+static const int minimumBandHeight = 32;
+
+static int paintThreadCountFromEnvironment()
+{
+    bool ok = false;
+    const int count = qEnvironmentVariableIntValue("QSG_SOFTWARE_RENDER_THREADS", &ok);
+    if (!ok)
+        return 1;
+    if (count <= 0)
+        return QThread::idealThreadCount();
+    return qMin(count, 64);
+}
+#endif
+
 QSGAbstractSoftwareRenderer::QSGAbstractSoftwareRenderer(QSGRenderContext *context)
     : QSGRenderer(context)
     , m_background(new QSGSimpleRectNode)
@@ -24,6 +54,11 @@ QSGAbstractSoftwareRenderer::QSGAbstractSoftwareRenderer(QSGRenderContext *conte
     // Setup special background node
     auto backgroundRenderable = new QSGSoftwareRenderableNode(QSGSoftwareRenderableNode::SimpleRect, m_background);
     addNodeMapping(m_background, backgroundRenderable);
+    renderableNodeUpdated(backgroundRenderable);
+
+#if QT_CONFIG(thread)
+    m_paintThreadCount = paintThreadCountFromEnvironment();
+#endif
 }
 
 QSGAbstractSoftwareRenderer::~QSGAbstractSoftwareRenderer()
@@ -50,6 +85,13 @@ const QVector<QSGSoftwareRenderableNode*> &QSGAbstractSoftwareRenderer::renderab
 void QSGAbstractSoftwareRenderer::addNodeMapping(QSGNode *node, QSGSoftwareRenderableNode *renderableNode)
 {
     m_nodes.insert(node, renderableNode);
+    m_renderListDirty = true;
+}
+
+void QSGAbstractSoftwareRenderer::renderableNodeUpdated(QSGSoftwareRenderableNode *node)
+{
+    m_dirtyNodes.insert(node);
+    m_nodeIndex.update(node);
 }
 
 void QSGAbstractSoftwareRenderer::appendRenderableNode(QSGSoftwareRenderableNode *node)
@@ -90,38 +132,181 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
 {
     QRegion dirtyRegion;
     // If there are no nodes, do nothing
-    if (m_renderableNodes.isEmpty())
+    if (m_paintList.isEmpty())
         return dirtyRegion;
 
-    auto iterator = m_renderableNodes.begin();
-    // First node is the background and needs to painted without blending
-    auto backgroundNode = *iterator;
-    dirtyRegion += backgroundNode->renderNode(painter, /*force opaque painting*/ true);
-    iterator++;
-
-    for (; iterator != m_renderableNodes.end(); ++iterator) {
-        auto node = *iterator;
-        dirtyRegion += node->renderNode(painter);
+#if QT_CONFIG(thread)
+    if (m_paintThreadCount > 1 && renderNodesConcurrently(painter, &dirtyRegion)) {
+        m_paintList.clear();
+        return dirtyRegion;
     }
+#endif
+
+    // The background needs to painted without blending
+    QSGSoftwareRenderableNode *backgroundNode = renderableNode(m_background);
+    for (QSGSoftwareRenderableNode *node : std::as_const(m_paintList))
+        dirtyRegion += node->renderNode(painter, /*force opaque painting*/ node == backgroundNode);
+    m_paintList.clear();
 
     return dirtyRegion;
 }
 
+#if QT_CONFIG(thread)
+/*
+    Paints the render list by splitting the dirty area into horizontal bands,
+    which are rendered concurrently directly into the backing image. Returns
+    false, without painting anything, when the target or the scene does not
+    allow this; the caller then falls back to painting serially.
+*/
+bool QSGAbstractSoftwareRenderer::renderNodesConcurrently(QPainter *painter, QRegion *dirtyRegion)
+{
+    QPaintDevice *device = painter->device();
+    if (device->devType() != QInternal::Image || painter->viewTransformEnabled()
+            || !painter->worldTransform().isIdentity() || painter->hasClipping()) {
+        return false;
+    }
+
+    QImage *image = static_cast<QImage *>(device);
+    const qreal dpr = image->devicePixelRatio();
+    const int scale = qRound(dpr);
+    if (scale < 1 || !qFuzzyCompare(dpr, qreal(scale)) || image->depth() % 8 != 0)
+        return false;
+
+    QSGSoftwareRenderableNode *backgroundNode = renderableNode(m_background);
+    QVector<QSGSoftwareRenderableNode *> nodesToPaint;
+    QRect bounds;
+    for (QSGSoftwareRenderableNode *node : std::as_const(m_paintList)) {
+        // Custom QSGRenderNodes paint through the active painter
+        if (node->type() == QSGSoftwareRenderableNode::RenderNode)
+            return false;
+        if (node->needsPainting()) {
+            nodesToPaint.append(node);
+            bounds |= node->dirtyRegion().boundingRect();
+        }
+    }
+
+    bounds &= QRect(0, 0, image->width() / scale, image->height() / scale);
+    const qint64 deviceArea = qint64(bounds.width()) * bounds.height() * scale * scale;
+    const int bandCount = qMin(m_paintThreadCount, bounds.height() * scale / minimumBandHeight);
+    if (deviceArea < minimumConcurrentPaintArea || bandCount < 2)
+        return false;
+
+    for (QSGSoftwareRenderableNode *node : std::as_const(nodesToPaint))
+        node->prepareForConcurrentPainting(dpr);
+
+    // Bands are in logical coordinates; with an integer device pixel ratio
+    // they always start on a whole device pixel row.
+    QVector<QRect> bands;
+    const int bandHeight = (bounds.height() + bandCount - 1) / bandCount;
+    for (int y = bounds.top(); y <= bounds.bottom(); y += bandHeight)
+        bands.append(QRect(bounds.left(), y, bounds.width(), qMin(bandHeight, bounds.bottom() + 1 - y)));
+
+    uchar *bits = image->bits();
+    const qsizetype bytesPerLine = image->bytesPerLine();
+    const int bytesPerPixel = image->depth() / 8;
+    const QImage::Format format = image->format();
+    const QPainter::RenderHints renderHints = painter->renderHints();
+
+    auto paintBand = [&](const QRect &band) {
+        const QRect deviceRect(band.topLeft() * scale, band.size() * scale);
+        QImage bandImage(bits + deviceRect.y() * bytesPerLine + deviceRect.x() * bytesPerPixel,
+                         deviceRect.width(), deviceRect.height(), bytesPerLine, format);
+        bandImage.setDevicePixelRatio(dpr);
+
+        QPainter bandPainter(&bandImage);
+        bandPainter.setRenderHints(renderHints);
+        bandPainter.setViewport(QRect(QPoint(0, 0), band.size()));
+        bandPainter.setWindow(band);
+
+        for (QSGSoftwareRenderableNode *node : std::as_const(nodesToPaint)) {
+            if (!node->dirtyRegion().intersects(band))
+                continue;
+            if (node->type() == QSGSoftwareRenderableNode::Glyph) {
+                QMutexLocker locker(glyphPaintMutex());
+                node->paint(&bandPainter);
+            } else {
+                // The background needs to painted without blending
+                node->paint(&bandPainter, node == backgroundNode);
+            }
+        }
+    };
+
+    QSemaphore bandsPainted;
+    for (int i = 1; i < bands.size(); ++i) {
+        const QRect band = bands.at(i);
+        bandPainterPool()->start([&paintBand, &bandsPainted, band] {
+            paintBand(band);
+            bandsPainted.release();
+        });
+    }
+    paintBand(bands.first());
+    bandsPainted.acquire(bands.size() - 1);
+
+    for (QSGSoftwareRenderableNode *node : std::as_const(m_paintList))
+        *dirtyRegion += node->finishPainting();
+
+    qCDebug(lc2DRender) << "painted" << nodesToPaint.size() << "nodes in" << bands.size() << "bands";
+    return true;
+}
+#endif
+
 void QSGAbstractSoftwareRenderer::buildRenderList()
 {
+    // The renderlist only depends on the structure of the tree, so it is
+    // kept until nodes are added or removed
+    if (!m_renderListDirty)
+        return;
+
     // Clear the previous renderlist
     m_renderableNodes.clear();
     // Add the background renderable (always first)
     m_renderableNodes.append(renderableNode(m_background));
     // Build the renderlist
     QSGSoftwareRenderListBuilder(this).visitChildren(rootNode());
+
+    m_nodeIndex.setRenderOrder(m_renderableNodes);
+    m_renderListDirty = false;
 }
 
 QRegion QSGAbstractSoftwareRenderer::optimizeRenderList()
 {
+    // Nodes can only become dirty by overlapping a region that is already
+    // dirty, so everything outside of it keeps its clean state and does not
+    // need to be visited at all.
+    QRegion affectedRegion = m_dirtyRegion;
+    for (QSGSoftwareRenderableNode *node : std::as_const(m_dirtyNodes)) {
+        if (node->isDirty()) {
+            affectedRegion += node->dirtyRegion();
+            affectedRegion += node->previousDirtyRegion();
+        }
+    }
+    m_dirtyNodes.clear();
+
+    const QRect renderArea = m_background->rect().toRect();
+    if (QRegion(renderArea).subtracted(affectedRegion).isEmpty())
+        m_paintList = m_renderableNodes;
+    else
+        m_paintList = m_nodeIndex.nodesIntersecting(affectedRegion);
+
+    // The frame is opaque if the opaque nodes cover all of the background
+    // between them. The background is normally opaque itself, so this rarely
+    // needs to go past the first node. QRegion::contains() only checks for
+    // overlap, hence the subtraction.
+    m_isOpaque = false;
+    QRegion uncoveredRegion(m_background->rect().toAlignedRect());
+    for (QSGSoftwareRenderableNode *node : std::as_const(m_renderableNodes)) {
+        if (!node->isOpaque())
+            continue;
+        uncoveredRegion -= node->boundingRectMin();
+        if (uncoveredRegion.isEmpty()) {
+            m_isOpaque = true;
+            break;
+        }
+    }
+
     // Iterate through the renderlist from front to back
     // Objective is to update the dirty status and rects.
-    for (auto i = m_renderableNodes.rbegin(); i != m_renderableNodes.rend(); ++i) {
+    for (auto i = m_paintList.rbegin(); i != m_paintList.rend(); ++i) {
         auto node = *i;
         if (!m_dirtyRegion.isEmpty()) {
             // See if the current dirty regions apply to the current node
@@ -163,19 +348,13 @@ QRegion QSGAbstractSoftwareRenderer::optimizeRenderList()
         }
     }
 
-    if (m_obscuredRegion.contains(m_background->rect().toAlignedRect())) {
-        m_isOpaque = true;
-    } else {
-        m_isOpaque = false;
-    }
-
     // Empty dirtyRegion (for second pass)
     m_dirtyRegion = QRegion();
     m_obscuredRegion = QRegion();
 
     // Iterate through the renderlist from back to front
     // Objective is to make sure all non-opaque items are painted when an item under them is dirty
-    for (auto j = m_renderableNodes.begin(); j != m_renderableNodes.end(); ++j) {
+    for (auto j = m_paintList.begin(); j != m_paintList.end(); ++j) {
         auto node = *j;
 
         if (!node->isOpaque() && !m_dirtyRegion.isEmpty()) {
@@ -200,7 +379,9 @@ void QSGAbstractSoftwareRenderer::setBackgroundColor(const QColor &color)
     if (m_background->color() == color)
         return;
     m_background->setColor(color);
-    renderableNode(m_background)->markMaterialDirty();
+    auto renderable = renderableNode(m_background);
+    renderable->markMaterialDirty();
+    renderableNodeUpdated(renderable);
 }
 
 void QSGAbstractSoftwareRenderer::setBackgroundRect(const QRect &rect, qreal devicePixelRatio)
@@ -209,7 +390,9 @@ void QSGAbstractSoftwareRenderer::setBackgroundRect(const QRect &rect, qreal dev
         return;
     m_background->setRect(rect);
     m_devicePixelRatio = devicePixelRatio;
-        renderableNode(m_background)->markGeometryDirty();
+    auto renderable = renderableNode(m_background);
+    renderable->markGeometryDirty();
+    renderableNodeUpdated(renderable);
     // Invalidate the whole scene when the background is resized
     markDirty();
 }
@@ -228,6 +411,8 @@ void QSGAbstractSoftwareRenderer::nodeAdded(QSGNode *node)
 {
     qCDebug(lc2DRender, "nodeAdded %p", (void*)node);
 
+    m_renderListDirty = true;
+
     m_nodeUpdater->updateNodes(node);
 }
 
@@ -235,6 +420,8 @@ void QSGAbstractSoftwareRenderer::nodeRemoved(QSGNode *node)
 {
     qCDebug(lc2DRender, "nodeRemoved %p", (void*)node);
 
+    m_renderListDirty = true;
+
     auto renderable = renderableNode(node);
     // remove mapping
     if (renderable != nullptr) {
@@ -244,6 +431,8 @@ void QSGAbstractSoftwareRenderer::nodeRemoved(QSGNode *node)
             dirtyRegion = renderable->boundingRectMax();
         m_dirtyRegion += dirtyRegion;
         m_nodes.remove(node);
+        m_nodeIndex.remove(renderable);
+        m_dirtyNodes.remove(renderable);
         delete renderable;
     }
 
@@ -263,6 +452,7 @@ void QSGAbstractSoftwareRenderer::nodeGeometryUpdated(QSGNode *node)
     auto renderable = renderableNode(node);
     if (renderable != nullptr) {
         renderable->markGeometryDirty();
+        renderableNodeUpdated(renderable);
     } else {
         m_nodeUpdater->updateNodes(node);
     }
@@ -276,6 +466,7 @@ void QSGAbstractSoftwareRenderer::nodeMaterialUpdated(QSGNode *node)
     auto renderable = renderableNode(node);
     if (renderable != nullptr) {
         renderable->markMaterialDirty();
+        renderableNodeUpdated(renderable);
     } else {
         m_nodeUpdater->updateNodes(node);
     }
@@ -17,7 +17,10 @@
 
 #include <private/qsgrenderer_p.h>
 
+#include "qsgsoftwarerenderablenodeindex_p.h"
+
 #include <QtCore/QHash>
+#include <QtCore/QSet>
 
 QT_BEGIN_NAMESPACE
 
@@ -34,6 +37,8 @@ public:
 
     QSGSoftwareRenderableNode *renderableNode(QSGNode *node) const;
     void addNodeMapping(QSGNode *node, QSGSoftwareRenderableNode *renderableNode);
+    // To be called whenever a renderable node was (re)computed by update()
+    void renderableNodeUpdated(QSGSoftwareRenderableNode *node);
     void appendRenderableNode(QSGSoftwareRenderableNode *node);
 
     void nodeChanged(QSGNode *node, QSGNode::DirtyState state) override;
@@ -60,9 +65,17 @@ private:
     void nodeMaterialUpdated(QSGNode *node);
     void nodeMatrixUpdated(QSGNode *node);
     void nodeOpacityUpdated(QSGNode *node);
+#if QT_CONFIG(thread)
+    bool renderNodesConcurrently(QPainter *painter, QRegion *dirtyRegion);
+#endif
 
     QHash<QSGNode*, QSGSoftwareRenderableNode*> m_nodes;
     QVector<QSGSoftwareRenderableNode*> m_renderableNodes;
+    // Subset of m_renderableNodes affected by the current frame
+    QVector<QSGSoftwareRenderableNode*> m_paintList;
+    QSet<QSGSoftwareRenderableNode*> m_dirtyNodes;
+    QSGSoftwareRenderableNodeIndex m_nodeIndex;
+    bool m_renderListDirty = true;
 
     QSGSimpleRectNode *m_background;
 
@@ -70,6 +83,7 @@ private:
     QRegion m_obscuredRegion;
     qreal m_devicePixelRatio = 1;
     bool m_isOpaque = false;
+    int m_paintThreadCount = 1;
 
     QSGSoftwareRenderableNodeUpdater *m_nodeUpdater;
 };
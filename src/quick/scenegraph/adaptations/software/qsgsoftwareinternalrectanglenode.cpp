@@ -199,14 +199,19 @@ void QSGSoftwareInternalRectangleNode::update()
     }
 }
 
+void QSGSoftwareInternalRectangleNode::updateDevicePixelRatio(qreal ratio)
+{
+    if (!qFuzzyCompare(ratio, m_devicePixelRatio)) {
+        m_devicePixelRatio = ratio;
+        generateCornerPixmap();
+    }
+}
+
 void QSGSoftwareInternalRectangleNode::paint(QPainter *painter)
 {
     //We can only check for a device pixel ratio change when we know what
     //paint device is being used.
-    if (!qFuzzyCompare(painter->device()->devicePixelRatio(), m_devicePixelRatio)) {
-        m_devicePixelRatio = painter->device()->devicePixelRatio();
-        generateCornerPixmap();
-    }
+    updateDevicePixelRatio(painter->device()->devicePixelRatio());
 
     if (painter->transform().isRotating()) {
         //Rotated rectangles lose the benefits of direct rendering, and have poor rendering
@@ -221,15 +226,18 @@ void QSGSoftwareInternalRectangleNode::paint(QPainter *painter)
         } else {
             //Rounded Rects and Rects with Borders
             //Avoids broken behaviors of QPainter::drawRect/roundedRect
-            QPixmap pixmap = QPixmap(qRound(m_rect.width() * m_devicePixelRatio), qRound(m_rect.height() * m_devicePixelRatio));
-            pixmap.fill(Qt::transparent);
-            pixmap.setDevicePixelRatio(m_devicePixelRatio);
-            QPainter pixmapPainter(&pixmap);
-            paintRectangle(&pixmapPainter, QRect(0, 0, m_rect.width(), m_rect.height()));
+            //A QImage, as this may run on one of the renderer's band painting threads
+            QImage image(qRound(m_rect.width() * m_devicePixelRatio), qRound(m_rect.height() * m_devicePixelRatio),
+                         QImage::Format_ARGB32_Premultiplied);
+            image.fill(Qt::transparent);
+            image.setDevicePixelRatio(m_devicePixelRatio);
+            QPainter imagePainter(&image);
+            paintRectangle(&imagePainter, QRect(0, 0, m_rect.width(), m_rect.height()));
+            imagePainter.end();
 
             QPainter::RenderHints previousRenderHints = painter->renderHints();
             painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
-            painter->drawPixmap(m_rect, pixmap);
+            painter->drawImage(m_rect, image);
             painter->setRenderHints(previousRenderHints);
         }
 
@@ -41,6 +41,8 @@ public:
     void update() override;
 
     void paint(QPainter *);
+    // Regenerates the cached corner pixmap for the given ratio, if needed
+    void updateDevicePixelRatio(qreal ratio);
 
     bool isOpaque() const;
     QRectF rect() const;
@@ -72,6 +72,7 @@ public:
     bool ownsTexture() const override { return m_owns; }
 
     void paint(QPainter *painter);
+    void ensureCachedMirroredPixmap();
 
 private:
     void updateCachedMirroredPixmap();
@@ -62,6 +62,14 @@ public:
     void update();
 
     QRegion renderNode(QPainter *painter, bool forceOpaquePainting = false);
+
+    // renderNode() split up for painting one node into several tiles
+    // concurrently; not applicable to RenderNode
+    bool needsPainting() const;
+    void prepareForConcurrentPainting(qreal devicePixelRatio);
+    void paint(QPainter *painter, bool forceOpaquePainting = false);
+    QRegion finishPainting();
+
     QRect boundingRectMin() const { return m_boundingRectMin; }
     QRect boundingRectMax() const { return m_boundingRectMax; }
     NodeType type() const { return m_nodeType; }
@@ -0,0 +1,125 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsgsoftwarerenderablenodeindex_p.h"
+#include "qsgsoftwarerenderablenode_p.h"
+
+#include <QtCore/QSet>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+// In logical pixels
+static const int cellSize = 128;
+
+static inline int cellCoordinate(int coordinate)
+{
+    // Round towards negative infinity, nodes may be partially off screen
+    return coordinate >= 0 ? coordinate / cellSize : -((-coordinate + cellSize - 1) / cellSize);
+}
+
+QRect QSGSoftwareRenderableNodeIndex::cellsForRect(const QRect &rect)
+{
+    if (rect.isEmpty())
+        return QRect();
+    return QRect(QPoint(cellCoordinate(rect.left()), cellCoordinate(rect.top())),
+                 QPoint(cellCoordinate(rect.right()), cellCoordinate(rect.bottom())));
+}
+
+void QSGSoftwareRenderableNodeIndex::insertIntoCells(QSGSoftwareRenderableNode *node, const QRect &cells)
+{
+    for (int y = cells.top(); y <= cells.bottom(); ++y) {
+        for (int x = cells.left(); x <= cells.right(); ++x)
+            m_cells[cellKey(x, y)].append(node);
+    }
+}
+
+void QSGSoftwareRenderableNodeIndex::removeFromCells(QSGSoftwareRenderableNode *node, const QRect &cells)
+{
+    for (int y = cells.top(); y <= cells.bottom(); ++y) {
+        for (int x = cells.left(); x <= cells.right(); ++x) {
+            auto it = m_cells.find(cellKey(x, y));
+            if (it == m_cells.end())
+                continue;
+            it->removeOne(node);
+            if (it->isEmpty())
+                m_cells.erase(it);
+        }
+    }
+}
+
+void QSGSoftwareRenderableNodeIndex::update(QSGSoftwareRenderableNode *node)
+{
+    Entry &entry = m_entries[node];
+    const QRect bounds = node->boundingRectMax();
+    if (entry.bounds == bounds)
+        return;
+
+    const QRect cells = cellsForRect(bounds);
+    if (cells != entry.cells) {
+        removeFromCells(node, entry.cells);
+        insertIntoCells(node, cells);
+        entry.cells = cells;
+    }
+    entry.bounds = bounds;
+}
+
+void QSGSoftwareRenderableNodeIndex::remove(QSGSoftwareRenderableNode *node)
+{
+    auto it = m_entries.find(node);
+    if (it == m_entries.end())
+        return;
+    removeFromCells(node, it->cells);
+    m_entries.erase(it);
+}
+
+void QSGSoftwareRenderableNodeIndex::clear()
+{
+    m_entries.clear();
+    m_cells.clear();
+}
+
+void QSGSoftwareRenderableNodeIndex::setRenderOrder(const QVector<QSGSoftwareRenderableNode *> &renderList)
+{
+    for (Entry &entry : m_entries)
+        entry.renderOrder = -1;
+
+    for (int i = 0; i < renderList.size(); ++i) {
+        QSGSoftwareRenderableNode *node = renderList.at(i);
+        update(node);
+        m_entries[node].renderOrder = i;
+    }
+}
+
+QVector<QSGSoftwareRenderableNode *> QSGSoftwareRenderableNodeIndex::nodesIntersecting(const QRegion &region) const
+{
+    QSet<QSGSoftwareRenderableNode *> found;
+    for (const QRect &rect : region) {
+        const QRect cells = cellsForRect(rect);
+        for (int y = cells.top(); y <= cells.bottom(); ++y) {
+            for (int x = cells.left(); x <= cells.right(); ++x) {
+                const auto it = m_cells.constFind(cellKey(x, y));
+                if (it == m_cells.cend())
+                    continue;
+                for (QSGSoftwareRenderableNode *node : *it) {
+                    if (!found.contains(node) && m_entries.value(node).bounds.intersects(rect))
+                        found.insert(node);
+                }
+            }
+        }
+    }
+
+    QVector<QSGSoftwareRenderableNode *> result;
+    result.reserve(found.size());
+    for (QSGSoftwareRenderableNode *node : std::as_const(found)) {
+        if (m_entries.value(node).renderOrder >= 0)
+            result.append(node);
+    }
+    std::sort(result.begin(), result.end(), [this](QSGSoftwareRenderableNode *a, QSGSoftwareRenderableNode *b) {
+        return m_entries.value(a).renderOrder < m_entries.value(b).renderOrder;
+    });
+    return result;
+}
+
+QT_END_NAMESPACE
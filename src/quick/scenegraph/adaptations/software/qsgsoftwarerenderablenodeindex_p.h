@@ -0,0 +1,61 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSGSOFTWARERENDERABLENODEINDEX_H
+#define QSGSOFTWARERENDERABLENODEINDEX_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QHash>
+#include <QtCore/QRect>
+#include <QtCore/QVector>
+#include <QtGui/QRegion>
+
+QT_BEGIN_NAMESPACE
+
+class QSGSoftwareRenderableNode;
+
+// Uniform grid over the bounding rects of the renderable nodes, so that the
+// nodes affected by a dirty region can be found without visiting all of them.
+class QSGSoftwareRenderableNodeIndex
+{
+public:
+    // Re-reads the node's boundingRectMax()
+    void update(QSGSoftwareRenderableNode *node);
+    void remove(QSGSoftwareRenderableNode *node);
+    void clear();
+
+    // Positions in the render list, used for ordering query results
+    void setRenderOrder(const QVector<QSGSoftwareRenderableNode *> &renderList);
+
+    // Nodes in the render list whose boundingRectMax() intersects region, back to front
+    QVector<QSGSoftwareRenderableNode *> nodesIntersecting(const QRegion &region) const;
+
+private:
+    struct Entry {
+        QRect bounds;
+        QRect cells;
+        int renderOrder = -1;
+    };
+
+    static QRect cellsForRect(const QRect &rect);
+    static quint64 cellKey(int x, int y) { return (quint64(quint32(x)) << 32) | quint32(y); }
+    void insertIntoCells(QSGSoftwareRenderableNode *node, const QRect &cells);
+    void removeFromCells(QSGSoftwareRenderableNode *node, const QRect &cells);
+
+    QHash<QSGSoftwareRenderableNode *, Entry> m_entries;
+    QHash<quint64, QVector<QSGSoftwareRenderableNode *>> m_cells;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGSOFTWARERENDERABLENODEINDEX_H
@@ -97,6 +97,7 @@ bool QSGSoftwareRenderableNodeUpdater::updateRenderableNode(QSGSoftwareRenderabl
     renderableNode->setClipRegion(m_clipState.top(), m_hasClip);
 
     renderableNode->update();
+    m_renderer->renderableNodeUpdated(renderableNode);
     m_stateMap[node] = currentState(node);
 
     return true;
@@ -9,6 +9,11 @@
 
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QtNumeric>
+#if QT_CONFIG(thread)
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#endif
 
 #include <QtGui/QGuiApplication>
 
@@ -27,6 +32,10 @@ Q_QUICK_PRIVATE_EXPORT bool qsg_test_and_clear_material_failure();
 
 int qt_sg_envInt(const char *name, int defaultValue);
 
+#if QT_CONFIG(thread)
+Q_GLOBAL_STATIC(QThreadPool, qsg_uploadThreadPool)
+#endif
+
 namespace QSGBatchRenderer
 {
 
@@ -83,6 +92,13 @@ const float OPAQUE_LIMIT                = 0.999f;
 const uint DYNAMIC_VERTEX_INDEX_BUFFER_THRESHOLD = 4;
 const int VERTEX_BUFFER_BINDING = 0;
 const int ZORDER_BUFFER_BINDING = VERTEX_BUFFER_BINDING + 1;
+const int INSTANCE_BUFFER_BINDING = VERTEX_BUFFER_BINDING + 1;
+
+// Per-instance data of instanced batches: the first two rows of the element's
+// 2D affine transform, with the z order in the fourth component of the first.
+const int INSTANCE_ROW_X_LOCATION = 6;
+const int INSTANCE_ROW_Y_LOCATION = 7;
+const quint32 INSTANCE_DATA_SIZE = 8 * sizeof(float);
 
 template <class Int>
 inline Int aligned(Int v, Int byteAlign)
@@ -159,6 +175,25 @@ static QRhiVertexInputLayout calculateVertexInputLayout(const QSGMaterialShader
     return inputLayout;
 }
 
+static QRhiVertexInputLayout calculateInstancedVertexInputLayout(const QSGMaterialShader *s, const QSGGeometry *geometry)
+{
+    QRhiVertexInputLayout inputLayout = calculateVertexInputLayout(s, geometry, false);
+
+    QVarLengthArray<QRhiVertexInputAttribute, 8> inputAttributes(inputLayout.cbeginAttributes(), inputLayout.cendAttributes());
+    inputAttributes.append(QRhiVertexInputAttribute(INSTANCE_BUFFER_BINDING, INSTANCE_ROW_X_LOCATION,
+                                                    QRhiVertexInputAttribute::Float4, 0));
+    inputAttributes.append(QRhiVertexInputAttribute(INSTANCE_BUFFER_BINDING, INSTANCE_ROW_Y_LOCATION,
+                                                    QRhiVertexInputAttribute::Float4, 4 * sizeof(float)));
+
+    QVarLengthArray<QRhiVertexInputBinding, 2> inputBindings(inputLayout.cbeginBindings(), inputLayout.cendBindings());
+    inputBindings.append(QRhiVertexInputBinding(INSTANCE_DATA_SIZE, QRhiVertexInputBinding::PerInstance));
+
+    inputLayout.setBindings(inputBindings.cbegin(), inputBindings.cend());
+    inputLayout.setAttributes(inputAttributes.cbegin(), inputAttributes.cend());
+
+    return inputLayout;
+}
+
 QRhiCommandBuffer::IndexFormat qsg_indexFormat(const QSGGeometry *geometry)
 {
     switch (geometry->indexType()) {
@@ -257,12 +292,53 @@ ShaderManager::Shader *ShaderManager::prepareMaterialNoRewrite(QSGMaterial *mate
     return shader;
 }
 
+/* Returns the shader for drawing instanced batches of the material, or null
+ * when the material's shader does not provide an instanced vertex shader.
+ * Only some of the built-in materials do.
+ */
+ShaderManager::Shader *ShaderManager::prepareMaterialInstanced(QSGMaterial *material,
+                                                               const QSGGeometry *geometry,
+                                                               QSGRendererInterface::RenderMode renderMode)
+{
+    QSGMaterialType *type = material->type();
+
+    ShaderKey key = qMakePair(type, renderMode);
+    auto it = instancedShaders.constFind(key);
+    if (it != instancedShaders.cend())
+        return it.value();
+
+    QSGMaterialShader *s = static_cast<QSGMaterialShader *>(material->createShader(renderMode));
+    QSGMaterialShaderPrivate *sD = QSGMaterialShaderPrivate::get(s);
+    if (sD->instancedVertexShaderFileName.isEmpty()) {
+        delete s;
+        instancedShaders.insert(key, nullptr);
+        return nullptr;
+    }
+
+    Shader *shader = new Shader;
+    sD->shaderFileNames[QShader::VertexStage] = sD->instancedVertexShaderFileName;
+    context->initializeRhiShader(s, QShader::StandardShader);
+    shader->programRhi.program = s;
+    shader->programRhi.inputLayout = calculateInstancedVertexInputLayout(s, geometry);
+    shader->programRhi.shaderStages = {
+        { QRhiGraphicsShaderStage::Vertex, sD->shader(QShader::VertexStage) },
+        { QRhiGraphicsShaderStage::Fragment, sD->shader(QShader::FragmentStage) }
+    };
+
+    shader->lastOpacity = 0;
+
+    instancedShaders[key] = shader;
+    return shader;
+}
+
 void ShaderManager::invalidated()
 {
     qDeleteAll(stockShaders);
     stockShaders.clear();
     qDeleteAll(rewrittenShaders);
     rewrittenShaders.clear();
+    qDeleteAll(instancedShaders);
+    instancedShaders.clear();
 
     qDeleteAll(pipelineCache);
     pipelineCache.clear();
@@ -287,6 +363,13 @@ void ShaderManager::clearCachedRendererData()
             sd->clearCachedRendererData();
         }
     }
+    for (ShaderManager::Shader *sms : qAsConst(instancedShaders)) {
+        QSGMaterialShader *s = sms ? sms->programRhi.program : nullptr;
+        if (s) {
+            QSGMaterialShaderPrivate *sd = QSGMaterialShaderPrivate::get(s);
+            sd->clearCachedRendererData();
+        }
+    }
 }
 
 void qsg_dumpShadowRoots(BatchRootInfo *i, int indent)
@@ -876,16 +959,36 @@ Renderer::Renderer(QSGDefaultRenderContext *ctx, QSGRendererInterface::RenderMod
     m_batchNodeThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_NODE_THRESHOLD", 64);
     m_batchVertexThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_VERTEX_THRESHOLD", 1024);
     m_srbPoolThreshold = qt_sg_envInt("QSG_RENDERER_SRB_POOL_THRESHOLD", 1024);
+    const quint32 bufferBlockSize = qMax(qt_sg_envInt("QSG_RENDERER_BUFFER_BLOCK_SIZE", 1024 * 1024), 4096);
+    for (int isIndexBuf = 0; isIndexBuf < 2; ++isIndexBuf) {
+        const QRhiBuffer::UsageFlags usage = isIndexBuf ? QRhiBuffer::IndexBuffer : QRhiBuffer::VertexBuffer;
+        // Index data is usually a fraction of the vertex data
+        const quint32 blockSize = isIndexBuf ? bufferBlockSize / 4 : bufferBlockSize;
+        m_bufferArenas[isIndexBuf][0].init(QRhiBuffer::Immutable, usage, blockSize);
+        m_bufferArenas[isIndexBuf][1].init(QRhiBuffer::Dynamic, usage, blockSize);
+    }
+    m_instancingThreshold = m_rhi->isFeatureSupported(QRhi::Instancing)
+            ? qt_sg_envInt("QSG_RENDERER_INSTANCING_THRESHOLD", 16) : 0;
+#if QT_CONFIG(thread)
+    m_uploadThreadCount = qt_sg_envInt("QSG_RENDERER_UPLOAD_THREADS", qMin(QThread::idealThreadCount(), 4));
+    m_parallelUploadVertexThreshold = qt_sg_envInt("QSG_RENDERER_PARALLEL_UPLOAD_THRESHOLD", 16384);
+#endif
 
     if (Q_UNLIKELY(debug_build() || debug_render())) {
-        qDebug("Batch thresholds: nodes: %d vertices: %d Srb pool threshold: %d",
-               m_batchNodeThreshold, m_batchVertexThreshold, m_srbPoolThreshold);
+        qDebug("Batch thresholds: nodes: %d vertices: %d Srb pool threshold: %d instancing: %d",
+               m_batchNodeThreshold, m_batchVertexThreshold, m_srbPoolThreshold, m_instancingThreshold);
+        qDebug("Buffer block size: %u bytes", bufferBlockSize);
+#if QT_CONFIG(thread)
+        qDebug("Upload threads: %d, parallel upload threshold: %d vertices",
+               m_uploadThreadCount, m_parallelUploadVertexThreshold);
+#endif
     }
 }
 
 static void qsg_wipeBuffer(Buffer *buffer)
 {
-    delete buffer->buf;
+    if (buffer->block)
+        buffer->block->arena->release(buffer);
 
     // The free here is ok because we're in one of two situations.
     // 1. We're using the upload pool in which case unmap will have set the
@@ -955,17 +1058,209 @@ void Renderer::releaseCachedResources()
 
     m_vertexUploadPool.resize(0);
     m_indexUploadPool.resize(0);
+
+    for (auto &arenas : m_bufferArenas) {
+        for (BufferArena &arena : arenas)
+            arena.releaseUnusedBlocks();
+    }
 }
 
 void Renderer::invalidateAndRecycleBatch(Batch *b)
 {
     b->invalidate();
+    // Give the space back to the arenas, the batch is rebuilt from scratch
+    // when it gets reused
+    if (b->vbo.block)
+        b->vbo.block->arena->release(&b->vbo);
+    if (b->ibo.block)
+        b->ibo.block->arena->release(&b->ibo);
     for (int i=0; i<m_batchPool.size(); ++i)
         if (b == m_batchPool.at(i))
             return;
     m_batchPool.add(b);
 }
 
+BufferArena::~BufferArena()
+{
+    for (BufferArenaBlock *block : std::as_const(m_blocks)) {
+        delete block->buf;
+        delete block;
+    }
+}
+
+void BufferArena::init(QRhiBuffer::Type type, QRhiBuffer::UsageFlags usage, quint32 blockSize)
+{
+    m_type = type;
+    m_usage = usage;
+    m_blockSize = blockSize;
+}
+
+// Ranges are kept 16 byte aligned, and rounded up to 256 bytes so that
+// batches can grow a little without moving.
+static inline quint32 qsg_arenaRangeSize(quint32 size)
+{
+    return aligned(size, quint32(256));
+}
+
+bool BufferArena::allocate(QRhi *rhi, Buffer *buffer, quint32 size)
+{
+    // Nothing to upload, for instance the index data of batches drawn
+    // without indices; don't hold on to a range for it.
+    if (size == 0) {
+        if (buffer->block)
+            buffer->block->arena->release(buffer);
+        return true;
+    }
+
+    if (buffer->block) {
+        if (buffer->block->arena == this) {
+            if (size <= buffer->capacity || growInPlace(buffer, qsg_arenaRangeSize(size)))
+                return true;
+        }
+        buffer->block->arena->release(buffer);
+    }
+
+    const quint32 rangeSize = qsg_arenaRangeSize(size);
+    for (BufferArenaBlock *block : std::as_const(m_blocks)) {
+        if (allocateFromBlock(block, buffer, rangeSize))
+            return true;
+    }
+
+    BufferArenaBlock *block = createBlock(rhi, qMax(rangeSize, m_blockSize));
+    return block && allocateFromBlock(block, buffer, rangeSize);
+}
+
+void BufferArena::release(Buffer *buffer)
+{
+    BufferArenaBlock *block = buffer->block;
+    Q_ASSERT(block && block->arena == this);
+
+    quint32 offset = buffer->offset;
+    quint32 size = buffer->capacity;
+
+    // Merge with the neighboring free ranges
+    auto next = block->freeRanges.find(offset + size);
+    if (next != block->freeRanges.end()) {
+        size += next.value();
+        block->freeRanges.erase(next);
+    }
+    auto it = block->freeRanges.lowerBound(offset);
+    if (it != block->freeRanges.begin()) {
+        auto prev = std::prev(it);
+        if (prev.key() + prev.value() == offset) {
+            offset = prev.key();
+            size += prev.value();
+            block->freeRanges.erase(prev);
+        }
+    }
+    block->freeRanges.insert(offset, size);
+    block->usedBytes -= buffer->capacity;
+
+    buffer->buf = nullptr;
+    buffer->block = nullptr;
+    buffer->offset = 0;
+    buffer->capacity = 0;
+
+    // Blocks made for a single large buffer are not worth keeping around
+    if (block->usedBytes == 0 && block->buf->size() > m_blockSize)
+        destroyBlock(block);
+}
+
+void BufferArena::releaseUnusedBlocks()
+{
+    for (int i = m_blocks.size() - 1; i >= 0; --i) {
+        if (m_blocks.at(i)->usedBytes == 0)
+            destroyBlock(m_blocks.at(i));
+    }
+}
+
+quint64 BufferArena::totalBytes() const
+{
+    quint64 bytes = 0;
+    for (const BufferArenaBlock *block : m_blocks)
+        bytes += block->buf->size();
+    return bytes;
+}
+
+quint64 BufferArena::usedBytes() const
+{
+    quint64 bytes = 0;
+    for (const BufferArenaBlock *block : m_blocks)
+        bytes += block->usedBytes;
+    return bytes;
+}
+
+int BufferArena::takeCreatedBlockCount()
+{
+    return std::exchange(m_createdBlockCount, 0);
+}
+
+BufferArenaBlock *BufferArena::createBlock(QRhi *rhi, quint32 size)
+{
+    QRhiBuffer *buf = rhi->newBuffer(m_type, m_usage, size);
+    if (!buf->create()) {
+        qWarning("Failed to build vertex/index buffer of size %u", size);
+        delete buf;
+        return nullptr;
+    }
+
+    BufferArenaBlock *block = new BufferArenaBlock;
+    block->arena = this;
+    block->buf = buf;
+    block->freeRanges.insert(0, size);
+    block->usedBytes = 0;
+    m_blocks.append(block);
+    ++m_createdBlockCount;
+    return block;
+}
+
+void BufferArena::destroyBlock(BufferArenaBlock *block)
+{
+    Q_ASSERT(block->usedBytes == 0);
+    m_blocks.removeOne(block);
+    delete block->buf;
+    delete block;
+}
+
+bool BufferArena::allocateFromBlock(BufferArenaBlock *block, Buffer *buffer, quint32 size)
+{
+    // First fit
+    for (auto it = block->freeRanges.begin(), end = block->freeRanges.end(); it != end; ++it) {
+        if (it.value() < size)
+            continue;
+        const quint32 offset = it.key();
+        const quint32 remaining = it.value() - size;
+        block->freeRanges.erase(it);
+        if (remaining)
+            block->freeRanges.insert(offset + size, remaining);
+        block->usedBytes += size;
+
+        buffer->buf = block->buf;
+        buffer->block = block;
+        buffer->offset = offset;
+        buffer->capacity = size;
+        return true;
+    }
+    return false;
+}
+
+bool BufferArena::growInPlace(Buffer *buffer, quint32 size)
+{
+    BufferArenaBlock *block = buffer->block;
+    auto next = block->freeRanges.find(buffer->offset + buffer->capacity);
+    if (next == block->freeRanges.end() || buffer->capacity + next.value() < size)
+        return false;
+
+    const quint32 extra = size - buffer->capacity;
+    const quint32 remaining = next.value() - extra;
+    block->freeRanges.erase(next);
+    if (remaining)
+        block->freeRanges.insert(buffer->offset + size, remaining);
+    block->usedBytes += extra;
+    buffer->capacity = size;
+    return true;
+}
+
 void Renderer::map(Buffer *buffer, quint32 byteSize, bool isIndexBuf)
 {
     if (m_visualizer->mode() == Visualizer::VisualizeNothing) {
@@ -985,47 +1280,24 @@ void Renderer::map(Buffer *buffer, quint32 byteSize, bool isIndexBuf)
 
 void Renderer::unmap(Buffer *buffer, bool isIndexBuf)
 {
-    // Batches are pooled and reused which means the QRhiBuffer will be
-    // still valid in a recycled Batch. We only hit the newBuffer() path
-    // for brand new Batches.
-    if (!buffer->buf) {
-        buffer->buf = m_rhi->newBuffer(QRhiBuffer::Immutable,
-                                       isIndexBuf ? QRhiBuffer::IndexBuffer : QRhiBuffer::VertexBuffer,
-                                       buffer->size);
-        if (!buffer->buf->create()) {
-            qWarning("Failed to build vertex/index buffer of size %u", buffer->size);
-            delete buffer->buf;
-            buffer->buf = nullptr;
-        }
-    } else {
-        bool needsRebuild = false;
-        if (buffer->buf->size() < buffer->size) {
-            buffer->buf->setSize(buffer->size);
-            needsRebuild = true;
-        }
-        if (buffer->buf->type() != QRhiBuffer::Dynamic
-                && buffer->nonDynamicChangeCount > DYNAMIC_VERTEX_INDEX_BUFFER_THRESHOLD)
-        {
-            buffer->buf->setType(QRhiBuffer::Dynamic);
-            buffer->nonDynamicChangeCount = 0;
-            needsRebuild = true;
-        }
-        if (needsRebuild) {
-            if (!buffer->buf->create()) {
-                qWarning("Failed to (re)build vertex/index buffer of size %u", buffer->size);
-                delete buffer->buf;
-                buffer->buf = nullptr;
-            }
-        }
-    }
-    if (buffer->buf) {
-        if (buffer->buf->type() != QRhiBuffer::Dynamic) {
-            m_resourceUpdates->uploadStaticBuffer(buffer->buf,
-                                                 0, buffer->size, buffer->data);
+    // The data goes into a range of one of the arena buffers. Buffers that
+    // keep changing move over to the arena of dynamic buffers.
+    bool dynamic = buffer->block && buffer->block->arena->type() == QRhiBuffer::Dynamic;
+    if (!dynamic && buffer->nonDynamicChangeCount > DYNAMIC_VERTEX_INDEX_BUFFER_THRESHOLD) {
+        dynamic = true;
+        buffer->nonDynamicChangeCount = 0;
+    }
+    m_bufferArenas[isIndexBuf][dynamic].allocate(m_rhi, buffer, buffer->size);
+
+    if (buffer->buf && buffer->size) {
+        m_frame_statistics.uploadedBytes += buffer->size;
+        if (!dynamic) {
+            m_resourceUpdates->uploadStaticBuffer(buffer->buf, buffer->offset,
+                                                 buffer->size, buffer->data);
             buffer->nonDynamicChangeCount += 1;
         } else {
-            m_resourceUpdates->updateDynamicBuffer(buffer->buf, 0, buffer->size,
-                                                   buffer->data);
+            m_resourceUpdates->updateDynamicBuffer(buffer->buf, buffer->offset,
+                                                   buffer->size, buffer->data);
         }
     }
     if (m_visualizer->mode() == Visualizer::VisualizeNothing)
@@ -1954,21 +2226,42 @@ QMatrix4x4 qsg_matrixForRoot(Node *node)
 }
 
 void Renderer::uploadBatch(Batch *b)
+{
+    quint32 bufferSize = 0;
+    quint32 ibufferSize = 0;
+    if (!prepareBatchUpload(b, &bufferSize, &ibufferSize))
+        return;
+
+    map(&b->ibo, ibufferSize, true);
+    map(&b->vbo, bufferSize);
+
+    writeBatchData(b);
+    finishBatchUpload(b);
+}
+
+/* Batch uploads are done in three steps. prepareBatchUpload() decides on
+ * merging and calculates the buffer sizes, writeBatchData() fills the mapped
+ * buffers and finishBatchUpload() hands them over to the QRhi. Only the
+ * middle step is expensive, and it touches nothing but the batch itself and
+ * the (read-only) geometry of its elements, so different batches can be
+ * written concurrently.
+ */
+bool Renderer::prepareBatchUpload(Batch *b, quint32 *vertexBufferSize, quint32 *indexBufferSize)
 {
     // Early out if nothing has changed in this batch..
     if (!b->needsUpload) {
         if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "already uploaded...";
-        return;
+        return false;
     }
 
     if (!b->first) {
         if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "is invalid...";
-        return;
+        return false;
     }
 
     if (b->isRenderNode) {
         if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch: " << b << "is a render node...";
-        return;
+        return false;
     }
 
     // Figure out if we can merge or not, if not, then just render the batch as is..
@@ -1987,6 +2280,21 @@ void Renderer::uploadBatch(Batch *b)
             && b->isSafeToBatch();
 
     b->merged = canMerge;
+    b->instanced = canMerge && canInstanceBatch(b);
+
+    if (b->instanced) {
+        // One copy of the geometry, drawn once per element
+        b->vertexCount = g->vertexCount();
+        b->indexCount = g->indexCount() ? g->indexCount() : g->vertexCount();
+        if (g->drawingMode() != QSGGeometry::DrawTriangleStrip)
+            b->indexCount = qsg_fixIndexCount(b->indexCount, g->drawingMode());
+        if (b->vertexCount == 0 || b->indexCount == 0)
+            return false;
+        b->instanceDataOffset = aligned(quint32(b->vertexCount * g->sizeOfVertex()), quint32(16));
+        *vertexBufferSize = b->instanceDataOffset + b->instanceCount * INSTANCE_DATA_SIZE;
+        *indexBufferSize = b->indexCount * mergedIndexElemSize();
+        return true;
+    }
 
     // Figure out how much memory we need...
     b->vertexCount = 0;
@@ -2013,7 +2321,7 @@ void Renderer::uploadBatch(Batch *b)
     // Abort if there are no vertices in this batch.. We abort this late as
     // this is a broken usecase which we do not care to optimize for...
     if (b->vertexCount == 0 || (b->merged && b->indexCount == 0))
-        return;
+        return false;
 
     /* Allocate memory for this batch. Merged batches are divided into three separate blocks
            1. Vertex data for all elements, as they were in the QSGGeometry object, but
@@ -2037,21 +2345,30 @@ void Renderer::uploadBatch(Batch *b)
         ibufferSize = unmergedIndexSize;
     }
 
-    map(&b->ibo, ibufferSize, true);
-    map(&b->vbo, bufferSize);
+    *vertexBufferSize = bufferSize;
+    *indexBufferSize = ibufferSize;
+    return true;
+}
+
+void Renderer::writeBatchData(Batch *b)
+{
+    QSGGeometry *g = b->first->node->geometry();
 
     if (Q_UNLIKELY(debug_upload())) qDebug() << " - batch" << b << " first:" << b->first << " root:"
-                                             << b->root << " merged:" << b->merged << " positionAttribute" << b->positionAttribute
+                                             << b->root << " merged:" << b->merged << " instanced:" << b->instanced
+                                             << " positionAttribute" << b->positionAttribute
                                              << " vbo:" << b->vbo.buf << ":" << b->vbo.size;
 
-    if (b->merged) {
+    if (b->instanced) {
+        writeInstancedBatchData(b);
+    } else if (b->merged) {
         char *vertexData = b->vbo.data;
         char *zData = vertexData + b->vertexCount * g->sizeOfVertex();
         char *indexData = b->ibo.data;
 
         quint16 iOffset16 = 0;
         quint32 iOffset32 = 0;
-        e = b->first;
+        Element *e = b->first;
         uint verticesInSet = 0;
         // Start a new set already after 65534 vertices because 0xFFFF may be
         // used for an always-on primitive restart with some apis (adapt for
@@ -2147,7 +2464,7 @@ void Renderer::uploadBatch(Batch *b)
                 dump << ") ";
                 offset += attr.tupleSize * size_of_type(attr.type);
             }
-            if (b->merged && useDepthBuffer()) {
+            if (b->merged && !b->instanced && useDepthBuffer()) {
                 float zorder = ((float*)(b->vbo.data + b->vertexCount * g->sizeOfVertex()))[i];
                 dump << " Z:(" << zorder << ")";
             }
@@ -2186,7 +2503,90 @@ void Renderer::uploadBatch(Batch *b)
         }
     }
 #endif // QT_NO_DEBUG_OUTPUT
+}
+
+/* A batch can be drawn instanced when it would be merged, and all its elements
+ * share the same geometry data, so that only the transform and z order differ
+ * between them. Those are the only per-element state of a merged batch; the
+ * material and opacity are the same for the whole batch already.
+ */
+bool Renderer::canInstanceBatch(Batch *b)
+{
+    if (m_instancingThreshold <= 0
+            || m_renderMode != QSGRendererInterface::RenderMode2D
+            || !useDepthBuffer()
+            || m_visualizer->mode() != Visualizer::VisualizeNothing
+            || b->positionAttribute != 0)
+        return false;
+
+    b->instanceCount = qsg_countNodesInBatch(b);
+    if (b->instanceCount < m_instancingThreshold)
+        return false;
+
+    QSGGeometryNode *gn = b->first->node;
+    const QSGGeometry *g = gn->geometry();
+    const int vertexBytes = g->vertexCount() * g->sizeOfVertex();
+    const int indexBytes = g->indexCount() * g->sizeOfIndex();
+    for (Element *e = b->first->nextInBatch; e; e = e->nextInBatch) {
+        const QSGGeometry *eg = e->node->geometry();
+        if (eg == g)
+            continue;
+        if (eg->vertexCount() != g->vertexCount()
+                || eg->indexCount() != g->indexCount()
+                || eg->sizeOfVertex() != g->sizeOfVertex()
+                || eg->indexType() != g->indexType()
+                || eg->drawingMode() != g->drawingMode()
+                || memcmp(eg->vertexData(), g->vertexData(), vertexBytes) != 0
+                || memcmp(eg->indexData(), g->indexData(), indexBytes) != 0)
+            return false;
+    }
+
+    return m_shaderManager->prepareMaterialInstanced(gn->activeMaterial(), g, m_renderMode) != nullptr;
+}
+
+void Renderer::writeInstancedBatchData(Batch *b)
+{
+    QSGGeometry *g = b->first->node->geometry();
+    const int vCount = g->vertexCount();
+    memcpy(b->vbo.data, g->vertexData(), vCount * g->sizeOfVertex());
 
+    // Indices are never rebased, every instance starts over at vertex 0
+    const int srcCount = g->indexCount();
+    const quint16 *srcIndices = g->indexDataAsUShort();
+    if (m_uint32IndexForRhi) {
+        quint32 *indices = (quint32 *) b->ibo.data;
+        for (int i = 0; i < b->indexCount; ++i)
+            indices[i] = srcCount ? srcIndices[i] : i;
+    } else if (srcCount) {
+        memcpy(b->ibo.data, srcIndices, b->indexCount * sizeof(quint16));
+    } else {
+        quint16 *indices = (quint16 *) b->ibo.data;
+        for (int i = 0; i < b->indexCount; ++i)
+            indices[i] = i;
+    }
+
+    float *instanceData = (float *) (b->vbo.data + b->instanceDataOffset);
+    for (Element *e = b->first; e; e = e->nextInBatch) {
+        const float *m = e->node->matrix()->constData();
+        instanceData[0] = m[0];
+        instanceData[1] = m[4];
+        instanceData[2] = m[12];
+        instanceData[3] = 1.0f - e->order * m_zRange;
+        instanceData[4] = m[1];
+        instanceData[5] = m[5];
+        instanceData[6] = m[13];
+        instanceData[7] = 0.0f;
+        instanceData += INSTANCE_DATA_SIZE / sizeof(float);
+    }
+
+    b->drawSets.reset();
+    DrawSet set(0, int(b->instanceDataOffset), 0);
+    set.indexCount = b->indexCount;
+    b->drawSets << set;
+}
+
+void Renderer::finishBatchUpload(Batch *b)
+{
     unmap(&b->vbo);
     unmap(&b->ibo, true);
 
@@ -2198,6 +2598,105 @@ void Renderer::uploadBatch(Batch *b)
         b->uploadedThisFrame = true;
 }
 
+#if QT_CONFIG(thread)
+/* Uploads all opaque and alpha batches, writing the vertex and index data of
+ * different batches on several threads. Each batch gets its own slice of the
+ * upload pools instead of reusing the start of them, which is what makes the
+ * writes independent. Only used with the upload pools, i.e. when not
+ * visualizing.
+ */
+void Renderer::uploadBatchesConcurrently(quint32 *largestVBO, quint32 *largestIBO)
+{
+    struct PendingUpload {
+        Batch *batch;
+        quint32 vertexOffset;
+        quint32 indexOffset;
+    };
+    QVarLengthArray<PendingUpload, 64> pending;
+    quint32 vertexBytes = 0;
+    quint32 indexBytes = 0;
+    qint64 vertexCount = 0;
+
+    // Slices are 16 byte aligned, so that each batch starts out as if it
+    // had the pool to itself
+    auto alignedSize = [](quint32 size) { return (size + 15) & ~quint32(15); };
+
+    auto prepare = [&](Batch *b) {
+        *largestVBO = qMax(b->vbo.size, *largestVBO);
+        *largestIBO = qMax(b->ibo.size, *largestIBO);
+        quint32 bufferSize = 0;
+        quint32 ibufferSize = 0;
+        if (!prepareBatchUpload(b, &bufferSize, &ibufferSize))
+            return;
+        b->vbo.size = bufferSize;
+        b->ibo.size = ibufferSize;
+        pending.append({ b, vertexBytes, indexBytes });
+        vertexBytes += alignedSize(bufferSize);
+        indexBytes += alignedSize(ibufferSize);
+        vertexCount += b->vertexCount;
+    };
+    for (int i = 0; i < m_opaqueBatches.size(); ++i)
+        prepare(m_opaqueBatches.at(i));
+    for (int i = 0; i < m_alphaBatches.size(); ++i)
+        prepare(m_alphaBatches.at(i));
+
+    if (pending.isEmpty())
+        return;
+
+    m_vertexUploadPool.resize(vertexBytes);
+    m_indexUploadPool.resize(indexBytes);
+    for (const PendingUpload &upload : std::as_const(pending)) {
+        upload.batch->vbo.data = m_vertexUploadPool.data() + upload.vertexOffset;
+        upload.batch->ibo.data = m_indexUploadPool.data() + upload.indexOffset;
+    }
+    *largestVBO = qMax(vertexBytes, *largestVBO);
+    *largestIBO = qMax(indexBytes, *largestIBO);
+
+    const int taskCount = vertexCount < m_parallelUploadVertexThreshold
+            ? 1 : qMin(m_uploadThreadCount, int(pending.size()));
+    if (taskCount <= 1) {
+        for (const PendingUpload &upload : std::as_const(pending))
+            writeBatchData(upload.batch);
+    } else {
+        // Split the batches into contiguous ranges with roughly the same
+        // number of vertices each
+        QVarLengthArray<int, 16> rangeEnds;
+        const qint64 verticesPerTask = (vertexCount + taskCount - 1) / taskCount;
+        qint64 verticesInRange = 0;
+        for (int i = 0; i < pending.size(); ++i) {
+            verticesInRange += pending.at(i).batch->vertexCount;
+            if (verticesInRange >= verticesPerTask && rangeEnds.size() < taskCount - 1) {
+                rangeEnds.append(i + 1);
+                verticesInRange = 0;
+            }
+        }
+        if (rangeEnds.isEmpty() || rangeEnds.last() != pending.size())
+            rangeEnds.append(pending.size());
+
+        auto writeRange = [this, &pending](int begin, int end) {
+            for (int i = begin; i < end; ++i)
+                writeBatchData(pending.at(i).batch);
+        };
+
+        QSemaphore rangesWritten;
+        for (int r = 1; r < rangeEnds.size(); ++r) {
+            const int begin = rangeEnds.at(r - 1);
+            const int end = rangeEnds.at(r);
+            qsg_uploadThreadPool()->start([&writeRange, &rangesWritten, begin, end] {
+                writeRange(begin, end);
+                rangesWritten.release();
+            });
+        }
+        writeRange(0, rangeEnds.first());
+        rangesWritten.acquire(rangeEnds.size() - 1);
+    }
+
+    // QRhi resource updates have to stay on the render thread
+    for (const PendingUpload &upload : std::as_const(pending))
+        finishBatchUpload(upload.batch);
+}
+#endif
+
 void Renderer::applyClipStateToGraphicsState()
 {
     m_gstate.usesScissor = (m_currentClipState.type & ClipState::ScissorClip);
@@ -3044,7 +3543,7 @@ bool Renderer::prepareRenderMergedBatch(Batch *batch, PreparedRenderBatch *rende
               << (batch->uploadedThisFrame ? "[  upload]" : "[retained]")
               << (e->node->clipList() ? "[  clip]" : "[noclip]")
               << (batch->isOpaque ? "[opaque]" : "[ alpha]")
-              << "[  merged]"
+              << (batch->instanced ? "[instanced]" : "[  merged]")
               << " Nodes:" << QString::fromLatin1("%1").arg(qsg_countNodesInBatch(batch), 4).toLatin1().constData()
               << " Vertices:" << QString::fromLatin1("%1").arg(batch->vertexCount, 5).toLatin1().constData()
               << " Indices:" << QString::fromLatin1("%1").arg(batch->indexCount, 5).toLatin1().constData()
@@ -3074,8 +3573,13 @@ bool Renderer::prepareRenderMergedBatch(Batch *batch, PreparedRenderBatch *rende
         updateClipState(gn->clipList(), batch);
 
     const QSGGeometry *g = gn->geometry();
-    ShaderManager::Shader *sms = useDepthBuffer() ? m_shaderManager->prepareMaterial(material, g, m_renderMode)
-                                                  : m_shaderManager->prepareMaterialNoRewrite(material, g, m_renderMode);
+    ShaderManager::Shader *sms = nullptr;
+    if (batch->instanced)
+        sms = m_shaderManager->prepareMaterialInstanced(material, g, m_renderMode);
+    else if (useDepthBuffer())
+        sms = m_shaderManager->prepareMaterial(material, g, m_renderMode);
+    else
+        sms = m_shaderManager->prepareMaterialNoRewrite(material, g, m_renderMode);
     if (!sms)
         return false;
 
@@ -3203,16 +3707,18 @@ void Renderer::renderMergedBatch(PreparedRenderBatch *renderBatch, bool depthPos
     QRhiCommandBuffer *cb = renderTarget().cb;
     setGraphicsPipeline(cb, batch, e, depthPostPass);
 
+    // For instanced batches the second binding is the per-instance data
+    // instead of the z order.
     for (int i = 0, ie = batch->drawSets.size(); i != ie; ++i) {
         const DrawSet &draw = batch->drawSets.at(i);
         const QRhiCommandBuffer::VertexInput vbufBindings[] = {
-            { batch->vbo.buf, quint32(draw.vertices) },
-            { batch->vbo.buf, quint32(draw.zorders) }
+            { batch->vbo.buf, batch->vbo.offset + quint32(draw.vertices) },
+            { batch->vbo.buf, batch->vbo.offset + quint32(draw.zorders) }
         };
         cb->setVertexInput(VERTEX_BUFFER_BINDING, useDepthBuffer() ? 2 : 1, vbufBindings,
-                           batch->ibo.buf, draw.indices,
+                           batch->ibo.buf, batch->ibo.offset + draw.indices,
                            m_uint32IndexForRhi ? QRhiCommandBuffer::IndexUInt32 : QRhiCommandBuffer::IndexUInt16);
-        cb->drawIndexed(draw.indexCount);
+        cb->drawIndexed(draw.indexCount, batch->instanced ? batch->instanceCount : 1);
     }
 }
 
@@ -3395,8 +3901,8 @@ void Renderer::renderUnmergedBatch(PreparedRenderBatch *renderBatch, bool depthP
     if (batch->clipState.type & ClipState::StencilClip)
         enqueueStencilDraw(batch);
 
-    quint32 vOffset = 0;
-    quint32 iOffset = 0;
+    quint32 vOffset = batch->vbo.offset;
+    quint32 iOffset = batch->ibo.offset;
     QRhiCommandBuffer *cb = renderTarget().cb;
 
     while (e) {
@@ -3536,6 +4042,11 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     if (ctx->valid)
         qWarning("prepareRenderPass() called with an already prepared render pass context");
 
+    QElapsedTimer statisticsTimer;
+    statisticsTimer.start();
+    m_frame_statistics.uploadedBytes = 0;
+    m_frame_statistics.recordTime = 0;
+
     ctx->valid = true;
 
     if (Q_UNLIKELY(debug_dump())) {
@@ -3609,6 +4120,10 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
         prepareAlphaBatches();
         if (Q_UNLIKELY(debug_render())) ctx->timePrepareAlpha = ctx->timer.restart();
 
+        // Only changes when the batches are rebuilt, keep it off the common path.
+        m_frame_statistics.nodeCount = qsg_countNodesInBatches(m_opaqueBatches)
+                                     + qsg_countNodesInBatches(m_alphaBatches);
+
         if (Q_UNLIKELY(debug_build())) {
             qDebug("Opaque Batches:");
             for (int i=0; i<m_opaqueBatches.size(); ++i) {
@@ -3654,23 +4169,34 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     quint32 largestVBO = 0;
     quint32 largestIBO = 0;
 
-    if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Opaque Batches:");
-    for (int i=0; i<m_opaqueBatches.size(); ++i) {
-        Batch *b = m_opaqueBatches.at(i);
-        largestVBO = qMax(b->vbo.size, largestVBO);
-        largestIBO = qMax(b->ibo.size, largestIBO);
-        uploadBatch(b);
-    }
-    if (Q_UNLIKELY(debug_render())) ctx->timeUploadOpaque = ctx->timer.restart();
+#if QT_CONFIG(thread)
+    if (m_uploadThreadCount > 1 && m_visualizer->mode() == Visualizer::VisualizeNothing
+            && !debug_upload()) {
+        // The per-batch timings are not meaningful here, report all of it as opaque
+        uploadBatchesConcurrently(&largestVBO, &largestIBO);
+        if (Q_UNLIKELY(debug_render())) ctx->timeUploadOpaque = ctx->timer.restart();
+        if (Q_UNLIKELY(debug_render())) ctx->timeUploadAlpha = ctx->timer.restart();
+    } else
+#endif
+    {
+        if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Opaque Batches:");
+        for (int i=0; i<m_opaqueBatches.size(); ++i) {
+            Batch *b = m_opaqueBatches.at(i);
+            largestVBO = qMax(b->vbo.size, largestVBO);
+            largestIBO = qMax(b->ibo.size, largestIBO);
+            uploadBatch(b);
+        }
+        if (Q_UNLIKELY(debug_render())) ctx->timeUploadOpaque = ctx->timer.restart();
 
-    if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Alpha Batches:");
-    for (int i=0; i<m_alphaBatches.size(); ++i) {
-        Batch *b = m_alphaBatches.at(i);
-        uploadBatch(b);
-        largestVBO = qMax(b->vbo.size, largestVBO);
-        largestIBO = qMax(b->ibo.size, largestIBO);
+        if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Alpha Batches:");
+        for (int i=0; i<m_alphaBatches.size(); ++i) {
+            Batch *b = m_alphaBatches.at(i);
+            uploadBatch(b);
+            largestVBO = qMax(b->vbo.size, largestVBO);
+            largestIBO = qMax(b->ibo.size, largestIBO);
+        }
+        if (Q_UNLIKELY(debug_render())) ctx->timeUploadAlpha = ctx->timer.restart();
     }
-    if (Q_UNLIKELY(debug_render())) ctx->timeUploadAlpha = ctx->timer.restart();
 
     m_vertexUploadPool.resize(largestVBO);
     m_indexUploadPool.resize(largestIBO);
@@ -3679,6 +4205,15 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
         qDebug().nospace() << "Rendering:" << Qt::endl
                            << " -> Opaque: " << qsg_countNodesInBatches(m_opaqueBatches) << " nodes in " << m_opaqueBatches.size() << " batches..." << Qt::endl
                            << " -> Alpha: " << qsg_countNodesInBatches(m_alphaBatches) << " nodes in " << m_alphaBatches.size() << " batches...";
+        for (int isIndexBuf = 0; isIndexBuf < 2; ++isIndexBuf) {
+            for (int dynamic = 0; dynamic < 2; ++dynamic) {
+                BufferArena &arena = m_bufferArenas[isIndexBuf][dynamic];
+                qDebug().nospace() << " -> " << (dynamic ? "Dynamic " : "Static ") << (isIndexBuf ? "index" : "vertex")
+                                   << " buffers: " << arena.usedBytes() << " of " << arena.totalBytes()
+                                   << " bytes used in " << arena.blockCount() << " blocks, "
+                                   << arena.takeCreatedBlockCount() << " created this frame";
+            }
+        }
     }
 
     m_current_opacity = 1;
@@ -3773,6 +4308,10 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
 
     renderTarget().cb->resourceUpdate(m_resourceUpdates);
     m_resourceUpdates = nullptr;
+
+    m_frame_statistics.opaqueBatchCount = int(ctx->opaqueRenderBatches.count());
+    m_frame_statistics.alphaBatchCount = int(ctx->alphaRenderBatches.count());
+    m_frame_statistics.prepareTime = statisticsTimer.nsecsElapsed();
 }
 
 void Renderer::beginRenderPass(RenderPassContext *)
@@ -3806,6 +4345,9 @@ void Renderer::recordRenderPass(RenderPassContext *ctx)
 
     ctx->valid = false;
 
+    QElapsedTimer statisticsTimer;
+    statisticsTimer.start();
+
     QRhiCommandBuffer *cb = renderTarget().cb;
     cb->debugMarkBegin(QByteArrayLiteral("Qt Quick scene render"));
 
@@ -3851,6 +4393,8 @@ void Renderer::recordRenderPass(RenderPassContext *ctx)
                (int) ctx->timeUploadOpaque, (int) ctx->timeUploadAlpha,
                (int) ctx->timer.elapsed());
     }
+
+    m_frame_statistics.recordTime = statisticsTimer.nsecsElapsed();
 }
 
 void Renderer::endRenderPass(RenderPassContext *)
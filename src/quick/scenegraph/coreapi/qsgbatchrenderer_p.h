@@ -25,6 +25,7 @@
 #include <private/qsgtexture_p.h>
 
 #include <QtCore/QBitArray>
+#include <QtCore/QMap>
 #include <QtCore/QStack>
 
 #include <QtGui/private/qrhi_p.h>
@@ -258,15 +259,69 @@ inline QDebug operator << (QDebug d, const Rect &r) {
     return d;
 }
 
+class BufferArena;
+
+struct BufferArenaBlock
+{
+    BufferArena *arena;
+    QRhiBuffer *buf;
+    QMap<quint32, quint32> freeRanges; // offset -> size
+    quint32 usedBytes;
+};
+
 struct Buffer {
     quint32 size;
     // Data is only valid while preparing the upload. Exception is if we are using the
     // broken IBO workaround or we are using a visualization mode.
     char *data;
+    // The range [offset, offset + capacity) of buf belongs to this buffer.
+    // buf is owned by the arena block, not by the buffer.
     QRhiBuffer *buf;
+    BufferArenaBlock *block;
+    quint32 offset;
+    quint32 capacity;
     uint nonDynamicChangeCount;
 };
 
+/* Sub-allocates the vertex or index data of batches from a few large
+ * QRhiBuffers, so that batches being created, recycled or growing do not
+ * create and destroy buffers of their own. A buffer keeps its range for as
+ * long as its data fits, so unchanged batches keep their offsets.
+ */
+class Q_QUICK_PRIVATE_EXPORT BufferArena
+{
+public:
+    BufferArena() = default;
+    ~BufferArena();
+
+    void init(QRhiBuffer::Type type, QRhiBuffer::UsageFlags usage, quint32 blockSize);
+
+    QRhiBuffer::Type type() const { return m_type; }
+
+    bool allocate(QRhi *rhi, Buffer *buffer, quint32 size);
+    void release(Buffer *buffer);
+    void releaseUnusedBlocks();
+
+    int blockCount() const { return m_blocks.size(); }
+    quint64 totalBytes() const;
+    quint64 usedBytes() const;
+    int takeCreatedBlockCount();
+
+private:
+    Q_DISABLE_COPY(BufferArena)
+
+    BufferArenaBlock *createBlock(QRhi *rhi, quint32 size);
+    void destroyBlock(BufferArenaBlock *block);
+    static bool allocateFromBlock(BufferArenaBlock *block, Buffer *buffer, quint32 size);
+    static bool growInPlace(Buffer *buffer, quint32 size);
+
+    QRhiBuffer::Type m_type = QRhiBuffer::Immutable;
+    QRhiBuffer::UsageFlags m_usage;
+    quint32 m_blockSize = 0;
+    QVector<BufferArenaBlock *> m_blocks;
+    int m_createdBlockCount = 0;
+};
+
 struct Element {
     Element()
         : boundsComputed(false)
@@ -346,7 +401,7 @@ struct DrawSet
     }
     DrawSet() {}
     int vertices = 0;
-    int zorders = 0;
+    int zorders = 0; // per-instance data in instanced batches
     int indices = 0;
     int indexCount = 0;
 };
@@ -420,6 +475,7 @@ struct Batch
         isOpaque = false;
         needsUpload = false;
         merged = false;
+        instanced = false;
         positionAttribute = -1;
         uploadedThisFrame = false;
         isRenderNode = false;
@@ -439,9 +495,15 @@ struct Batch
 
     int lastOrderInBatch;
 
+    // Instanced batches are merged batches holding the vertex and index data
+    // of one geometry, followed by one transform per element at instanceDataOffset.
+    int instanceCount;
+    quint32 instanceDataOffset;
+
     uint isOpaque : 1;
     uint needsUpload : 1;
     uint merged : 1;
+    uint instanced : 1;
     uint isRenderNode : 1;
     uint ubufDataValid : 1;
     uint needsPurge : 1;
@@ -663,6 +725,7 @@ public:
     ~ShaderManager() {
         qDeleteAll(rewrittenShaders);
         qDeleteAll(stockShaders);
+        qDeleteAll(instancedShaders);
     }
 
     void clearCachedRendererData();
@@ -678,11 +741,13 @@ public Q_SLOTS:
 public:
     Shader *prepareMaterial(QSGMaterial *material, const QSGGeometry *geometry = nullptr, QSGRendererInterface::RenderMode renderMode = QSGRendererInterface::RenderMode2D);
     Shader *prepareMaterialNoRewrite(QSGMaterial *material, const QSGGeometry *geometry = nullptr, QSGRendererInterface::RenderMode renderMode = QSGRendererInterface::RenderMode2D);
+    Shader *prepareMaterialInstanced(QSGMaterial *material, const QSGGeometry *geometry, QSGRendererInterface::RenderMode renderMode = QSGRendererInterface::RenderMode2D);
 
 private:
     typedef QPair<QSGMaterialType *, QSGRendererInterface::RenderMode> ShaderKey;
     QHash<ShaderKey, Shader *> rewrittenShaders;
     QHash<ShaderKey, Shader *> stockShaders;
+    QHash<ShaderKey, Shader *> instancedShaders; // nullptr when the material has no instanced variant
 
     QSGDefaultRenderContext *context;
 };
@@ -795,6 +860,14 @@ private:
     void invalidateBatchAndOverlappingRenderOrders(Batch *batch);
 
     void uploadBatch(Batch *b);
+    bool prepareBatchUpload(Batch *b, quint32 *vertexBufferSize, quint32 *indexBufferSize);
+    void writeBatchData(Batch *b);
+    void finishBatchUpload(Batch *b);
+    bool canInstanceBatch(Batch *b);
+    void writeInstancedBatchData(Batch *b);
+#if QT_CONFIG(thread)
+    void uploadBatchesConcurrently(quint32 *largestVBO, quint32 *largestIBO);
+#endif
     void uploadMergedElement(Element *e, int vaOffset, char **vertexData, char **zData, char **indexData, void *iBasePtr, int *indexCount);
 
     bool ensurePipelineState(Element *e, const ShaderManager::Shader *sms, bool depthPostPass = false);
@@ -870,6 +943,11 @@ private:
     int m_batchNodeThreshold;
     int m_batchVertexThreshold;
     int m_srbPoolThreshold;
+    int m_instancingThreshold;
+#if QT_CONFIG(thread)
+    int m_uploadThreadCount;
+    int m_parallelUploadVertexThreshold;
+#endif
 
     Visualizer *m_visualizer;
 
@@ -882,6 +960,9 @@ private:
     QDataBuffer<char> m_vertexUploadPool;
     QDataBuffer<char> m_indexUploadPool;
 
+    // [isIndexBuf][dynamic]
+    BufferArena m_bufferArenas[2][2];
+
     Allocator<Node, 256> m_nodeAllocator;
     Allocator<Element, 64> m_elementAllocator;
 
@@ -173,6 +173,16 @@ QShader QSGMaterialShaderPrivate::loadShader(const QString &filename)
     return QShader::fromSerialized(f.readAll());
 }
 
+/* Declares \a filename as the instanced variant of the vertex shader that is
+   set at this point. A shader opts in by calling this after setting its own
+   vertex shader; subclasses that set a different one do not inherit it.
+ */
+void QSGMaterialShaderPrivate::setInstancedVertexShaderFileName(const QString &filename)
+{
+    Q_ASSERT(shaderFileNames.contains(QShader::VertexStage));
+    instancedVertexShaderFileName = filename;
+}
+
 void QSGMaterialShaderPrivate::clearCachedRendererData()
 {
     for (int i = 0; i < MAX_SHADER_RESOURCE_BINDINGS; ++i)
@@ -348,6 +358,8 @@ void QSGMaterialShader::setShader(Stage stage, const QShader &shader)
 {
     Q_D(QSGMaterialShader);
     d->shaders[toShaderStage(stage)] = QSGMaterialShaderPrivate::ShaderStageData(shader);
+    if (stage == VertexStage)
+        d->instancedVertexShaderFileName.clear();
 }
 
 /*!
@@ -359,6 +371,8 @@ void QSGMaterialShader::setShaderFileName(Stage stage, const QString &filename)
 {
     Q_D(QSGMaterialShader);
     d->shaderFileNames[toShaderStage(stage)] = filename;
+    if (stage == VertexStage)
+        d->instancedVertexShaderFileName.clear();
 }
 
 /*!
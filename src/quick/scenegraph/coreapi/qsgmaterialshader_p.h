@@ -41,8 +41,13 @@ public:
 
     static QShader loadShader(const QString &filename);
 
+    void setInstancedVertexShaderFileName(const QString &filename);
+
     QSGMaterialShader *q_ptr;
     QHash<QShader::Stage, QString> shaderFileNames;
+    // instanced variant of the current vertex shader, used by the batch
+    // renderer for instanced batches; reset whenever the vertex shader changes
+    QString instancedVertexShaderFileName;
     QSGMaterialShader::Flags flags;
 
     struct ShaderStageData {
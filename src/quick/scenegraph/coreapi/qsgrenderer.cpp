@@ -211,13 +211,15 @@ void QSGRenderer::preprocess()
     QSGRootNode *root = rootNode();
     Q_ASSERT(root);
 
+    // The context may invalidate nodes, e.g. when distance field glyphs have become
+    // available, so let it run before we pick up the nodes to preprocess.
+    m_context->preprocess();
+
     // We need to take a copy here, in case any of the preprocess calls deletes a node that
     // is in the preprocess list and thus, changes the m_nodes_to_preprocess behind our backs
     // For the default case, when this does not happen, the cost is negligible.
     QSet<QSGNode *> items = m_nodes_to_preprocess;
 
-    m_context->preprocess();
-
     for (QSet<QSGNode *>::const_iterator it = items.constBegin();
          it != items.constEnd(); ++it) {
         QSGNode *n = *it;
@@ -87,6 +87,17 @@ public:
 
     void clearChangedFlag() { m_changed_emitted = false; }
 
+    // Filled in by renderers that support it, times are in nanoseconds.
+    struct FrameStatistics {
+        qint64 prepareTime = 0;
+        qint64 recordTime = 0;
+        int opaqueBatchCount = 0;
+        int alphaBatchCount = 0;
+        int nodeCount = 0;
+        qint64 uploadedBytes = 0;
+    };
+    const FrameStatistics &frameStatistics() const { return m_frame_statistics; }
+
     // Accessed by QSGMaterialShader::RenderState.
     QByteArray *currentUniformData() const { return m_current_uniform_data; }
     QRhiResourceUpdateBatch *currentResourceUpdateBatch() const { return m_current_resource_update_batch; }
@@ -133,6 +144,7 @@ protected:
         QSGRenderContext::RenderPassCallback end = nullptr;
         void *userData = nullptr;
     } m_renderPassRecordingCallbacks;
+    FrameStatistics m_frame_statistics;
 
 private:
     QSGNodeUpdater *m_node_updater;
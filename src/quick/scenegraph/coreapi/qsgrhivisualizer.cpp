@@ -470,7 +470,23 @@ void RhiVisualizer::BatchVis::gather(Batch *b)
     qint32 projection = 0;
     memcpy(dc.uniforms.data + 148, &projection, 4);
 
-    if (b->merged) {
+    if (b->instanced) {
+        // batches uploaded before visualizing was turned on
+        if (b->drawSets.isEmpty())
+            return;
+        const DrawSet &set = b->drawSets.at(0);
+        fillVertexIndex(&dc, b->first->node->geometry(), false, forceUintIndex);
+        for (Element *e = b->first; e; e = e->nextInBatch) {
+            QMatrix4x4 m = matrix * *e->node->matrix();
+            memcpy(dc.uniforms.data, m.constData(), 64);
+            dc.buf.vbuf = b->vbo.buf;
+            dc.buf.vbufOffset = b->vbo.offset + set.vertices;
+            dc.buf.ibuf = b->ibo.buf;
+            dc.buf.ibufOffset = b->ibo.offset + set.indices;
+            dc.index.count = set.indexCount;
+            drawCalls.append(dc);
+        }
+    } else if (b->merged) {
         memcpy(dc.uniforms.data, matrix.constData(), 64);
 
         QSGGeometryNode *gn = b->first->node;
@@ -481,16 +497,16 @@ void RhiVisualizer::BatchVis::gather(Batch *b)
         for (int ds = 0; ds < b->drawSets.size(); ++ds) {
             const DrawSet &set = b->drawSets.at(ds);
             dc.buf.vbuf = b->vbo.buf;
-            dc.buf.vbufOffset = set.vertices;
+            dc.buf.vbufOffset = b->vbo.offset + set.vertices;
             dc.buf.ibuf = b->ibo.buf;
-            dc.buf.ibufOffset = set.indices;
+            dc.buf.ibufOffset = b->ibo.offset + set.indices;
             dc.index.count = set.indexCount;
             drawCalls.append(dc);
         }
     } else {
         Element *e = b->first;
-        int vOffset = 0;
-        int iOffset = 0;
+        int vOffset = b->vbo.offset;
+        int iOffset = b->ibo.offset;
 
         while (e) {
             QSGGeometryNode *gn = e->node;
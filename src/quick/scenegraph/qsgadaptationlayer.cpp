@@ -7,7 +7,15 @@
 #include <QtQuick/private/qsgdistancefieldglyphnode_p.h>
 #include <QtQuick/private/qsgcontext_p.h>
 #include <private/qrawfont_p.h>
+#include <QtQuick/qquickwindow.h>
 #include <QtGui/qguiapplication.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsavefile.h>
+#if QT_CONFIG(thread)
+#include <QtCore/qthreadpool.h>
+#endif
 #include <qdir.h>
 #include <qsgrendernode.h>
 
@@ -20,6 +28,93 @@ QT_BEGIN_NAMESPACE
 
 static QElapsedTimer qsg_render_timer;
 
+int qt_sg_envInt(const char *name, int defaultValue);
+
+#if QT_CONFIG(thread)
+Q_GLOBAL_STATIC(QThreadPool, qsg_distanceFieldThreadPool)
+#endif
+
+// Number of glyphs a single worker job generates before handing them back.
+static const int qsg_glyphsPerAsyncJob = 32;
+
+static const quint32 qsg_distanceFieldCacheMagic = 0x46445351; // "QSDF"
+static const quint32 qsg_distanceFieldCacheVersion = 1;
+
+static QString qsg_distanceFieldCacheFile(const QString &cachePath, glyph_t glyph)
+{
+    return cachePath + QLatin1Char('/') + QString::number(glyph) + QLatin1String(".qdf");
+}
+
+static QDistanceField qsg_loadCachedDistanceField(const QString &cachePath, glyph_t glyph)
+{
+    QFile file(qsg_distanceFieldCacheFile(cachePath, glyph));
+    if (!file.open(QIODevice::ReadOnly))
+        return QDistanceField();
+
+    quint32 header[4];
+    if (file.read(reinterpret_cast<char *>(header), sizeof(header)) != qint64(sizeof(header))
+            || header[0] != qsg_distanceFieldCacheMagic
+            || header[1] != qsg_distanceFieldCacheVersion) {
+        return QDistanceField();
+    }
+
+    const int width = int(header[2]);
+    const int height = int(header[3]);
+    const qint64 byteCount = qint64(width) * height;
+    if (width <= 0 || height <= 0 || file.size() != qint64(sizeof(header)) + byteCount)
+        return QDistanceField();
+
+    QDistanceField df(width, height);
+    if (df.isNull() || file.read(reinterpret_cast<char *>(df.bits()), byteCount) != byteCount)
+        return QDistanceField();
+
+    return df;
+}
+
+static void qsg_saveCachedDistanceField(const QString &cachePath, glyph_t glyph,
+                                        const QDistanceField &df)
+{
+    QSaveFile file(qsg_distanceFieldCacheFile(cachePath, glyph));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    const quint32 header[4] = { qsg_distanceFieldCacheMagic,
+                                qsg_distanceFieldCacheVersion,
+                                quint32(df.width()),
+                                quint32(df.height()) };
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(df.constBits()), qint64(df.width()) * df.height());
+    file.commit();
+}
+
+// Thread-safe: called on the render thread and on the distance field worker threads.
+static QDistanceField qsg_createDistanceField(const QPainterPath &path, glyph_t glyph,
+                                              bool doubleResolution, const QString &cachePath)
+{
+    if (!cachePath.isEmpty()) {
+        QDistanceField df = qsg_loadCachedDistanceField(cachePath, glyph);
+        if (!df.isNull())
+            return df;
+    }
+
+    QDistanceField df(path, glyph, doubleResolution);
+    if (!cachePath.isEmpty() && !df.isNull())
+        qsg_saveCachedDistanceField(cachePath, glyph, df);
+    return df;
+}
+
+// Shared with the worker jobs, so that the cache can be destroyed while they run.
+struct QSGDistanceFieldGlyphCache::AsyncGlyphResults
+{
+    struct Result {
+        quint32 serial;
+        GlyphDistanceField glyph;
+    };
+
+    QMutex mutex;
+    QList<Result> distanceFields;
+};
+
 QSGDistanceFieldGlyphCache::Texture QSGDistanceFieldGlyphCache::s_emptyTexture;
 
 QSGDistanceFieldGlyphCache::QSGDistanceFieldGlyphCache(const QRawFont &font, int renderTypeQuality)
@@ -38,12 +133,51 @@ QSGDistanceFieldGlyphCache::QSGDistanceFieldGlyphCache(const QRawFont &font, int
     // this allows us to call pathForGlyph once and reuse the result.
     m_referenceFont.setPixelSize(baseFontSize() * QT_DISTANCEFIELD_SCALE(m_doubleGlyphResolution));
     Q_ASSERT(m_referenceFont.isValid());
+
+#if QT_CONFIG(thread)
+    m_asyncGlyphThreshold = qt_sg_envInt("QSG_DISTANCEFIELD_ASYNC_THRESHOLD", 32);
+#else
+    m_asyncGlyphThreshold = 0;
+#endif
+
+    const QString cacheRoot = qEnvironmentVariable("QSG_DISTANCEFIELD_CACHE_DIR");
+    if (!cacheRoot.isEmpty()) {
+        // Everything else that affects the generated distance fields goes into the key
+        const qint32 parameters[] = { baseFontSize(),
+                                      m_doubleGlyphResolution,
+                                      QT_DISTANCEFIELD_RADIUS(m_doubleGlyphResolution),
+                                      QT_DISTANCEFIELD_SCALE(m_doubleGlyphResolution) };
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(fontHash(m_referenceFont));
+        hash.addData(QByteArray::fromRawData(reinterpret_cast<const char *>(parameters), sizeof(parameters)));
+
+        const QString cachePath = cacheRoot + QLatin1Char('/') + QString::fromLatin1(hash.result().toHex());
+        if (QDir().mkpath(cachePath))
+            m_diskCachePath = cachePath;
+        else
+            qWarning("Warning: cannot create distance field cache directory %s", qPrintable(cachePath));
+    }
 }
 
 QSGDistanceFieldGlyphCache::~QSGDistanceFieldGlyphCache()
 {
 }
 
+// Returns a hex encoded hash identifying the font, independent of its pixel size.
+// The 'head' table tells apart different versions of the same font.
+QByteArray QSGDistanceFieldGlyphCache::fontHash(const QRawFont &font)
+{
+    const qint32 properties[] = { font.weight(),
+                                  qint32(font.style()),
+                                  qint32(QRawFontPrivate::get(font)->fontEngine->glyphCount()) };
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(font.familyName().toUtf8());
+    hash.addData(font.styleName().toUtf8());
+    hash.addData(QByteArray::fromRawData(reinterpret_cast<const char *>(properties), sizeof(properties)));
+    hash.addData(font.fontTable("head"));
+    return hash.result().toHex();
+}
+
 int QSGDistanceFieldGlyphCache::baseFontSize() const
 {
     return m_renderTypeQuality > 0 ? m_renderTypeQuality : QT_DISTANCEFIELD_BASEFONTSIZE(m_doubleGlyphResolution);
@@ -143,9 +277,17 @@ void QSGDistanceFieldGlyphCache::update()
 {
     m_populatingGlyphs.clear();
 
+    if (m_asyncResults)
+        storeAsyncGlyphs();
+
     if (m_pendingGlyphs.isEmpty())
         return;
 
+    if (m_asyncGlyphThreshold > 0 && m_pendingGlyphs.size() >= m_asyncGlyphThreshold) {
+        startAsyncGlyphJobs();
+        return;
+    }
+
     Q_TRACE_SCOPE(QSGDistanceFieldGlyphCache_update, m_pendingGlyphs.size());
 
     bool profileFrames = QSG_LOG_TIME_GLYPH().isDebugEnabled();
@@ -154,14 +296,16 @@ void QSGDistanceFieldGlyphCache::update()
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphAdaptationLayerFrame);
     Q_TRACE(QSGDistanceFieldGlyphCache_glyphRender_entry);
 
-    QList<QDistanceField> distanceFields;
+    QList<GlyphDistanceField> distanceFields;
     const int pendingGlyphsSize = m_pendingGlyphs.size();
     distanceFields.reserve(pendingGlyphsSize);
     for (int i = 0; i < pendingGlyphsSize; ++i) {
-        GlyphData &gd = glyphData(m_pendingGlyphs.at(i));
-        distanceFields.append(QDistanceField(gd.path,
-                                             m_pendingGlyphs.at(i),
-                                             m_doubleGlyphResolution));
+        const glyph_t glyphIndex = m_pendingGlyphs.at(i);
+        GlyphData &gd = glyphData(glyphIndex);
+        distanceFields.append({ glyphIndex, qsg_createDistanceField(gd.path,
+                                                                    glyphIndex,
+                                                                    m_doubleGlyphResolution,
+                                                                    m_diskCachePath) });
         gd.path = QPainterPath(); // no longer needed, so release memory used by the painter path
     }
 
@@ -199,6 +343,102 @@ void QSGDistanceFieldGlyphCache::update()
                                         (qint64)count);
 }
 
+void QSGDistanceFieldGlyphCache::startAsyncGlyphJobs()
+{
+#if QT_CONFIG(thread)
+    if (!m_asyncResults)
+        m_asyncResults.reset(new AsyncGlyphResults);
+
+    // The windows showing text from this cache get a new frame when a job is done,
+    // which is when the results are stored and the glyphs drawn.
+    QList<QPointer<QQuickWindow> > windows;
+    for (const OwnerElement &owner : qAsConst(m_ownerElements)) {
+        if (owner.window && !windows.contains(owner.window))
+            windows.append(owner.window);
+    }
+
+    const int pendingGlyphsSize = m_pendingGlyphs.size();
+    for (int start = 0; start < pendingGlyphsSize; start += qsg_glyphsPerAsyncJob) {
+        const int end = qMin(start + qsg_glyphsPerAsyncJob, pendingGlyphsSize);
+        const quint32 serial = ++m_asyncGlyphSerial;
+
+        QList<QPair<glyph_t, QPainterPath> > paths;
+        paths.reserve(end - start);
+        for (int i = start; i < end; ++i) {
+            const glyph_t glyphIndex = m_pendingGlyphs.at(i);
+            GlyphData &gd = glyphData(glyphIndex);
+            paths.append(qMakePair(glyphIndex, gd.path));
+            gd.path = QPainterPath(); // the job holds the only copy that is still needed
+            m_asyncGlyphs.insert(glyphIndex, serial);
+        }
+
+        qsg_distanceFieldThreadPool()->start([results = m_asyncResults, paths, serial, windows,
+                                              doubleResolution = m_doubleGlyphResolution,
+                                              cachePath = m_diskCachePath] {
+            QList<AsyncGlyphResults::Result> distanceFields;
+            distanceFields.reserve(paths.size());
+            for (const QPair<glyph_t, QPainterPath> &path : paths) {
+                const QDistanceField df = qsg_createDistanceField(path.second, path.first,
+                                                                  doubleResolution, cachePath);
+                distanceFields.append({ serial, { path.first, df } });
+            }
+
+            {
+                QMutexLocker locker(&results->mutex);
+                results->distanceFields.append(distanceFields);
+            }
+
+            if (QCoreApplication *app = QCoreApplication::instance()) {
+                QMetaObject::invokeMethod(app, [windows] {
+                    for (const QPointer<QQuickWindow> &window : windows) {
+                        if (window)
+                            window->update();
+                    }
+                }, Qt::QueuedConnection);
+            }
+        });
+    }
+
+    qCDebug(QSG_LOG_TIME_GLYPH, "distancefield: %d glyphs handed to worker threads", pendingGlyphsSize);
+
+    m_pendingGlyphs.reset();
+#endif
+}
+
+void QSGDistanceFieldGlyphCache::storeAsyncGlyphs()
+{
+    QList<AsyncGlyphResults::Result> results;
+    {
+        QMutexLocker locker(&m_asyncResults->mutex);
+        results.swap(m_asyncResults->distanceFields);
+    }
+
+    QList<GlyphDistanceField> distanceFields;
+    QVector<quint32> readyGlyphs;
+    for (const AsyncGlyphResults::Result &result : qAsConst(results)) {
+        const glyph_t glyphIndex = result.glyph.glyph;
+        // Glyphs that were evicted, or requested again, while being generated
+        // no longer own the area this result was made for.
+        QHash<glyph_t, quint32>::iterator it = m_asyncGlyphs.find(glyphIndex);
+        if (it == m_asyncGlyphs.end() || it.value() != result.serial)
+            continue;
+        m_asyncGlyphs.erase(it);
+        distanceFields.append(result.glyph);
+        readyGlyphs.append(glyphIndex);
+    }
+
+    if (distanceFields.isEmpty())
+        return;
+
+    storeGlyphs(distanceFields);
+
+    // Nodes leave out glyphs without a texture, so make them pick up the new ones.
+    for (QSGDistanceFieldGlyphConsumerList::iterator iter = m_registeredNodes.begin(); iter != m_registeredNodes.end(); ++iter)
+        iter->invalidateGlyphs(readyGlyphs);
+
+    qCDebug(QSG_LOG_TIME_GLYPH, "distancefield: %d glyphs stored from worker threads", int(readyGlyphs.size()));
+}
+
 void QSGDistanceFieldGlyphCache::setGlyphsPosition(const QList<GlyphPosition> &glyphs)
 {
     QVector<quint32> invalidatedGlyphs;
@@ -228,12 +468,18 @@ void QSGDistanceFieldGlyphCache::setGlyphsPosition(const QList<GlyphPosition> &g
 
 void QSGDistanceFieldGlyphCache::registerOwnerElement(QQuickItem *ownerElement)
 {
-    Q_UNUSED(ownerElement);
+    // Called while synchronizing, so the item's window can be looked up here.
+    OwnerElement &owner = m_ownerElements[ownerElement];
+    if (owner.ref++ == 0)
+        owner.window = ownerElement->window();
 }
 
 void QSGDistanceFieldGlyphCache::unregisterOwnerElement(QQuickItem *ownerElement)
 {
-    Q_UNUSED(ownerElement);
+    // The item may already be gone, do not touch it.
+    QHash<QQuickItem *, OwnerElement>::iterator it = m_ownerElements.find(ownerElement);
+    if (it != m_ownerElements.end() && --it->ref == 0)
+        m_ownerElements.erase(it);
 }
 
 void QSGDistanceFieldGlyphCache::processPendingGlyphs()
@@ -24,6 +24,7 @@
 #include <QtGui/qcolor.h>
 #include <QtGui/qpainterpath.h>
 #include <QtCore/qsharedpointer.h>
+#include <QtCore/qpointer.h>
 #include <QtGui/qglyphrun.h>
 #include <QtGui/qpainterpath.h>
 #include <QtCore/qurl.h>
@@ -51,6 +52,7 @@ class QSGSpriteNode;
 class QSGRenderNode;
 class QSGRenderContext;
 class QRhiTexture;
+class QQuickWindow;
 
 class Q_QUICK_PRIVATE_EXPORT QSGNodeVisitorEx
 {
@@ -441,6 +443,8 @@ public:
         }
     };
 
+    static QByteArray fontHash(const QRawFont &font);
+
     const QRawFont &referenceFont() const { return m_referenceFont; }
 
     qreal fontScale(qreal pixelSize) const
@@ -481,6 +485,11 @@ protected:
         QPointF position;
     };
 
+    struct GlyphDistanceField {
+        glyph_t glyph;
+        QDistanceField distanceField;
+    };
+
     struct GlyphData {
         Texture *texture = nullptr;
         TexCoord texCoord;
@@ -492,7 +501,7 @@ protected:
     };
 
     virtual void requestGlyphs(const QSet<glyph_t> &glyphs) = 0;
-    virtual void storeGlyphs(const QList<QDistanceField> &glyphs) = 0;
+    virtual void storeGlyphs(const QList<GlyphDistanceField> &glyphs) = 0;
     virtual void referenceGlyphs(const QSet<glyph_t> &glyphs) = 0;
     virtual void releaseGlyphs(const QSet<glyph_t> &glyphs) = 0;
 
@@ -521,6 +530,15 @@ protected:
     QRawFont m_referenceFont;
 
 private:
+    struct AsyncGlyphResults;
+    struct OwnerElement {
+        QPointer<QQuickWindow> window;
+        int ref = 0;
+    };
+
+    void startAsyncGlyphJobs();
+    void storeAsyncGlyphs();
+
     int m_glyphCount;
     QList<Texture> m_textures;
     QHash<glyph_t, GlyphData> m_glyphsData;
@@ -528,6 +546,13 @@ private:
     QSet<glyph_t> m_populatingGlyphs;
     QSGDistanceFieldGlyphConsumerList m_registeredNodes;
 
+    int m_asyncGlyphThreshold;
+    quint32 m_asyncGlyphSerial = 0;
+    QHash<glyph_t, quint32> m_asyncGlyphs; // glyphs being generated on a worker thread
+    QSharedPointer<AsyncGlyphResults> m_asyncResults;
+    QHash<QQuickItem *, OwnerElement> m_ownerElements;
+    QString m_diskCachePath;
+
     static Texture s_emptyTexture;
 };
 
@@ -546,6 +571,7 @@ inline void QSGDistanceFieldGlyphCache::removeGlyph(glyph_t glyph)
     GlyphData &gd = glyphData(glyph);
     gd.texCoord = TexCoord();
     gd.texture = &s_emptyTexture;
+    m_asyncGlyphs.remove(glyph);
 }
 
 inline bool QSGDistanceFieldGlyphCache::containsGlyph(glyph_t glyph)
@@ -63,6 +63,9 @@ Q_LOGGING_CATEGORY(QSG_LOG_TIME_GLYPH,          "qt.scenegraph.time.glyph")
 // Timing inside the renderer base class
 Q_LOGGING_CATEGORY(QSG_LOG_TIME_RENDERER,       "qt.scenegraph.time.renderer")
 
+// Texture atlas occupancy and fragmentation
+Q_LOGGING_CATEGORY(QSG_LOG_ATLAS,               "qt.scenegraph.atlas")
+
 bool qsg_useConsistentTiming()
 {
     int use = -1;
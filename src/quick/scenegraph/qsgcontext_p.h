@@ -67,6 +67,7 @@ Q_DECLARE_LOGGING_CATEGORY(QSG_LOG_TIME_TEXTURE)
 Q_DECLARE_LOGGING_CATEGORY(QSG_LOG_TIME_GLYPH)
 Q_DECLARE_LOGGING_CATEGORY(QSG_LOG_TIME_RENDERER)
 
+Q_DECLARE_LOGGING_CATEGORY(QSG_LOG_ATLAS)
 Q_DECLARE_LOGGING_CATEGORY(QSG_LOG_INFO)
 Q_DECLARE_LOGGING_CATEGORY(QSG_LOG_RENDERLOOP)
 
@@ -231,6 +231,15 @@ void QSGDefaultRenderContext::initializeRhiShader(QSGMaterialShader *shader, QSh
     QSGMaterialShaderPrivate::get(shader)->prepare(shaderVariant);
 }
 
+void QSGDefaultRenderContext::endSync()
+{
+    QSGRenderContext::endSync();
+
+    // Textures released during the sync may have emptied an atlas page
+    if (m_rhiAtlasManager)
+        m_rhiAtlasManager->releaseEmptyPages();
+}
+
 void QSGDefaultRenderContext::preprocess()
 {
     for (auto it = m_glyphCaches.begin(); it != m_glyphCaches.end(); ++it) {
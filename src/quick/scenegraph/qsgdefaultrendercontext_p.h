@@ -66,6 +66,7 @@ public:
     void renderNextFrame(QSGRenderer *renderer) override;
     void endNextFrame(QSGRenderer *renderer) override;
 
+    void endSync() override;
     void preprocess() override;
     void invalidateGlyphCaches() override;
     QSGDistanceFieldGlyphCache *distanceFieldGlyphCache(const QRawFont &font, int renderTypeQuality) override;
@@ -6,10 +6,15 @@
 #include "qsgdefaultrendercontext_p.h"
 #include <QtGui/private/qdistancefield_p.h>
 #include <QtCore/qelapsedtimer.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qmutex.h>
 #include <QtQml/private/qqmlglobal_p.h>
 #include <qmath.h>
 #include <qendian.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 DEFINE_BOOL_CONFIG_OPTION(qmlUseGlyphCacheWorkaround, QML_USE_GLYPHCACHE_WORKAROUND)
@@ -116,7 +121,7 @@ bool QSGRhiDistanceFieldGlyphCache::isActive() const
     return m_unusedGlyphs.size() != m_glyphsTexture.size();
 }
 
-void QSGRhiDistanceFieldGlyphCache::storeGlyphs(const QList<QDistanceField> &glyphs)
+void QSGRhiDistanceFieldGlyphCache::storeGlyphs(const QList<GlyphDistanceField> &glyphs)
 {
     typedef QHash<TextureInfo *, QVector<glyph_t> > GlyphTextureHash;
     typedef GlyphTextureHash::const_iterator GlyphTextureHashConstIt;
@@ -125,8 +130,8 @@ void QSGRhiDistanceFieldGlyphCache::storeGlyphs(const QList<QDistanceField> &gly
 
     QVarLengthArray<QRhiTextureUploadEntry, 32> uploads;
     for (int i = 0; i < glyphs.size(); ++i) {
-        QDistanceField glyph = glyphs.at(i);
-        glyph_t glyphIndex = glyph.glyph();
+        QDistanceField glyph = glyphs.at(i).distanceField;
+        glyph_t glyphIndex = glyphs.at(i).glyph;
         TexCoord c = glyphTexCoord(glyphIndex);
         TextureInfo *texInfo = m_glyphsTexture.value(glyphIndex);
 
@@ -157,7 +162,7 @@ void QSGRhiDistanceFieldGlyphCache::storeGlyphs(const QList<QDistanceField> &gly
 
     QRhiResourceUpdateBatch *resourceUpdates = m_rc->glyphCacheResourceUpdates();
     for (int i = 0; i < glyphs.size(); ++i) {
-        TextureInfo *texInfo = m_glyphsTexture.value(glyphs.at(i).glyph());
+        TextureInfo *texInfo = m_glyphsTexture.value(glyphs.at(i).glyph);
         if (!texInfo->uploads.isEmpty()) {
             QRhiTextureUploadDescription desc;
             desc.setEntries(texInfo->uploads.cbegin(), texInfo->uploads.cend());
@@ -189,23 +194,26 @@ void QSGRhiDistanceFieldGlyphCache::createTexture(TextureInfo *texInfo,
                                                       int height)
 {
     QByteArray zeroBuf(width * height, 0);
-    createTexture(texInfo, width, height, zeroBuf.constData());
+    createTexture(texInfo, width, height, zeroBuf);
 }
 
+// pixels may be raw data which has to stay valid until the upload is done
 void QSGRhiDistanceFieldGlyphCache::createTexture(TextureInfo *texInfo,
                                                   int width,
                                                   int height,
-                                                  const void *pixels)
+                                                  const QByteArray &pixels)
 {
+    Q_ASSERT(pixels.size() == qsizetype(width) * height);
+
     if (useTextureResizeWorkaround() && texInfo->image.isNull()) {
         texInfo->image = QDistanceField(width, height);
-        memcpy(texInfo->image.bits(), pixels, width * height);
+        memcpy(texInfo->image.bits(), pixels.constData(), width * height);
     }
 
     texInfo->texture = m_rhi->newTexture(QRhiTexture::RED_OR_ALPHA8, QSize(width, height), 1, QRhiTexture::UsedAsTransferSource);
     if (texInfo->texture->create()) {
         QRhiResourceUpdateBatch *resourceUpdates = m_rc->glyphCacheResourceUpdates();
-        QRhiTextureSubresourceUploadDescription subresDesc(pixels, width * height);
+        QRhiTextureSubresourceUploadDescription subresDesc(pixels);
         subresDesc.setSourceSize(QSize(width, height));
         resourceUpdates->uploadTexture(texInfo->texture, QRhiTextureUploadEntry(0, 0, subresDesc));
     } else {
@@ -317,6 +325,71 @@ namespace {
             return qFromBigEndian<T>(data + int(offset));
         }
     };
+
+    // A distance field atlas file, as written by qmlglyphatlas, is a qtdf
+    // table preceded by a header identifying the font it was made for.
+    struct QtdfAtlas {
+        enum TableSize {
+            HeaderSize = 52,
+            FontHashSize = 40
+        };
+
+        enum Offset {
+            magic               = 0,
+            version             = 4,
+            fontHash            = 8,
+            renderTypeQuality   = 48
+        };
+
+        enum {
+            Magic = 0x51444641, // "QDFA"
+            Version = 1
+        };
+    };
+
+    // Atlas files are mapped once per process and kept until exit, as the
+    // textures are uploaded straight from the mapped memory.
+    struct AtlasFiles {
+        ~AtlasFiles() { qDeleteAll(files); }
+
+        QMutex mutex;
+        QHash<QString, QByteArray> data;
+        QList<QFile *> files;
+    };
+}
+
+Q_GLOBAL_STATIC(AtlasFiles, qsg_atlasFiles)
+
+static QByteArray qsg_mapAtlasFile(const QString &fileName)
+{
+    AtlasFiles *atlasFiles = qsg_atlasFiles();
+    QMutexLocker locker(&atlasFiles->mutex);
+
+    QHash<QString, QByteArray>::const_iterator it = atlasFiles->data.constFind(fileName);
+    if (it != atlasFiles->data.constEnd())
+        return it.value();
+
+    QByteArray data;
+    QFile *file = new QFile(fileName);
+    if (file->open(QIODevice::ReadOnly) && file->size() > 0) {
+        if (uchar *mapped = file->map(0, file->size()))
+            data = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), file->size());
+    }
+
+    if (data.isEmpty())
+        delete file;
+    else
+        atlasFiles->files.append(file);
+
+    // Misses are remembered too, this is called for every new glyph cache
+    atlasFiles->data.insert(fileName, data);
+    return data;
+}
+
+QString QSGRhiDistanceFieldGlyphCache::atlasFileName(const QRawFont &font, int renderTypeQuality)
+{
+    return QString::fromLatin1(fontHash(font)) + QLatin1Char('_')
+            + QString::number(renderTypeQuality) + QLatin1String(".qdfa");
 }
 
 bool QSGRhiDistanceFieldGlyphCache::loadPregeneratedCache(const QRawFont &font)
@@ -328,28 +401,84 @@ bool QSGRhiDistanceFieldGlyphCache::loadPregeneratedCache(const QRawFont &font)
         return false;
     }
 
+    QByteArray qtdfTable = font.fontTable("qtdf");
+    if (!qtdfTable.isEmpty())
+        return loadPregeneratedCache(font, qtdfTable.constData(), qtdfTable.size(), false);
+
+    static const QStringList atlasPaths = qEnvironmentVariable("QSG_DISTANCEFIELD_ATLAS_PATH")
+            .split(QDir::listSeparator(), Qt::SkipEmptyParts);
+    if (atlasPaths.isEmpty())
+        return false;
+
+    const QString fileName = atlasFileName(font, m_renderTypeQuality);
+    for (const QString &atlasPath : atlasPaths) {
+        const QByteArray atlas = qsg_mapAtlasFile(atlasPath + QLatin1Char('/') + fileName);
+        if (atlas.isEmpty())
+            continue;
+
+        if (loadAtlas(font, atlas))
+            return true;
+
+        qWarning("Invalid distance field atlas '%s' for font '%s'",
+                 qPrintable(QDir::toNativeSeparators(atlasPath + QLatin1Char('/') + fileName)),
+                 qPrintable(font.familyName()));
+    }
+
+    return false;
+}
+
+/* Seeds the cache from an atlas written by qmlglyphatlas. The textures are
+   uploaded straight from \a atlas, so its data must stay valid for as long
+   as the cache exists. Returns false, leaving the cache untouched, if the
+   atlas is damaged or was made for another font or renderTypeQuality.
+ */
+bool QSGRhiDistanceFieldGlyphCache::loadAtlas(const QRawFont &font, const QByteArray &atlas)
+{
+    if (m_areaAllocator != nullptr) {
+        qWarning("Font cache must be loaded before cache is used");
+        return false;
+    }
+
+    const char *atlasStart = atlas.constData();
+    if (atlas.size() < QtdfAtlas::HeaderSize
+            || qFromBigEndian<quint32>(atlasStart + QtdfAtlas::magic) != quint32(QtdfAtlas::Magic)
+            || qFromBigEndian<quint32>(atlasStart + QtdfAtlas::version) != quint32(QtdfAtlas::Version)
+            || fontHash(font) != QByteArray::fromRawData(atlasStart + QtdfAtlas::fontHash, QtdfAtlas::FontHashSize)
+            || qFromBigEndian<quint32>(atlasStart + QtdfAtlas::renderTypeQuality) != quint32(m_renderTypeQuality)) {
+        return false;
+    }
+
+    return loadPregeneratedCache(font,
+                                 atlasStart + QtdfAtlas::HeaderSize,
+                                 atlas.size() - QtdfAtlas::HeaderSize,
+                                 true);
+}
+
+// With zeroCopy, the textures are uploaded directly from data, which must then
+// stay valid for as long as the cache exists.
+bool QSGRhiDistanceFieldGlyphCache::loadPregeneratedCache(const QRawFont &font,
+                                                          const char *data,
+                                                          qsizetype size,
+                                                          bool zeroCopy)
+{
     static QElapsedTimer timer;
 
     bool profile = QSG_LOG_TIME_GLYPH().isDebugEnabled();
     if (profile)
         timer.start();
 
-    QByteArray qtdfTable = font.fontTable("qtdf");
-    if (qtdfTable.isEmpty())
-        return false;
-
     typedef QHash<TextureInfo *, QVector<glyph_t> > GlyphTextureHash;
 
     GlyphTextureHash glyphTextures;
 
-    if (uint(qtdfTable.size()) < Qtdf::HeaderSize) {
+    if (size < Qtdf::HeaderSize) {
         qWarning("Invalid qtdf table in font '%s'",
                  qPrintable(font.familyName()));
         return false;
     }
 
-    const char *qtdfTableStart = qtdfTable.constData();
-    const char *qtdfTableEnd = qtdfTableStart + qtdfTable.size();
+    const char *qtdfTableStart = data;
+    const char *qtdfTableEnd = qtdfTableStart + size;
 
     int padding = 0;
     int textureCount = 0;
@@ -365,8 +494,8 @@ bool QSGRhiDistanceFieldGlyphCache::loadPregeneratedCache(const QRawFont &font)
         }
 
         qreal pixelSize = qreal(Qtdf::fetch<quint16>(qtdfTableStart, Qtdf::pixelSize));
-        m_maxTextureSize = Qtdf::fetch<quint32>(qtdfTableStart, Qtdf::textureSize);
-        m_doubleGlyphResolution = Qtdf::fetch<quint8>(qtdfTableStart, Qtdf::flags) == 1;
+        const int maxTextureSize = int(Qtdf::fetch<quint32>(qtdfTableStart, Qtdf::textureSize));
+        const bool doubleGlyphResolution = Qtdf::fetch<quint8>(qtdfTableStart, Qtdf::flags) == 1;
         padding = Qtdf::fetch<quint8>(qtdfTableStart, Qtdf::headerPadding);
 
         if (pixelSize <= 0.0) {
@@ -374,18 +503,18 @@ bool QSGRhiDistanceFieldGlyphCache::loadPregeneratedCache(const QRawFont &font)
             return false;
         }
 
-        if (m_maxTextureSize <= 0) {
+        if (maxTextureSize <= 0) {
             qWarning("Invalid texture size in '%s'", qPrintable(font.familyName()));
             return false;
         }
 
         int systemMaxTextureSize = m_rhi->resourceLimit(QRhi::TextureSizeMax);
 
-        if (m_maxTextureSize > systemMaxTextureSize) {
+        if (maxTextureSize > systemMaxTextureSize) {
             qWarning("System maximum texture size is %d. This is lower than the value in '%s', which is %d",
                      systemMaxTextureSize,
                      qPrintable(font.familyName()),
-                     m_maxTextureSize);
+                     maxTextureSize);
         }
 
         if (padding != QSG_RHI_DISTANCEFIELD_GLYPH_CACHE_PADDING) {
@@ -395,35 +524,67 @@ bool QSGRhiDistanceFieldGlyphCache::loadPregeneratedCache(const QRawFont &font)
                      QSG_RHI_DISTANCEFIELD_GLYPH_CACHE_PADDING);
         }
 
-        m_referenceFont.setPixelSize(pixelSize);
-
         quint32 glyphCount = Qtdf::fetch<quint32>(qtdfTableStart, Qtdf::numGlyphs);
-        m_unusedGlyphs.reserve(glyphCount);
 
+        std::unique_ptr<QSGAreaAllocator> areaAllocator(new QSGAreaAllocator(QSize(0, 0)));
         const char *allocatorData = qtdfTableStart + Qtdf::HeaderSize;
-        {
-            m_areaAllocator = new QSGAreaAllocator(QSize(0, 0));
-            allocatorData = m_areaAllocator->deserialize(allocatorData, qtdfTableEnd - allocatorData);
-            if (allocatorData == nullptr)
-                return false;
-        }
+        allocatorData = areaAllocator->deserialize(allocatorData, qtdfTableEnd - allocatorData);
+        if (allocatorData == nullptr)
+            return false;
 
-        if (m_areaAllocator->size().height() % m_maxTextureSize != 0) {
+        if (areaAllocator->size().height() % maxTextureSize != 0) {
             qWarning("Area allocator size mismatch in '%s'", qPrintable(font.familyName()));
             return false;
         }
 
-        textureCount = m_areaAllocator->size().height() / m_maxTextureSize;
-        m_maxTextureCount = qMax(m_maxTextureCount, textureCount);
+        textureCount = areaAllocator->size().height() / maxTextureSize;
+
+        // Check that all records and texture data are there before changing
+        // anything, so that a truncated table leaves the cache as it was.
+        const char *textureRecords = allocatorData;
+        const qint64 recordBytes = qint64(textureCount) * Qtdf::TextureRecordSize
+                + qint64(glyphCount) * Qtdf::GlyphRecordSize;
+        if (qtdfTableEnd - textureRecords < recordBytes) {
+            qWarning("qtdf table too small in font '%s'.",
+                     qPrintable(font.familyName()));
+            return false;
+        }
+        const char *glyphRecords = textureRecords + qint64(textureCount) * Qtdf::TextureRecordSize;
 
-        const char *textureRecord = allocatorData;
+        qint64 textureBytes = 0;
+        const char *textureRecord = textureRecords;
         for (int i = 0; i < textureCount; ++i, textureRecord += Qtdf::TextureRecordSize) {
-            if (qtdfTableEnd - textureRecord < Qtdf::TextureRecordSize) {
-                qWarning("qtdf table too small in font '%s'.",
+            textureBytes += qint64(Qtdf::fetch<quint32>(textureRecord, Qtdf::allocatedWidth))
+                    * Qtdf::fetch<quint32>(textureRecord, Qtdf::allocatedHeight);
+        }
+
+        const char *glyphRecord = glyphRecords;
+        for (quint32 i = 0; i < glyphCount; ++i, glyphRecord += Qtdf::GlyphRecordSize) {
+            int textureIndex = Qtdf::fetch<quint16>(glyphRecord, Qtdf::textureIndex);
+            if (textureIndex >= textureCount) {
+                qWarning("Invalid texture index %d (texture count == %d) in '%s'",
+                         textureIndex,
+                         textureCount,
                          qPrintable(font.familyName()));
                 return false;
             }
+        }
 
+        if (qtdfTableEnd - glyphRecord < textureBytes) {
+            qWarning("qtdf table too small in font '%s'.",
+                     qPrintable(font.familyName()));
+            return false;
+        }
+
+        m_maxTextureSize = maxTextureSize;
+        m_doubleGlyphResolution = doubleGlyphResolution;
+        m_referenceFont.setPixelSize(pixelSize);
+        m_areaAllocator = areaAllocator.release();
+        m_maxTextureCount = qMax(m_maxTextureCount, textureCount);
+        m_unusedGlyphs.reserve(glyphCount);
+
+        textureRecord = textureRecords;
+        for (int i = 0; i < textureCount; ++i, textureRecord += Qtdf::TextureRecordSize) {
             TextureInfo *tex = textureInfo(i);
             tex->allocatedArea.setX(Qtdf::fetch<quint32>(textureRecord, Qtdf::allocatedX));
             tex->allocatedArea.setY(Qtdf::fetch<quint32>(textureRecord, Qtdf::allocatedY));
@@ -432,14 +593,8 @@ bool QSGRhiDistanceFieldGlyphCache::loadPregeneratedCache(const QRawFont &font)
             tex->padding = Qtdf::fetch<quint8>(textureRecord, Qtdf::texturePadding);
         }
 
-        const char *glyphRecord = textureRecord;
+        glyphRecord = glyphRecords;
         for (quint32 i = 0; i < glyphCount; ++i, glyphRecord += Qtdf::GlyphRecordSize) {
-            if (qtdfTableEnd - glyphRecord < Qtdf:: GlyphRecordSize) {
-                qWarning("qtdf table too small in font '%s'.",
-                         qPrintable(font.familyName()));
-                return false;
-            }
-
             glyph_t glyph = Qtdf::fetch<quint32>(glyphRecord, Qtdf::glyphIndex);
             m_unusedGlyphs.insert(glyph);
 
@@ -462,36 +617,24 @@ bool QSGRhiDistanceFieldGlyphCache::loadPregeneratedCache(const QRawFont &font)
 #undef FROM_FIXED_POINT
 
             int textureIndex = Qtdf::fetch<quint16>(glyphRecord, Qtdf::textureIndex);
-            if (textureIndex < 0 || textureIndex >= textureCount) {
-                qWarning("Invalid texture index %d (texture count == %d) in '%s'",
-                         textureIndex,
-                         textureCount,
-                         qPrintable(font.familyName()));
-                return false;
-            }
-
-
             TextureInfo *texInfo = textureInfo(textureIndex);
             m_glyphsTexture.insert(glyph, texInfo);
 
             glyphTextures[texInfo].append(glyph);
         }
 
-        const uchar *textureData = reinterpret_cast<const uchar *>(glyphRecord);
+        const char *textureData = glyphRecord;
         for (int i = 0; i < textureCount; ++i) {
 
             TextureInfo *texInfo = textureInfo(i);
 
             int width = texInfo->allocatedArea.width();
             int height = texInfo->allocatedArea.height();
-            qint64 size = qint64(width) * height;
-            if (qtdfTableEnd - reinterpret_cast<const char *>(textureData) < size) {
-                qWarning("qtdf table too small in font '%s'.",
-                         qPrintable(font.familyName()));
-                return false;
-            }
+            const qsizetype pixelCount = qsizetype(width) * height;
 
-            createTexture(texInfo, width, height, textureData);
+            createTexture(texInfo, width, height,
+                          zeroCopy ? QByteArray::fromRawData(textureData, pixelCount)
+                                   : QByteArray(textureData, pixelCount));
 
             QVector<glyph_t> glyphs = glyphTextures.value(texInfo);
 
@@ -501,7 +644,7 @@ bool QSGRhiDistanceFieldGlyphCache::loadPregeneratedCache(const QRawFont &font)
 
             setGlyphsTexture(glyphs, t);
 
-            textureData += size;
+            textureData += pixelCount;
         }
     }
 
@@ -30,7 +30,7 @@ public:
     virtual ~QSGRhiDistanceFieldGlyphCache();
 
     void requestGlyphs(const QSet<glyph_t> &glyphs) override;
-    void storeGlyphs(const QList<QDistanceField> &glyphs) override;
+    void storeGlyphs(const QList<GlyphDistanceField> &glyphs) override;
     void referenceGlyphs(const QSet<glyph_t> &glyphs) override;
     void releaseGlyphs(const QSet<glyph_t> &glyphs) override;
 
@@ -47,12 +47,16 @@ public:
     bool eightBitFormatIsAlphaSwizzled() const override;
     bool screenSpaceDerivativesSupported() const override;
 
+    static QString atlasFileName(const QRawFont &font, int renderTypeQuality);
+    bool loadAtlas(const QRawFont &font, const QByteArray &atlas);
+
 #if defined(QSG_DISTANCEFIELD_CACHE_DEBUG)
     void saveTexture(QRhiTexture *texture, const QString &nameBase) const override;
 #endif
 
 private:
     bool loadPregeneratedCache(const QRawFont &font);
+    bool loadPregeneratedCache(const QRawFont &font, const char *data, qsizetype size, bool zeroCopy);
 
     struct TextureInfo {
         QRhiTexture *texture;
@@ -65,7 +69,7 @@ private:
         TextureInfo(const QRect &preallocRect = QRect()) : texture(nullptr), allocatedArea(preallocRect) { }
     };
 
-    void createTexture(TextureInfo *texInfo, int width, int height, const void *pixels);
+    void createTexture(TextureInfo *texInfo, int width, int height, const QByteArray &pixels);
     void createTexture(TextureInfo *texInfo, int width, int height);
     void resizeTexture(TextureInfo *texInfo, int width, int height);
 
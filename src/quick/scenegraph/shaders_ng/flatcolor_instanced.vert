@@ -0,0 +1,19 @@
+#version 440
+
+layout(location = 0) in vec4 vertexCoord;
+layout(location = 6) in vec4 qt_InstanceRowX;
+layout(location = 7) in vec4 qt_InstanceRowY;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 matrix;
+    vec4 color;
+} ubuf;
+
+out gl_PerVertex { vec4 gl_Position; };
+
+void main()
+{
+    vec3 p = vec3(vertexCoord.xy, 1.0);
+    gl_Position = ubuf.matrix * vec4(dot(qt_InstanceRowX.xyz, p), dot(qt_InstanceRowY.xyz, p), vertexCoord.zw);
+    gl_Position.z = (gl_Position.z + qt_InstanceRowX.w) * gl_Position.w;
+}
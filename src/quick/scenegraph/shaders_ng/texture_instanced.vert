@@ -0,0 +1,23 @@
+#version 440
+
+layout(location = 0) in vec4 qt_VertexPosition;
+layout(location = 1) in vec2 qt_VertexTexCoord;
+layout(location = 6) in vec4 qt_InstanceRowX;
+layout(location = 7) in vec4 qt_InstanceRowY;
+
+layout(location = 0) out vec2 qt_TexCoord;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float opacity;
+} ubuf;
+
+out gl_PerVertex { vec4 gl_Position; };
+
+void main()
+{
+    qt_TexCoord = qt_VertexTexCoord;
+    vec3 p = vec3(qt_VertexPosition.xy, 1.0);
+    gl_Position = ubuf.qt_Matrix * vec4(dot(qt_InstanceRowX.xyz, p), dot(qt_InstanceRowY.xyz, p), qt_VertexPosition.zw);
+    gl_Position.z = (gl_Position.z + qt_InstanceRowX.w) * gl_Position.w;
+}
@@ -81,6 +81,31 @@ bool QSGAreaAllocator::deallocate(const QRect &rect)
     return deallocateInNode(rect.topLeft(), m_root);
 }
 
+// Returns the area of the largest free rectangle, which together with the
+// total free area tells how fragmented the allocator is.
+qint64 QSGAreaAllocator::largestFreeArea() const
+{
+    return largestFreeAreaInNode(QRect(QPoint(0, 0), m_size), m_root);
+}
+
+qint64 QSGAreaAllocator::largestFreeAreaInNode(const QRect &currentRect, QSGAreaAllocatorNode *node) const
+{
+    if (node->isLeaf())
+        return node->isOccupied ? 0 : qint64(currentRect.width()) * currentRect.height();
+
+    QRect leftRect = currentRect;
+    QRect rightRect = currentRect;
+    if (node->splitType == HorizontalSplit) {
+        leftRect.setHeight(node->split - leftRect.top());
+        rightRect.setTop(node->split);
+    } else {
+        leftRect.setWidth(node->split - leftRect.left());
+        rightRect.setLeft(node->split);
+    }
+    return qMax(largestFreeAreaInNode(leftRect, node->left),
+                largestFreeAreaInNode(rightRect, node->right));
+}
+
 bool QSGAreaAllocator::allocateInNode(const QSize &size, QPoint &result, const QRect &currentRect, QSGAreaAllocatorNode *node)
 {
     if (size.width() > currentRect.width() || size.height() > currentRect.height())
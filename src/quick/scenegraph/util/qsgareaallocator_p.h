@@ -33,6 +33,7 @@ public:
     bool deallocate(const QRect &rect);
     bool isEmpty() const { return m_root == nullptr; }
     QSize size() const { return m_size; }
+    qint64 largestFreeArea() const;
 
     QByteArray serialize();
     const char *deserialize(const char *data, int size);
@@ -40,6 +41,7 @@ public:
 private:
     bool allocateInNode(const QSize &size, QPoint &result, const QRect &currentRect, QSGAreaAllocatorNode *node);
     bool deallocateInNode(const QPoint &pos, QSGAreaAllocatorNode *node);
+    qint64 largestFreeAreaInNode(const QRect &currentRect, QSGAreaAllocatorNode *node) const;
     void mergeNodeWithNeighbors(QSGAreaAllocatorNode *node);
 
     QSGAreaAllocatorNode *m_root;
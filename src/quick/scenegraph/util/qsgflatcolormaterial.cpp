@@ -22,6 +22,8 @@ FlatColorMaterialRhiShader::FlatColorMaterialRhiShader()
 {
     setShaderFileName(VertexStage, QStringLiteral(":/qt-project.org/scenegraph/shaders_ng/flatcolor.vert.qsb"));
     setShaderFileName(FragmentStage, QStringLiteral(":/qt-project.org/scenegraph/shaders_ng/flatcolor.frag.qsb"));
+    QSGMaterialShaderPrivate::get(this)->setInstancedVertexShaderFileName(
+            QStringLiteral(":/qt-project.org/scenegraph/shaders_ng/flatcolor_instanced.vert.qsb"));
 }
 
 bool FlatColorMaterialRhiShader::updateUniformData(RenderState &state,
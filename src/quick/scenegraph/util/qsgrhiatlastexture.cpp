@@ -51,22 +51,29 @@ Manager::Manager(QSGDefaultRenderContext *rc, const QSize &surfacePixelSize, QSu
     m_atlas_size_limit = qt_sg_envInt("QSG_ATLAS_SIZE_LIMIT", qMax(w, h) / 2);
     m_atlas_size = QSize(w, h);
 
-    qCDebug(QSG_LOG_INFO, "rhi texture atlas dimensions: %dx%d", w, h);
+    // When the atlas is too full or fragmented for a new image, further
+    // atlas pages can be added up to this limit before falling back to
+    // standalone textures. Each page costs a full atlas texture, so there is
+    // only one unless asked for. Pages other than the first one are released
+    // once they are empty.
+    m_atlas_page_limit = qMax(1, qt_sg_envInt("QSG_ATLAS_PAGES", 1));
+
+    qCDebug(QSG_LOG_INFO, "rhi texture atlas dimensions: %dx%d, up to %d pages", w, h, m_atlas_page_limit);
 }
 
 Manager::~Manager()
 {
-    Q_ASSERT(m_atlas == nullptr);
+    Q_ASSERT(m_atlasPages.isEmpty());
     Q_ASSERT(m_atlases.isEmpty());
 }
 
 void Manager::invalidate()
 {
-    if (m_atlas) {
-        m_atlas->invalidate();
-        m_atlas->deleteLater();
-        m_atlas = nullptr;
+    for (Atlas *atlas : qAsConst(m_atlasPages)) {
+        atlas->invalidate();
+        atlas->deleteLater();
     }
+    m_atlasPages.clear();
 
     QHash<unsigned int, QSGCompressedAtlasTexture::Atlas*>::iterator i = m_atlases.begin();
     while (i != m_atlases.end()) {
@@ -81,15 +88,49 @@ QSGTexture *Manager::create(const QImage &image, bool hasAlphaChannel)
 {
     Texture *t = nullptr;
     if (image.width() < m_atlas_size_limit && image.height() < m_atlas_size_limit) {
-        if (!m_atlas)
-            m_atlas = new Atlas(m_rc, m_atlas_size);
-        t = m_atlas->create(image);
+        // Earlier pages first, so that as many textures as possible share one
+        for (Atlas *atlas : qAsConst(m_atlasPages)) {
+            t = atlas->create(image);
+            if (t)
+                break;
+        }
+
+        if (!t) {
+            if (QSG_LOG_ATLAS().isDebugEnabled()) {
+                qCDebug(QSG_LOG_ATLAS, "no room for %dx%d in %d atlas page(s)",
+                        image.width(), image.height(), int(m_atlasPages.size()));
+                for (Atlas *atlas : qAsConst(m_atlasPages))
+                    atlas->logStatistics("full");
+            }
+
+            if (m_atlasPages.size() < m_atlas_page_limit) {
+                Atlas *atlas = new Atlas(m_rc, m_atlas_size);
+                m_atlasPages.append(atlas);
+                t = atlas->create(image);
+                qCDebug(QSG_LOG_ATLAS, "added atlas page %d", int(m_atlasPages.size()));
+            }
+        }
+
         if (t && !hasAlphaChannel && t->hasAlphaChannel())
             t->setHasAlphaChannel(false);
     }
     return t;
 }
 
+void Manager::releaseEmptyPages()
+{
+    // The first page stays, it is the one most likely to be needed again
+    for (int i = m_atlasPages.size() - 1; i > 0; --i) {
+        Atlas *atlas = m_atlasPages.at(i);
+        if (atlas->textureCount() > 0)
+            continue;
+        atlas->releaseTexture();
+        delete atlas;
+        m_atlasPages.remove(i);
+        qCDebug(QSG_LOG_ATLAS, "released empty atlas page, %d left", int(m_atlasPages.size()));
+    }
+}
+
 QSGTexture *Manager::create(const QSGCompressedTextureFactory *factory)
 {
     QSGTexture *t = nullptr;
@@ -134,6 +175,16 @@ void AtlasBase::invalidate()
     m_texture = nullptr;
 }
 
+// Unlike invalidate(), this may be called while frames using the texture are
+// still in flight.
+void AtlasBase::releaseTexture()
+{
+    if (m_texture) {
+        m_texture->deleteLater();
+        m_texture = nullptr;
+    }
+}
+
 void AtlasBase::commitTextureOperations(QRhiResourceUpdateBatch *resourceUpdates)
 {
     if (!m_allocated) {
@@ -155,6 +206,23 @@ void AtlasBase::remove(TextureBase *t)
     QRect atlasRect = t->atlasSubRect();
     m_allocator.deallocate(atlasRect);
     m_pending_uploads.removeOne(t);
+
+    --m_textureCount;
+    m_usedArea -= qint64(atlasRect.width()) * atlasRect.height();
+}
+
+void AtlasBase::logStatistics(const char *description) const
+{
+    // Fragmentation is the share of the free area outside of the largest free
+    // rectangle: when it is high, images fail to fit even though there is room.
+    const qint64 totalArea = qint64(m_size.width()) * m_size.height();
+    const qint64 freeArea = totalArea - m_usedArea;
+    const qint64 largestFreeArea = m_allocator.largestFreeArea();
+    qCDebug(QSG_LOG_ATLAS, "atlas %p (%s): %d textures, %.1f%% occupied, %.1f%% fragmented, largest free area %lld pixels",
+            this, description, m_textureCount,
+            totalArea > 0 ? 100.0 * m_usedArea / totalArea : 0.0,
+            freeArea > 0 ? 100.0 * (freeArea - qMin(largestFreeArea, freeArea)) / freeArea : 0.0,
+            largestFreeArea);
 }
 
 Atlas::Atlas(QSGDefaultRenderContext *rc, const QSize &size)
@@ -311,6 +379,8 @@ TextureBase::TextureBase(AtlasBase *atlas, const QRect &textureRect)
     , m_allocated_rect(textureRect)
     , m_atlas(atlas)
 {
+    ++m_atlas->m_textureCount;
+    m_atlas->m_usedArea += qint64(textureRect.width()) * textureRect.height();
 }
 
 TextureBase::~TextureBase()
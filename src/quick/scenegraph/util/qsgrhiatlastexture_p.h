@@ -48,16 +48,18 @@ public:
     QSGTexture *create(const QImage &image, bool hasAlphaChannel);
     QSGTexture *create(const QSGCompressedTextureFactory *factory);
     void invalidate();
+    void releaseEmptyPages();
 
 private:
     QSGDefaultRenderContext *m_rc;
     QRhi *m_rhi;
-    Atlas *m_atlas = nullptr;
+    QVector<Atlas *> m_atlasPages;
     // set of atlases for different compressed formats
     QHash<unsigned int, QSGCompressedAtlasTexture::Atlas*> m_atlases;
 
     QSize m_atlas_size;
     int m_atlas_size_limit;
+    int m_atlas_page_limit;
 };
 
 class AtlasBase : public QObject
@@ -68,13 +70,17 @@ public:
     ~AtlasBase();
 
     void invalidate();
+    void releaseTexture();
     void commitTextureOperations(QRhiResourceUpdateBatch *resourceUpdates);
     void remove(TextureBase *t);
+    void logStatistics(const char *description) const;
 
     QSGDefaultRenderContext *renderContext() const { return m_rc; }
     QRhi *rhi() const { return m_rhi; }
     QRhiTexture *texture() const { return m_texture; }
     QSize size() const { return m_size; }
+    int textureCount() const { return m_textureCount; }
+    qint64 usedArea() const { return m_usedArea; }
 
 protected:
     virtual bool generateTexture() = 0;
@@ -87,6 +93,8 @@ protected:
     QRhiTexture *m_texture = nullptr;
     QSize m_size;
     QVector<TextureBase *> m_pending_uploads;
+    int m_textureCount = 0;
+    qint64 m_usedArea = 0;
     friend class TextureBase;
     friend class TextureBasePrivate;
 
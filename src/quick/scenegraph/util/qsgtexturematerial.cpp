@@ -3,6 +3,7 @@
 
 #include "qsgtexturematerial_p.h"
 #include <private/qsgtexture_p.h>
+#include <private/qsgmaterialshader_p.h>
 #include <QtGui/private/qrhi_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -17,6 +18,8 @@ QSGOpaqueTextureMaterialRhiShader::QSGOpaqueTextureMaterialRhiShader()
 {
     setShaderFileName(VertexStage, QStringLiteral(":/qt-project.org/scenegraph/shaders_ng/opaquetexture.vert.qsb"));
     setShaderFileName(FragmentStage, QStringLiteral(":/qt-project.org/scenegraph/shaders_ng/opaquetexture.frag.qsb"));
+    QSGMaterialShaderPrivate::get(this)->setInstancedVertexShaderFileName(
+            QStringLiteral(":/qt-project.org/scenegraph/shaders_ng/opaquetexture_instanced.vert.qsb"));
 }
 
 bool QSGOpaqueTextureMaterialRhiShader::updateUniformData(RenderState &state, QSGMaterial *, QSGMaterial *)
@@ -341,6 +344,8 @@ QSGTextureMaterialRhiShader::QSGTextureMaterialRhiShader()
 {
     setShaderFileName(VertexStage, QStringLiteral(":/qt-project.org/scenegraph/shaders_ng/texture.vert.qsb"));
     setShaderFileName(FragmentStage, QStringLiteral(":/qt-project.org/scenegraph/shaders_ng/texture.frag.qsb"));
+    QSGMaterialShaderPrivate::get(this)->setInstancedVertexShaderFileName(
+            QStringLiteral(":/qt-project.org/scenegraph/shaders_ng/texture_instanced.vert.qsb"));
 }
 
 bool QSGTextureMaterialRhiShader::updateUniformData(RenderState &state, QSGMaterial *newMaterial, QSGMaterial *oldMaterial)
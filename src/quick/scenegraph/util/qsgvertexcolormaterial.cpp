@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qsgvertexcolormaterial.h"
+#include <private/qsgmaterialshader_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -17,6 +18,8 @@ QSGVertexColorMaterialRhiShader::QSGVertexColorMaterialRhiShader()
 {
     setShaderFileName(VertexStage, QStringLiteral(":/qt-project.org/scenegraph/shaders_ng/vertexcolor.vert.qsb"));
     setShaderFileName(FragmentStage, QStringLiteral(":/qt-project.org/scenegraph/shaders_ng/vertexcolor.frag.qsb"));
+    QSGMaterialShaderPrivate::get(this)->setInstancedVertexShaderFileName(
+            QStringLiteral(":/qt-project.org/scenegraph/shaders_ng/vertexcolor_instanced.vert.qsb"));
 }
 
 bool QSGVertexColorMaterialRhiShader::updateUniformData(RenderState &state,
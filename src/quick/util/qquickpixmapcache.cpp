@@ -24,10 +24,15 @@
 #include <QtCore/qfile.h>
 #include <QtCore/qthread.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
 #include <QtCore/qbuffer.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qmetaobject.h>
 
+#if QT_CONFIG(thread)
+#include <QtCore/qthreadpool.h>
+#endif
+
 #if QT_CONFIG(qml_network)
 #include <QtQml/qqmlnetworkaccessmanagerfactory.h>
 #include <QtNetwork/qnetworkreply.h>
@@ -103,6 +108,7 @@ public:
     QUrl url;
 
     bool loading;
+    bool lowPriority;
     QQuickImageProviderOptions providerOptions;
     int redirectCount;
 
@@ -157,8 +163,9 @@ public:
     QQuickPixmapReader(QQmlEngine *eng);
     ~QQuickPixmapReader();
 
-    QQuickPixmapReply *getImage(QQuickPixmapData *);
+    QQuickPixmapReply *getImage(QQuickPixmapData *, bool lowPriority = false);
     void cancel(QQuickPixmapReply *rep);
+    void setLowPriority(QQuickPixmapReply *rep, bool lowPriority);
 
     static QQuickPixmapReader *instance(QQmlEngine *engine);
     static QQuickPixmapReader *existingInstance(QQmlEngine *engine);
@@ -170,6 +177,7 @@ private:
     friend class QQuickPixmapReaderThreadObject;
     void processJobs();
     void processJob(QQuickPixmapReply *, const QUrl &, const QString &, QQuickImageProvider::ImageType, const QSharedPointer<QQuickImageProvider> &);
+    void readLocalFile(QQuickPixmapReply *, const QUrl &, const QString &);
 #if QT_CONFIG(qml_network)
     void networkRequestDone(QNetworkReply *);
 #endif
@@ -190,6 +198,14 @@ private:
 #endif
     QHash<QQuickImageResponse*,QQuickPixmapReply*> asyncResponses;
 
+#if QT_CONFIG(thread)
+    // Local files are decoded on a pool of worker threads, so that a view full of images doesn't
+    // have to wait for them one after another. The reader thread keeps dispatching the jobs in
+    // order of priority and handles network and image provider requests.
+    QThreadPool *decodePool;
+    QSet<QQuickPixmapReply *> decodingJobs;
+#endif
+
     static int replyDownloadProgress;
     static int replyFinished;
     static int downloadProgress;
@@ -475,12 +491,37 @@ static QString existingImageFileForPath(const QString &localFile)
     return localFile;
 }
 
+#if QT_CONFIG(thread)
+static int decodeThreadCount()
+{
+    static const int count = [] {
+        bool ok = false;
+        const int configured = qEnvironmentVariableIntValue("QML_PIXMAP_READER_THREADS", &ok);
+        if (ok)
+            return qMax(0, configured);
+        return qBound(1, QThread::idealThreadCount() - 1, 4);
+    }();
+    return count;
+}
+#endif
+
 QQuickPixmapReader::QQuickPixmapReader(QQmlEngine *eng)
 : QThread(eng), engine(eng), threadObject(nullptr)
 #if QT_CONFIG(qml_network)
 , accessManager(nullptr)
 #endif
+#if QT_CONFIG(thread)
+, decodePool(nullptr)
+#endif
 {
+#if QT_CONFIG(thread)
+    if (const int threadCount = decodeThreadCount()) {
+        decodePool = new QThreadPool;
+        decodePool->setObjectName(QStringLiteral("QQuickPixmapReader"));
+        decodePool->setMaxThreadCount(threadCount);
+        decodePool->setThreadPriority(QThread::LowestPriority);
+    }
+#endif
     eventLoopQuitHack = new QObject;
     eventLoopQuitHack->moveToThread(this);
     connect(eventLoopQuitHack, SIGNAL(destroyed(QObject*)), SLOT(quit()), Qt::DirectConnection);
@@ -519,12 +560,27 @@ QQuickPixmapReader::~QQuickPixmapReader()
 
     for (auto *reply : qAsConst(asyncResponses))
         cancelJob(reply);
+#endif
+#if QT_CONFIG(thread)
+    for (QQuickPixmapReply *reply : qAsConst(decodingJobs)) {
+        cancelled.append(reply);
+        reply->data = nullptr;
+    }
 #endif
     if (threadObject) threadObject->processJobs();
     mutex.unlock();
 
+#if QT_CONFIG(thread)
+    if (decodePool)
+        decodePool->waitForDone();
+#endif
+
     eventLoopQuitHack->deleteLater();
     wait();
+
+#if QT_CONFIG(thread)
+    delete decodePool;
+#endif
 }
 
 #if QT_CONFIG(qml_network)
@@ -674,8 +730,16 @@ void QQuickPixmapReader::processJobs()
 
         // Clean cancelled jobs
         if (!cancelled.isEmpty()) {
+            QList<QQuickPixmapReply *> stillDecoding;
             for (int i = 0; i < cancelled.count(); ++i) {
                 QQuickPixmapReply *job = cancelled.at(i);
+#if QT_CONFIG(thread)
+                // The worker still uses the job. It wakes us up again once it's done.
+                if (decodingJobs.contains(job)) {
+                    stillDecoding.append(job);
+                    continue;
+                }
+#endif
 #if QT_CONFIG(qml_network)
                 QNetworkReply *reply = networkJobs.key(job, 0);
                 if (reply) {
@@ -696,14 +760,25 @@ void QQuickPixmapReader::processJobs()
                 // deleteLater, since not owned by this thread
                 job->deleteLater();
             }
-            cancelled.clear();
+            cancelled = std::move(stillDecoding);
+            if (jobs.isEmpty())
+                return;
         }
 
         if (!jobs.isEmpty()) {
-            // Find a job we can use
+            // Find a job we can use, preferring the most recent requests of items that are visible
             bool usableJob = false;
-            for (int i = jobs.count() - 1; !usableJob && i >= 0; i--) {
+            for (int i = jobs.count() - 1, pass = 0; !usableJob && pass < 2; i--) {
+                if (i < 0) {
+                    i = jobs.count();
+                    ++pass;
+                    continue;
+                }
+
                 QQuickPixmapReply *job = jobs.at(i);
+                if (job->lowPriority != (pass == 1))
+                    continue;
+
                 const QUrl url = job->url;
                 QString localFile;
                 QQuickImageProvider::ImageType imageType = QQuickImageProvider::Invalid;
@@ -718,11 +793,19 @@ void QQuickPixmapReader::processJobs()
                     usableJob = true;
                 } else {
                     localFile = QQmlFile::urlToLocalFileOrQrc(url);
-                    usableJob = !localFile.isEmpty()
+                    if (!localFile.isEmpty()) {
+#if QT_CONFIG(thread)
+                        usableJob = !decodePool || (job->data && job->data->specialDevice)
+                                || decodingJobs.size() < decodePool->maxThreadCount();
+#else
+                        usableJob = true;
+#endif
+                    }
 #if QT_CONFIG(qml_network)
-                            || networkJobs.count() < IMAGEREQUEST_MAX_NETWORK_REQUEST_COUNT
+                    else {
+                        usableJob = networkJobs.count() < IMAGEREQUEST_MAX_NETWORK_REQUEST_COUNT;
+                    }
 #endif
-                            ;
                 }
 
 
@@ -733,6 +816,17 @@ void QQuickPixmapReader::processJobs()
 
                     PIXMAP_PROFILE(pixmapStateChanged<QQuickProfiler::PixmapLoadingStarted>(url));
 
+#if QT_CONFIG(thread)
+                    if (decodePool && !localFile.isEmpty()
+                            && !(job->data && job->data->specialDevice)) {
+                        decodingJobs.insert(job);
+                        decodePool->start([this, job, url, localFile]() {
+                            readLocalFile(job, url, localFile);
+                        });
+                        continue;
+                    }
+#endif
+
                     locker.unlock();
                     processJob(job, url, localFile, imageType, provider);
                     locker.relock();
@@ -873,62 +967,7 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
     } else {
         if (!localFile.isEmpty()) {
             // Image is local - load/decode immediately
-            QImage image;
-            QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
-            QString errorStr;
-            QSize readSize;
-
-            if (runningJob->data && runningJob->data->specialDevice) {
-                int frameCount;
-                int const frame = runningJob->data ? runningJob->data->frame : 0;
-                if (!readImage(url, runningJob->data->specialDevice, &image, &errorStr, &readSize, &frameCount,
-                               runningJob->requestRegion, runningJob->requestSize,
-                               runningJob->providerOptions, nullptr, frame)) {
-                    errorCode = QQuickPixmapReply::Loading;
-                } else if (runningJob->data) {
-                    runningJob->data->frameCount = frameCount;
-                }
-            } else {
-                QFile f(existingImageFileForPath(localFile));
-                if (f.open(QIODevice::ReadOnly)) {
-                    QSGTextureReader texReader(&f, localFile);
-                    if (backendSupport()->hasOpenGL && texReader.isTexture()) {
-                        QQuickTextureFactory *factory = texReader.read();
-                        if (factory) {
-                            readSize = factory->textureSize();
-                        } else {
-                            errorStr = QQuickPixmap::tr("Error decoding: %1").arg(url.toString());
-                            if (f.fileName() != localFile)
-                                errorStr += QString::fromLatin1(" (%1)").arg(f.fileName());
-                            errorCode = QQuickPixmapReply::Decoding;
-                        }
-                        mutex.lock();
-                        if (!cancelled.contains(runningJob))
-                            runningJob->postReply(errorCode, errorStr, readSize, factory);
-                        mutex.unlock();
-                        return;
-                    } else {
-                        int frameCount;
-                        int const frame = runningJob->data ? runningJob->data->frame : 0;
-                        if (!readImage(url, &f, &image, &errorStr, &readSize, &frameCount,
-                                       runningJob->requestRegion, runningJob->requestSize,
-                                       runningJob->providerOptions, nullptr, frame)) {
-                            errorCode = QQuickPixmapReply::Loading;
-                            if (f.fileName() != localFile)
-                                errorStr += QString::fromLatin1(" (%1)").arg(f.fileName());
-                        } else if (runningJob->data) {
-                            runningJob->data->frameCount = frameCount;
-                        }
-                    }
-                } else {
-                    errorStr = QQuickPixmap::tr("Cannot open: %1").arg(url.toString());
-                    errorCode = QQuickPixmapReply::Loading;
-                }
-            }
-            mutex.lock();
-            if (!cancelled.contains(runningJob))
-                runningJob->postReply(errorCode, errorStr, readSize, QQuickTextureFactory::textureFactoryForImage(image));
-            mutex.unlock();
+            readLocalFile(runningJob, url, localFile);
         } else {
 #if QT_CONFIG(qml_network)
             // Network resource
@@ -947,6 +986,85 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
     }
 }
 
+/*!
+    \internal
+    Reads and decodes the local file of \a runningJob. This runs on the reader thread for jobs
+    with a special device, and on one of the decode threads otherwise.
+*/
+void QQuickPixmapReader::readLocalFile(QQuickPixmapReply *runningJob, const QUrl &url, const QString &localFile)
+{
+    QImage image;
+    QQuickTextureFactory *factory = nullptr;
+    QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
+    QString errorStr;
+    QSize readSize;
+    int frameCount = -1;
+
+    // cancel() resets runningJob->data under the mutex while we may be decoding on another thread
+    QIODevice *specialDevice = nullptr;
+    int frame = 0;
+    {
+        QMutexLocker locker(&mutex);
+        if (runningJob->data) {
+            specialDevice = runningJob->data->specialDevice;
+            frame = runningJob->data->frame;
+        }
+    }
+
+    if (specialDevice) {
+        if (!readImage(url, specialDevice, &image, &errorStr, &readSize, &frameCount,
+                       runningJob->requestRegion, runningJob->requestSize,
+                       runningJob->providerOptions, nullptr, frame)) {
+            errorCode = QQuickPixmapReply::Loading;
+        }
+    } else {
+        QFile f(existingImageFileForPath(localFile));
+        if (f.open(QIODevice::ReadOnly)) {
+            QSGTextureReader texReader(&f, localFile);
+            if (backendSupport()->hasOpenGL && texReader.isTexture()) {
+                factory = texReader.read();
+                if (factory) {
+                    readSize = factory->textureSize();
+                } else {
+                    errorStr = QQuickPixmap::tr("Error decoding: %1").arg(url.toString());
+                    if (f.fileName() != localFile)
+                        errorStr += QString::fromLatin1(" (%1)").arg(f.fileName());
+                    errorCode = QQuickPixmapReply::Decoding;
+                }
+            } else {
+                if (!readImage(url, &f, &image, &errorStr, &readSize, &frameCount,
+                               runningJob->requestRegion, runningJob->requestSize,
+                               runningJob->providerOptions, nullptr, frame)) {
+                    errorCode = QQuickPixmapReply::Loading;
+                    if (f.fileName() != localFile)
+                        errorStr += QString::fromLatin1(" (%1)").arg(f.fileName());
+                }
+            }
+        } else {
+            errorStr = QQuickPixmap::tr("Cannot open: %1").arg(url.toString());
+            errorCode = QQuickPixmapReply::Loading;
+        }
+    }
+
+    if (!factory)
+        factory = QQuickTextureFactory::textureFactoryForImage(image);
+
+    QMutexLocker locker(&mutex);
+    if (!cancelled.contains(runningJob)) {
+        if (errorCode == QQuickPixmapReply::NoError && frameCount >= 0 && runningJob->data)
+            runningJob->data->frameCount = frameCount;
+        runningJob->postReply(errorCode, errorStr, readSize, factory);
+    } else {
+        delete factory;
+    }
+
+#if QT_CONFIG(thread)
+    // A decode thread became free, and a cancelled job may be waiting to be cleaned up.
+    if (decodingJobs.remove(runningJob) && threadObject)
+        threadObject->processJobs();
+#endif
+}
+
 QQuickPixmapReader *QQuickPixmapReader::instance(QQmlEngine *engine)
 {
     // XXX NOTE: must be called within readerMutex locking.
@@ -965,11 +1083,12 @@ QQuickPixmapReader *QQuickPixmapReader::existingInstance(QQmlEngine *engine)
     return readers.value(engine, 0);
 }
 
-QQuickPixmapReply *QQuickPixmapReader::getImage(QQuickPixmapData *data)
+QQuickPixmapReply *QQuickPixmapReader::getImage(QQuickPixmapData *data, bool lowPriority)
 {
     mutex.lock();
     QQuickPixmapReply *reply = new QQuickPixmapReply(data);
     reply->engineForReader = engine;
+    reply->lowPriority = lowPriority;
     jobs.append(reply);
     // XXX
     if (threadObject) threadObject->processJobs();
@@ -996,6 +1115,13 @@ void QQuickPixmapReader::cancel(QQuickPixmapReply *reply)
     mutex.unlock();
 }
 
+void QQuickPixmapReader::setLowPriority(QQuickPixmapReply *reply, bool lowPriority)
+{
+    // Only has an effect as long as the job is still queued.
+    QMutexLocker locker(&mutex);
+    reply->lowPriority = lowPriority;
+}
+
 void QQuickPixmapReader::run()
 {
     if (replyDownloadProgress == -1) {
@@ -1211,7 +1337,7 @@ void QQuickPixmap::purgeCache()
 
 QQuickPixmapReply::QQuickPixmapReply(QQuickPixmapData *d)
   : data(d), engineForReader(nullptr), requestRegion(d->requestRegion), requestSize(d->requestSize),
-    url(d->url), loading(false), providerOptions(d->providerOptions), redirectCount(0)
+    url(d->url), loading(false), lowPriority(false), providerOptions(d->providerOptions), redirectCount(0)
 {
     if (finishedIndex == -1) {
         finishedIndex = QMetaMethod::fromSignal(&QQuickPixmapReply::finished).methodIndex();
@@ -1724,7 +1850,8 @@ void QQuickPixmap::load(QQmlEngine *engine, const QUrl &url, const QRect &reques
 #endif
 
         QQuickPixmapReader::readerMutex.lock();
-        d->reply = QQuickPixmapReader::instance(engine)->getImage(d);
+        d->reply = QQuickPixmapReader::instance(engine)->getImage(
+                d, options & QQuickPixmap::LowPriority);
         QQuickPixmapReader::readerMutex.unlock();
     } else {
         d = *iter;
@@ -1793,6 +1920,20 @@ void QQuickPixmap::clear(QObject *obj)
     }
 }
 
+/*! \internal
+    Requests the image to be loaded after all requests without \a lowPriority, for example
+    because the item showing it is not visible. This has no effect once loading has started.
+*/
+void QQuickPixmap::setLowPriority(bool lowPriority)
+{
+    if (!d || !d->reply)
+        return;
+
+    QMutexLocker locker(&QQuickPixmapReader::readerMutex);
+    if (QQuickPixmapReader *reader = QQuickPixmapReader::existingInstance(d->reply->engineForReader))
+        reader->setLowPriority(d->reply, lowPriority);
+}
+
 bool QQuickPixmap::isCached(const QUrl &url, const QRect &requestRegion, const QSize &requestSize,
                             const int frame, const QQuickImageProviderOptions &options)
 {
@@ -102,7 +102,8 @@ public:
 
     enum Option {
         Asynchronous = 0x00000001,
-        Cache        = 0x00000002
+        Cache        = 0x00000002,
+        LowPriority  = 0x00000004
     };
     Q_DECLARE_FLAGS(Options, Option)
 
@@ -145,6 +146,8 @@ public:
     void clear();
     void clear(QObject *);
 
+    void setLowPriority(bool lowPriority);
+
     bool connectFinished(QObject *, const char *);
     bool connectFinished(QObject *, int);
     bool connectDownloadProgress(QObject *, const char *);
@@ -264,6 +264,9 @@ private slots:
     void jsExponentiate();
     void arrayBuffer();
     void staticInNestedClasses();
+    void jitGetLookup();
+    void jitDoubleArithmetic();
+    void polymorphicLookupAccessorCalledOnce();
 
 public:
     Q_INVOKABLE QJSValue throwingCppMethod1();
@@ -5647,6 +5650,83 @@ void tst_QJSEngine::staticInNestedClasses()
     QCOMPARE(engine.evaluate(program).toString(), u"a"_s);
 }
 
+void tst_QJSEngine::jitGetLookup()
+{
+    // Compile right away, before the lookup has seen any objects.
+    TemporaryJitThreshold threshold(0);
+    Q_UNUSED(threshold);
+
+    QJSEngine engine;
+    const QString program = uR"(
+        function getX(o) { return o.x; }
+        var results = [];
+        var a = { x: 1 };
+        for (var i = 0; i < 4; ++i)
+            results.push(getX(a));      // cached internal class
+        a.x = 2;
+        results.push(getX(a));          // cached, new value
+        results.push(getX({ x: 3 }));   // same internal class as a
+        results.push(getX({ y: 0, x: 4 }));                 // different internal class
+        results.push(getX({ get x() { return 5; } }));      // accessor
+        results.push(getX("abc"));      // not an object
+        results.push(getX(a));          // the lookup is polymorphic now
+        try {
+            getX(null);
+        } catch (e) {
+            results.push(e instanceof TypeError);
+        }
+        results.join(",")
+    )"_s;
+
+    QCOMPARE(engine.evaluate(program).toString(), u"1,1,1,1,2,3,4,5,,2,true"_s);
+}
+
+void tst_QJSEngine::jitDoubleArithmetic()
+{
+    TemporaryJitThreshold threshold(0);
+    Q_UNUSED(threshold);
+
+    QJSEngine engine;
+    const QString program = uR"(
+        function add(a, b) { return a + b; }
+        function sub(a, b) { return a - b; }
+        function mul(a, b) { return a * b; }
+        var results = [];
+        for (var i = 0; i < 2; ++i) {
+            results.push(add(1, 2), add(1.5, 2), add(1, 2.25), add(0.5, 0.25),
+                         add(2147483647, 1), add(NaN, 1), add("1", 2), add(1.5, "x"),
+                         sub(1.5, 0.5), sub(-2147483648, 1), sub(Infinity, Infinity),
+                         mul(1.5, 4), mul(65536, 65536), mul(-0.5, 0), mul(2.5, true));
+        }
+        results.map(function(v) { return Object.is(v, -0) ? "-0" : String(v); }).join(",")
+    )"_s;
+
+    const QString expected = u"3,3.5,3.25,0.75,2147483648,NaN,12,1.5x,1,-2147483649,NaN,"
+                             "6,4294967296,-0,2.5"_s;
+    QCOMPARE(engine.evaluate(program).toString(), expected + u',' + expected);
+}
+
+void tst_QJSEngine::polymorphicLookupAccessorCalledOnce()
+{
+    QJSEngine engine;
+    const QString program = uR"(
+        function getX(o) { return o.x; }
+        function getY(o) { return o.y; }
+        var shapes = [{ x: 0, y: 0 }, { a: 0, x: 0, y: 0 }, { b: 0, x: 0, y: 0 }];
+        shapes.forEach(function(o) { getX(o); getY(o); }); // both sites are polymorphic now
+
+        var ownCalls = 0;
+        var withAccessor = { get x() { ++ownCalls; return 1; } };
+        var protoCalls = 0;
+        var inherited = Object.create({ get y() { ++protoCalls; return 2; } });
+
+        var results = [getX(withAccessor), getX(withAccessor), getY(inherited), getY(inherited)];
+        results.join(",") + ";" + ownCalls + "," + protoCalls
+    )"_s;
+
+    QCOMPARE(engine.evaluate(program).toString(), u"1,1,2,2;2,2"_s);
+}
+
 QTEST_MAIN(tst_QJSEngine)
 
 #include "tst_qjsengine.moc"
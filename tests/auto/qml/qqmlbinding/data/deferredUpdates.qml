@@ -0,0 +1,9 @@
+import QtQml
+
+QtObject {
+    property int a: 0
+    property int b: 0
+    property var counter: ({ sum: 0, doubled: 0 })
+    property int sum: { ++counter.sum; return a + b }
+    property int doubled: { ++counter.doubled; return sum + a + b }
+}
@@ -0,0 +1,9 @@
+import QtQml
+
+QtObject {
+    id: root
+    property int value: 0
+    property QtObject first: QtObject { property int copy: root.value }
+    property QtObject second: QtObject { property int copy: root.value }
+    property QtObject third: QtObject { property int copy: root.value }
+}
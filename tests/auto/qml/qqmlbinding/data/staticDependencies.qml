@@ -0,0 +1,22 @@
+import QtQml
+
+QtObject {
+    property int a: 1
+    property int b: 2
+    property QtObject other: QtObject {
+        id: helper
+        property int c: 3
+    }
+    property QtObject target: helper
+
+    property int sum: a + b * helper.c
+    property int chained: target.c
+    property int conditional: a > 1 ? b : helper.c
+
+    // helper belongs to the outer component, where "helper" may be shadowed by a property
+    property Component inner: Component {
+        QtObject {
+            property int outer: helper.c
+        }
+    }
+}
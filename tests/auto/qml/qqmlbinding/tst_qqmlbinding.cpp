@@ -1,10 +1,16 @@
 // Copyright (C) 2016 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 #include <qtest.h>
+#include <QtCore/qpointer.h>
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
+#include <QtQml/qqmlcontext.h>
 #include <QtQml/private/qqmlbind_p.h>
+#include <QtQml/private/qqmlbinding_p.h>
 #include <QtQml/private/qqmlcomponentattached_p.h>
+#include <QtQml/private/qqmlengine_p.h>
+#include <QtQml/private/qqmlproperty_p.h>
+#include <QtQml/private/qv4function_p.h>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 #include "WithBindableProperties.h"
@@ -37,6 +43,10 @@ private slots:
     void bindNaNToInt();
     void intOverflow();
     void generalizedGroupedProperties();
+    void deferredUpdates();
+    void deferredUpdatesDeletedTarget();
+    void staticDependencies();
+    void staticDependenciesContextProperty();
 
 private:
     QQmlEngine engine;
@@ -572,6 +582,163 @@ void tst_qqmlbinding::generalizedGroupedProperties()
     QCOMPARE(rootAttached->objectName(), QString());
 }
 
+void tst_qqmlbinding::deferredUpdates()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, testFileUrl("deferredUpdates.qml"));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    QScopedPointer<QObject> obj(c.create());
+    QVERIFY(!obj.isNull());
+
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(&engine);
+    ep->deferBindingUpdates = true;
+    const QJSValue counter = obj->property("counter").value<QJSValue>();
+    int sumEvaluations = counter.property("sum").toInt();
+    int doubledEvaluations = counter.property("doubled").toInt();
+    const quint64 avoided = ep->avoidedBindingEvaluations;
+
+    obj->setProperty("a", 1);
+    obj->setProperty("b", 2);
+    QCOMPARE(obj->property("sum").toInt(), 0);
+    QCOMPARE(obj->property("doubled").toInt(), 0);
+
+    // doubled is queued as soon as a changes, but it reads sum, so sum has
+    // to be evaluated first. Otherwise doubled would see the stale sum and
+    // be evaluated a second time once sum changes.
+    QQmlEnginePrivate::flushBindingUpdatesForCurrentThread();
+    QCOMPARE(obj->property("sum").toInt(), 3);
+    QCOMPARE(obj->property("doubled").toInt(), 6);
+    QCOMPARE(counter.property("sum").toInt(), sumEvaluations + 1);
+    QCOMPARE(counter.property("doubled").toInt(), doubledEvaluations + 1);
+    QVERIFY(ep->avoidedBindingEvaluations > avoided);
+
+    // Changes queued from the event loop are flushed there as well
+    sumEvaluations = counter.property("sum").toInt();
+    doubledEvaluations = counter.property("doubled").toInt();
+    obj->setProperty("b", 5);
+    QCOMPARE(obj->property("sum").toInt(), 3);
+    QTRY_COMPARE(obj->property("sum").toInt(), 6);
+    QCOMPARE(obj->property("doubled").toInt(), 12);
+    QCOMPARE(counter.property("sum").toInt(), sumEvaluations + 1);
+    QCOMPARE(counter.property("doubled").toInt(), doubledEvaluations + 1);
+}
+
+void tst_qqmlbinding::deferredUpdatesDeletedTarget()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, testFileUrl("deferredUpdatesDeletedTarget.qml"));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    QScopedPointer<QObject> obj(c.create());
+    QVERIFY(!obj.isNull());
+
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(&engine);
+    ep->deferBindingUpdates = true;
+    QObject *first = obj->property("first").value<QObject *>();
+    QPointer<QObject> second = obj->property("second").value<QObject *>();
+    QObject *third = obj->property("third").value<QObject *>();
+    QVERIFY(first);
+    QVERIFY(second);
+    QVERIFY(third);
+
+    // All three bindings are queued, and the queue keeps them alive
+    obj->setProperty("value", 1);
+    QCOMPARE(ep->queuedBindingUpdates.size(), 3);
+
+    delete first;
+    second->deleteLater();
+    QCoreApplication::sendPostedEvents(second, QEvent::DeferredDelete);
+    QVERIFY(second.isNull());
+
+    QQmlEnginePrivate::flushBindingUpdatesForCurrentThread();
+    QVERIFY(ep->queuedBindingUpdates.isEmpty());
+    QCOMPARE(third->property("copy").toInt(), 1);
+
+    // Nothing is queued for the destroyed targets anymore
+    obj->setProperty("value", 2);
+    QCOMPARE(ep->queuedBindingUpdates.size(), 1);
+    QQmlEnginePrivate::flushBindingUpdatesForCurrentThread();
+    QCOMPARE(third->property("copy").toInt(), 2);
+}
+
+void tst_qqmlbinding::staticDependencies()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, testFileUrl("staticDependencies.qml"));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    QScopedPointer<QObject> obj(c.create());
+    QVERIFY(!obj.isNull());
+
+    auto binding = [&](const char *name) {
+        return static_cast<QQmlBinding *>(
+                QQmlPropertyPrivate::binding(QQmlProperty(obj.data(), QLatin1String(name))));
+    };
+
+    QQmlBinding *sum = binding("sum");
+    QVERIFY(sum);
+    QVERIFY(sum->function()->hasStaticDependencies());
+    QVERIFY(sum->dependenciesSettled());
+    QVERIFY(!binding("chained")->function()->hasStaticDependencies());
+    QVERIFY(!binding("conditional")->function()->hasStaticDependencies());
+
+    QObject *other = obj->property("other").value<QObject *>();
+    QVERIFY(other);
+    QCOMPARE(obj->property("sum").toInt(), 7);
+    other->setProperty("c", 4);
+    QCOMPARE(obj->property("sum").toInt(), 9);
+    obj->setProperty("a", 5);
+    QCOMPARE(obj->property("sum").toInt(), 13);
+    obj->setProperty("b", 1);
+    QCOMPARE(obj->property("sum").toInt(), 9);
+    QCOMPARE(obj->property("conditional").toInt(), 1);
+    QCOMPARE(obj->property("chained").toInt(), 4);
+
+    QQmlComponent *inner = obj->property("inner").value<QQmlComponent *>();
+    QVERIFY(inner);
+    QScopedPointer<QObject> innerObj(inner->create());
+    QVERIFY(!innerObj.isNull());
+    QQmlBinding *outer = static_cast<QQmlBinding *>(
+            QQmlPropertyPrivate::binding(QQmlProperty(innerObj.data(), QLatin1String("outer"))));
+    QVERIFY(outer);
+    QVERIFY(!outer->function()->hasStaticDependencies());
+    QCOMPARE(innerObj->property("outer").toInt(), 4);
+}
+
+void tst_qqmlbinding::staticDependenciesContextProperty()
+{
+    QQmlEngine engine;
+    QQmlComponent themeComponent(&engine);
+    themeComponent.setData("import QtQml\nQtObject { property int size: 1 }", QUrl());
+    QScopedPointer<QObject> first(themeComponent.create());
+    QScopedPointer<QObject> second(themeComponent.create());
+    QVERIFY(!first.isNull());
+    QVERIFY(!second.isNull());
+    second->setProperty("size", 2);
+
+    QQmlContext context(engine.rootContext());
+    context.setContextProperty(QStringLiteral("Theme"), first.data());
+
+    QQmlComponent c(&engine, testFileUrl("staticDependenciesContextProperty.qml"));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    QScopedPointer<QObject> obj(c.create(&context));
+    QVERIFY(!obj.isNull());
+
+    QQmlBinding *size = static_cast<QQmlBinding *>(
+            QQmlPropertyPrivate::binding(QQmlProperty(obj.data(), QLatin1String("size"))));
+    QVERIFY(size);
+    QVERIFY(size->function()->hasStaticDependencies());
+    QVERIFY(size->dependenciesSettled());
+    QCOMPARE(obj->property("size").toInt(), 1);
+
+    // Replacing the context property has to capture the members of the new object
+    context.setContextProperty(QStringLiteral("Theme"), second.data());
+    QCOMPARE(obj->property("size").toInt(), 2);
+    second->setProperty("size", 3);
+    QCOMPARE(obj->property("size").toInt(), 3);
+    first->setProperty("size", 4);
+    QCOMPARE(obj->property("size").toInt(), 3);
+    QVERIFY(size->dependenciesSettled());
+}
+
 QTEST_MAIN(tst_qqmlbinding)
 
 #include "tst_qqmlbinding.moc"
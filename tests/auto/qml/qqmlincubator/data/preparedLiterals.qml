@@ -0,0 +1,7 @@
+import QtQml
+
+QtObject {
+    property point point: "1,2"
+    property size size: "3x4"
+    property url source: "image.png"
+}
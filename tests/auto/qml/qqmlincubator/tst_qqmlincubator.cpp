@@ -14,8 +14,10 @@
 #include <QQmlComponent>
 #include <QQmlIncubator>
 #include <private/qjsvalue_p.h>
+#include <private/qqmlcomponent_p.h>
 #include <private/qqmlincubator_p.h>
 #include <private/qqmlobjectcreator_p.h>
+#include <private/qv4executablecompilationunit_p.h>
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 
 class tst_qqmlincubator : public QQmlDataTest
@@ -47,6 +49,7 @@ private slots:
     void garbageCollection();
     void requiredProperties();
     void deleteInSetInitialState();
+    void preparedLiterals();
 
 private:
     QQmlIncubationController controller;
@@ -1240,6 +1243,39 @@ void tst_qqmlincubator::deleteInSetInitialState()
     QCOMPARE(incubator.object(), nullptr); // object was deleted
 }
 
+void tst_qqmlincubator::preparedLiterals()
+{
+    QQmlEngine engine;
+    QQmlIncubationController controller;
+    engine.setIncubationController(&controller);
+
+    QQmlComponent component(&engine, testFileUrl("preparedLiterals.qml"),
+                            QQmlComponent::Asynchronous);
+    QTRY_VERIFY2(component.isReady(), qPrintable(component.errorString()));
+
+    // The literals are converted by the type loader, before any instance exists
+    const auto unit = QQmlComponentPrivate::get(&component)->compilationUnit;
+    QCOMPARE(unit->convertedLiteralsPerObject.size(), unit->objectCount());
+    const QVector<QVariant> &literals = unit->convertedLiteralsPerObject.at(0);
+    QVERIFY(literals.contains(QVariant(QPointF(1, 2))));
+    QVERIFY(literals.contains(QVariant(QSizeF(3, 4))));
+    QVERIFY(literals.contains(QVariant(testFileUrl("image.png"))));
+
+    QQmlIncubator incubator;
+    component.create(incubator);
+    while (incubator.isLoading()) {
+        std::atomic<bool> b{false};
+        controller.incubateWhile(&b);
+    }
+    QVERIFY(incubator.isReady());
+
+    QScopedPointer<QObject> object(incubator.object());
+    QVERIFY(!object.isNull());
+    QCOMPARE(object->property("point").toPointF(), QPointF(1, 2));
+    QCOMPARE(object->property("size").toSizeF(), QSizeF(3, 4));
+    QCOMPARE(object->property("source").toUrl(), testFileUrl("image.png"));
+}
+
 QTEST_MAIN(tst_qqmlincubator)
 
 #include "tst_qqmlincubator.moc"
@@ -88,6 +88,7 @@ private slots:
     void assignLiteralSignalProperty();
     void assignQmlComponent();
     void assignValueTypes();
+    void replayConvertedLiterals();
     void assignTypeExtremes();
     void assignCompositeToType();
     void assignLiteralToVar();
@@ -890,6 +891,60 @@ void tst_qqmllanguage::assignValueTypes()
     QCOMPARE(object->property("mirroredEnumTriggeredChange").toBool(), false);
 }
 
+// Test that a second instance gets the same values from the recorded conversions
+void tst_qqmllanguage::replayConvertedLiterals()
+{
+    QQmlComponent component(&engine, testFileUrl("assignValueTypes.qml"));
+    VERIFY_ERRORS(0);
+    QScopedPointer<MyTypeObject> first(qobject_cast<MyTypeObject *>(component.create()));
+    QVERIFY(first != nullptr);
+
+    // The converted values are recorded with the compilation unit
+    const auto &plan = QQmlComponentPrivate::get(&component)->compilationUnit->convertedLiteralsPerObject;
+    const auto isRecorded = [&](const QVariant &value) {
+        for (const QVector<QVariant> &literals : plan) {
+            if (literals.contains(value))
+                return true;
+        }
+        return false;
+    };
+    const QUrl url = first->urlProperty();
+    const QColor color = first->colorProperty();
+    const QPoint point = first->pointProperty();
+    const QRectF rectF = first->rectFProperty();
+    const QDateTime dateTime = first->dateTimeProperty();
+    const QVector4D vector4 = first->vector4Property();
+    QVERIFY(isRecorded(QVariant(url)));
+    QVERIFY(isRecorded(QVariant(color)));
+    QVERIFY(isRecorded(QVariant(point)));
+    QVERIFY(isRecorded(QVariant(rectF)));
+
+    // Changes to the first instance don't leak into the replayed values
+    first->setUrlProperty(QUrl("other.qml"));
+    first->setColorProperty(QColor("blue"));
+    first->setPointProperty(QPoint(1, 2));
+    first->setRectFProperty(QRectF(1, 2, 3, 4));
+    first->setEnumProperty(MyTypeObject::EnumVal1);
+    first->setQtEnumProperty(Qt::PlainText);
+
+    QScopedPointer<MyTypeObject> second(qobject_cast<MyTypeObject *>(component.create()));
+    QVERIFY(second != nullptr);
+    QCOMPARE(second->urlProperty(), url);
+    const QUrl literalUrl = QUrl::fromEncoded("main.qml?with%3cencoded%3edata", QUrl::TolerantMode);
+    QCOMPARE(second->urlProperty(), QQmlPropertyPrivate::resolveUrlsOnAssignment()
+                                            ? component.url().resolved(literalUrl)
+                                            : literalUrl);
+    QCOMPARE(second->colorProperty(), color);
+    QCOMPARE(second->pointProperty(), point);
+    QCOMPARE(second->rectFProperty(), rectF);
+    QCOMPARE(second->dateTimeProperty(), dateTime);
+    QCOMPARE(second->vector4Property(), vector4);
+    QCOMPARE(second->enumProperty(), MyTypeObject::EnumVal2);
+    QCOMPARE(second->qtEnumProperty(), Qt::RichText);
+    QCOMPARE(second->flagProperty(), MyTypeObject::FlagVal1 | MyTypeObject::FlagVal3);
+    QCOMPARE(second->property("qtEnumTriggeredChange").toBool(), false);
+}
+
 // Test edge case type assignments
 void tst_qqmllanguage::assignTypeExtremes()
 {
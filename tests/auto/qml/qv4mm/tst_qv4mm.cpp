@@ -27,6 +27,8 @@ private slots:
     void accessParentOnDestruction();
     void cleanInternalClasses();
     void createObjectsOnDestruction();
+    void generationalWritesDuringSweep();
+    void generationalContainerWrites();
 };
 
 tst_qv4mm::tst_qv4mm()
@@ -206,6 +208,104 @@ void tst_qv4mm::createObjectsOnDestruction()
     QCOMPARE(obj->property("ok").toBool(), true);
 }
 
+void tst_qv4mm::generationalWritesDuringSweep()
+{
+    // The statistics would keep the sweep in the foreground.
+    QLoggingCategory::setFilterRules("qt.qml.gc.*=false");
+    qputenv(QV4_MM_GENERATIONAL_GC, "1");
+    QV4::ExecutionEngine engine;
+    qunsetenv(QV4_MM_GENERATIONAL_GC);
+    QV4::MemoryManager *mm = engine.memoryManager;
+    QVERIFY(mm->generationalGC);
+
+    QV4::Scope scope(&engine);
+    QV4::ScopedString child(scope, engine.newIdentifier(QStringLiteral("child")));
+    QV4::ScopedString value(scope, engine.newIdentifier(QStringLiteral("value")));
+    QV4::ScopedArrayObject oldObjects(scope, engine.newArrayObject());
+    QV4::ScopedObject o(scope);
+    QV4::ScopedObject young(scope);
+    QV4::ScopedValue v(scope);
+
+    const uint numOld = 1024;
+    for (uint i = 0; i < numOld; ++i) {
+        o = engine.newObject();
+        oldObjects->push_back(o);
+    }
+
+    for (uint round = 0; round < 8; ++round) {
+        // Leave plenty of garbage behind, so that the sweep is still busy below.
+        for (uint i = 0; i < 64 * 1024; ++i)
+            engine.newObject();
+        mm->runGC();
+        QVERIFY(mm->plainObjectAllocator.pendingSweep);
+
+        // Everything is old now. Make the old objects point to young ones while the sweep
+        // is running. Only the remembered set keeps the young objects alive after this.
+        for (uint i = 0; i < numOld; ++i) {
+            o = oldObjects->get(i);
+            young = engine.newObject();
+            young->put(value, QV4::Value::fromUInt32(i + round));
+            o->put(child, young);
+        }
+
+        mm->runMinorGC();
+        for (uint i = 0; i < 64 * 1024; ++i)
+            engine.newObject();
+
+        for (uint i = 0; i < numOld; ++i) {
+            o = oldObjects->get(i);
+            young = o->get(child);
+            QVERIFY(young);
+            v = young->get(value);
+            QCOMPARE(v->toUInt32(), i + round);
+        }
+    }
+}
+
+void tst_qv4mm::generationalContainerWrites()
+{
+    QLoggingCategory::setFilterRules("qt.qml.gc.*=false");
+    qputenv(QV4_MM_GENERATIONAL_GC, "1");
+    QJSEngine engine;
+    qunsetenv(QV4_MM_GENERATIONAL_GC);
+    QV4::MemoryManager *mm = engine.handle()->memoryManager;
+    QVERIFY(mm->generationalGC);
+
+    engine.evaluate(QStringLiteral(
+            "var map = new Map; var set = new Set; var array = []; var sparse = [];"
+            "sparse[100000] = 0;"));
+    mm->runGC();
+
+    // The containers are old now. Only the write barrier on their stores can keep the
+    // young objects stored below alive.
+    QJSValue result = engine.evaluate(QStringLiteral(
+            "for (var i = 0; i < 1000; ++i) {"
+            "    map.set(i, { value: i });"
+            "    set.add({ value: i });"
+            "    array.push({ value: i });"
+            "    sparse[i * 100] = { value: i };"
+            "}"));
+    QVERIFY(!result.isError());
+    mm->runMinorGC();
+
+    // Re-use the memory of anything that was freed by mistake.
+    engine.evaluate(QStringLiteral("for (var i = 0; i < 100000; ++i) ({ value: -1 });"));
+
+    result = engine.evaluate(QStringLiteral(
+            "(function() {"
+            "    var fromSet = Array.from(set);"
+            "    for (var i = 0; i < 1000; ++i) {"
+            "        if (map.get(i).value !== i || fromSet[i].value !== i"
+            "                || array[i].value !== i || sparse[i * 100].value !== i) {"
+            "            return false;"
+            "        }"
+            "    }"
+            "    return true;"
+            "})()"));
+    QVERIFY(result.isBool());
+    QVERIFY(result.toBool());
+}
+
 QTEST_MAIN(tst_qv4mm)
 
 #include "tst_qv4mm.moc"
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include <QtCore/QString>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/qscopeguard.h>
 #include <QtTest/QtTest>
 
 #include <QtQuick/qsgnode.h>
@@ -81,6 +83,12 @@ private Q_SLOTS:
     void textureNodeRect_data();
     void textureNodeRect();
 
+    void bufferArena_data();
+    void bufferArena();
+
+    void atlasPages_data();
+    void atlasPages();
+
 private:
     void rhiTestData();
 
@@ -489,6 +497,173 @@ void NodesTest::textureNodeRect()
     renderContext->invalidate();
 }
 
+void NodesTest::bufferArena_data()
+{
+    rhiTestData();
+}
+
+void NodesTest::bufferArena()
+{
+    QFETCH(QRhi::Implementation, impl);
+    QFETCH(QRhiInitParams *, initParams);
+    QScopedPointer<QRhi> rhi(QRhi::create(impl, initParams, QRhi::Flags(), nullptr));
+    if (!rhi)
+        QSKIP("Failed to create QRhi, skipping test");
+
+    QSGBatchRenderer::BufferArena arena;
+    arena.init(QRhiBuffer::Immutable, QRhiBuffer::VertexBuffer, 4096);
+    QSGBatchRenderer::Buffer a = {};
+    QSGBatchRenderer::Buffer b = {};
+    QSGBatchRenderer::Buffer c = {};
+
+    // Ranges are rounded up to 256 bytes and handed out first fit
+    QVERIFY(arena.allocate(rhi.data(), &a, 100));
+    QVERIFY(arena.allocate(rhi.data(), &b, 300));
+    QCOMPARE(arena.blockCount(), 1);
+    QCOMPARE(arena.takeCreatedBlockCount(), 1);
+    QCOMPARE(a.buf, b.buf);
+    QCOMPARE(a.offset, 0u);
+    QCOMPARE(a.capacity, 256u);
+    QCOMPARE(b.offset, 256u);
+    QCOMPARE(b.capacity, 512u);
+    QCOMPARE(arena.usedBytes(), quint64(768));
+    QCOMPARE(arena.totalBytes(), quint64(4096));
+
+    // Nothing to store takes no range
+    QVERIFY(arena.allocate(rhi.data(), &c, 0));
+    QVERIFY(!c.buf);
+    QVERIFY(!c.block);
+    QCOMPARE(arena.usedBytes(), quint64(768));
+
+    // Data that still fits keeps its range
+    QVERIFY(arena.allocate(rhi.data(), &a, 256));
+    QCOMPARE(a.offset, 0u);
+    QCOMPARE(a.capacity, 256u);
+
+    // Released ranges are reused
+    arena.release(&a);
+    QVERIFY(!a.block);
+    QCOMPARE(arena.usedBytes(), quint64(512));
+    QVERIFY(arena.allocate(rhi.data(), &c, 200));
+    QCOMPARE(c.offset, 0u);
+    QCOMPARE(arena.usedBytes(), quint64(768));
+
+    // Growing into the free range behind it doesn't move b
+    QVERIFY(arena.allocate(rhi.data(), &b, 1000));
+    QCOMPARE(b.offset, 256u);
+    QCOMPARE(b.capacity, 1024u);
+    QCOMPARE(arena.takeCreatedBlockCount(), 0);
+
+    // Shrinking to nothing gives the range back
+    QVERIFY(arena.allocate(rhi.data(), &b, 0));
+    QVERIFY(!b.block);
+    QCOMPARE(arena.usedBytes(), quint64(256));
+
+    // Freed neighbors merge, so that a range spanning them fits again
+    arena.release(&c);
+    QCOMPARE(arena.usedBytes(), quint64(0));
+    QVERIFY(arena.allocate(rhi.data(), &a, 4096));
+    QCOMPARE(a.offset, 0u);
+    QCOMPARE(arena.blockCount(), 1);
+    arena.release(&a);
+
+    // Blocks of the regular size stay around until explicitly released
+    QCOMPARE(arena.blockCount(), 1);
+    arena.releaseUnusedBlocks();
+    QCOMPARE(arena.blockCount(), 0);
+
+    // Oversized blocks are dropped as soon as they are empty
+    QVERIFY(arena.allocate(rhi.data(), &a, 10000));
+    QCOMPARE(arena.blockCount(), 1);
+    QCOMPARE(arena.takeCreatedBlockCount(), 1);
+    QVERIFY(arena.totalBytes() >= 10000u);
+    arena.release(&a);
+    QCOMPARE(arena.blockCount(), 0);
+    QCOMPARE(arena.totalBytes(), quint64(0));
+}
+
+void NodesTest::atlasPages_data()
+{
+    rhiTestData();
+}
+
+void NodesTest::atlasPages()
+{
+    qputenv("QSG_ATLAS_WIDTH", "64");
+    qputenv("QSG_ATLAS_HEIGHT", "64");
+    qputenv("QSG_ATLAS_PAGES", "2");
+    QLoggingCategory::setFilterRules(QStringLiteral("qt.scenegraph.atlas.debug=true"));
+    auto cleanup = qScopeGuard([] {
+        qunsetenv("QSG_ATLAS_WIDTH");
+        qunsetenv("QSG_ATLAS_HEIGHT");
+        qunsetenv("QSG_ATLAS_PAGES");
+        QLoggingCategory::setFilterRules(QString());
+    });
+
+    INIT_RHI();
+
+    QImage image(20, 20, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::red);
+    const auto create = [&image, this]() {
+        return renderContext->createTexture(image, QSGRenderContext::CreateTexture_Atlas
+                                                   | QSGRenderContext::CreateTexture_Alpha);
+    };
+
+    // Textures of one page share the comparison key, so it tells the pages apart
+    QTest::ignoreMessage(QtDebugMsg, "added atlas page 1");
+    QList<QSGTexture *> firstPage = { create() };
+    QVERIFY(firstPage.first()->isAtlasTexture());
+    const qint64 firstKey = firstPage.first()->comparisonKey();
+
+    // Spill into a second page once the first one is full
+    QTest::ignoreMessage(QtDebugMsg, "added atlas page 2");
+    QList<QSGTexture *> secondPage;
+    while (secondPage.isEmpty()) {
+        QSGTexture *t = create();
+        QVERIFY(t->isAtlasTexture());
+        if (t->comparisonKey() == firstKey)
+            firstPage.append(t);
+        else
+            secondPage.append(t);
+        QVERIFY(firstPage.size() < 64);
+    }
+    QVERIFY(firstPage.size() > 1);
+    const qint64 secondKey = secondPage.first()->comparisonKey();
+    while (secondPage.size() < firstPage.size()) {
+        secondPage.append(create());
+        QCOMPARE(secondPage.last()->comparisonKey(), secondKey);
+    }
+
+    // Beyond the page limit, images get textures of their own
+    QScopedPointer<QSGTexture> standalone(create());
+    QVERIFY(!standalone->isAtlasTexture());
+    standalone.reset();
+
+    // A page that is still in use stays and takes new textures again
+    while (secondPage.size() > 1)
+        delete secondPage.takeLast();
+    renderContext->endSync();
+    secondPage.append(create());
+    QCOMPARE(secondPage.last()->comparisonKey(), secondKey);
+
+    // An empty page other than the first one is released at the end of the sync
+    qDeleteAll(secondPage);
+    secondPage.clear();
+    QTest::ignoreMessage(QtDebugMsg, "released empty atlas page, 1 left");
+    renderContext->endSync();
+
+    // The first page stays even when empty
+    qDeleteAll(firstPage);
+    firstPage.clear();
+    renderContext->endSync();
+    QScopedPointer<QSGTexture> reused(create());
+    QVERIFY(reused->isAtlasTexture());
+    QCOMPARE(reused->comparisonKey(), firstKey);
+    reused.reset();
+
+    renderContext->invalidate();
+}
+
 QTEST_MAIN(NodesTest);
 
 #include "tst_nodestest.moc"
@@ -0,0 +1,183 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QtTest>
+#include <QtCore/qlibraryinfo.h>
+#include <QtCore/qprocess.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtGui/qrawfont.h>
+#include <QtQuick/qquickwindow.h>
+
+#include <QtQuick/private/qsgcontext_p.h>
+#include <QtQuick/private/qsgdefaultrendercontext_p.h>
+#include <QtQuick/private/qsgrenderloop_p.h>
+#include <QtQuick/private/qsgrhidistancefieldglyphcache_p.h>
+#include <QtGui/private/qrhinull_p.h>
+
+#include <QtQuickTestUtils/private/qmlutils_p.h>
+
+// Feeds the output of qmlglyphatlas to the glyph cache that loads it.
+class tst_qmlglyphatlas : public QQmlDataTest
+{
+    Q_OBJECT
+
+public:
+    tst_qmlglyphatlas();
+
+private slots:
+    void initTestCase() override;
+    void cleanupTestCase();
+
+    void roundTrip();
+    void truncated_data();
+    void truncated();
+
+private:
+    QString m_qmlglyphatlasPath;
+    QTemporaryDir m_outputDir;
+    QRawFont m_font;
+    QByteArray m_atlas;
+    QList<glyph_t> m_glyphs;
+
+    QRhiNullInitParams m_initParams;
+    QScopedPointer<QRhi> m_rhi;
+    QSGDefaultRenderContext *m_renderContext = nullptr;
+};
+
+static const char glyphText[] = "Hello, distance field atlas! 0123456789";
+
+tst_qmlglyphatlas::tst_qmlglyphatlas()
+    : QQmlDataTest(QT_QMLTEST_DATADIR)
+{
+}
+
+void tst_qmlglyphatlas::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+
+    m_qmlglyphatlasPath = QLibraryInfo::path(QLibraryInfo::BinariesPath) + QLatin1String("/qmlglyphatlas");
+#ifdef Q_OS_WIN
+    m_qmlglyphatlasPath += QLatin1String(".exe");
+#endif
+    if (!QFileInfo(m_qmlglyphatlasPath).exists()) {
+        QString message = QStringLiteral("qmlglyphatlas executable not found (looked for %0)").arg(m_qmlglyphatlasPath);
+        QFAIL(qPrintable(message));
+    }
+
+    const QString fontFile = testFile("tarzeau_ocr_a.ttf");
+    m_font = QRawFont(fontFile, 12);
+    QVERIFY(m_font.isValid());
+    // Empty glyphs, like the space, are not part of the atlas
+    for (quint32 glyph : m_font.glyphIndexesForString(QString::fromLatin1(glyphText))) {
+        if (!m_font.pathForGlyph(glyph).isEmpty() && !m_glyphs.contains(glyph))
+            m_glyphs.append(glyph);
+    }
+    QVERIFY(!m_glyphs.isEmpty());
+
+    QVERIFY(m_outputDir.isValid());
+    QProcess process;
+    process.start(m_qmlglyphatlasPath,
+                  { QStringLiteral("-o"), m_outputDir.path(),
+                    QStringLiteral("-t"), QString::fromLatin1(glyphText),
+                    fontFile });
+    QVERIFY(process.waitForFinished());
+    QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+    QVERIFY2(process.exitCode() == 0, process.readAllStandardError().constData());
+
+    QFile atlasFile(QDir(m_outputDir.path()).filePath(
+            QSGRhiDistanceFieldGlyphCache::atlasFileName(m_font, -1)));
+    QVERIFY2(atlasFile.open(QIODevice::ReadOnly), qPrintable(atlasFile.errorString()));
+    m_atlas = atlasFile.readAll();
+    QVERIFY(!m_atlas.isEmpty());
+
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Null);
+    m_rhi.reset(QRhi::create(QRhi::Null, &m_initParams));
+    QVERIFY(m_rhi);
+    QSGRenderLoop *renderLoop = QSGRenderLoop::instance();
+    QSGRenderContext *rc = renderLoop->createRenderContext(renderLoop->sceneGraphContext());
+    QSGRendererInterface *rif = renderLoop->sceneGraphContext()->rendererInterface(rc);
+    if (!QSGRendererInterface::isApiRhiBased(rif->graphicsApi())) {
+        delete rc;
+        QSKIP("Skipping due to using software backend");
+    }
+    m_renderContext = static_cast<QSGDefaultRenderContext *>(rc);
+    QSGDefaultRenderContext::InitParams rcParams;
+    rcParams.rhi = m_rhi.data();
+    rcParams.initialSurfacePixelSize = QSize(512, 512);
+    m_renderContext->initialize(&rcParams);
+    QVERIFY(m_renderContext->isValid());
+}
+
+void tst_qmlglyphatlas::cleanupTestCase()
+{
+    if (m_renderContext) {
+        m_renderContext->invalidate();
+        delete m_renderContext;
+    }
+}
+
+void tst_qmlglyphatlas::roundTrip()
+{
+    QSGRhiDistanceFieldGlyphCache cache(m_renderContext, m_font, -1);
+    QVERIFY(cache.loadAtlas(m_font, m_atlas));
+
+    // Same font without the atlas, generating everything itself
+    QSGRhiDistanceFieldGlyphCache reference(m_renderContext, m_font, -1);
+
+    QCOMPARE(cache.doubleGlyphResolution(), reference.doubleGlyphResolution());
+    for (glyph_t glyph : std::as_const(m_glyphs)) {
+        const QSGDistanceFieldGlyphCache::TexCoord c = cache.glyphTexCoord(glyph);
+        QVERIFY(c.isValid());
+        QVERIFY(!c.isNull());
+        QVERIFY(qAbs(c.xMargin - reference.distanceFieldRadius()) < 0.001);
+
+        const QSGDistanceFieldGlyphCache::Texture *texture = cache.glyphTexture(glyph);
+        QVERIFY(texture);
+        QVERIFY(texture->texture);
+
+        const QSGDistanceFieldGlyphCache::Metrics loaded = cache.glyphMetrics(glyph, 16);
+        const QSGDistanceFieldGlyphCache::Metrics generated = reference.glyphMetrics(glyph, 16);
+        QVERIFY(qAbs(loaded.width - generated.width) < 0.001);
+        QVERIFY(qAbs(loaded.height - generated.height) < 0.001);
+        QVERIFY(qAbs(loaded.baselineX - generated.baselineX) < 0.001);
+        QVERIFY(qAbs(loaded.baselineY - generated.baselineY) < 0.001);
+
+        QVERIFY(!reference.glyphTexCoord(glyph).isValid());
+    }
+
+    // An atlas for another renderTypeQuality is rejected
+    QSGRhiDistanceFieldGlyphCache otherQuality(m_renderContext, m_font, 64);
+    QVERIFY(!otherQuality.loadAtlas(m_font, m_atlas));
+}
+
+void tst_qmlglyphatlas::truncated_data()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("empty") << 0;
+    QTest::newRow("atlas header") << 52;
+    QTest::newRow("qtdf header") << 60;
+    QTest::newRow("half") << int(m_atlas.size() / 2);
+    QTest::newRow("last byte missing") << int(m_atlas.size() - 1);
+}
+
+void tst_qmlglyphatlas::truncated()
+{
+    QFETCH(int, size);
+
+    QSGRhiDistanceFieldGlyphCache cache(m_renderContext, m_font, -1);
+    QVERIFY(!cache.loadAtlas(m_font, m_atlas.left(size)));
+
+    // Nothing was taken over from the partial atlas
+    for (glyph_t glyph : std::as_const(m_glyphs))
+        QVERIFY(!cache.glyphTexCoord(glyph).isValid());
+
+    // So the complete one still loads
+    QVERIFY(cache.loadAtlas(m_font, m_atlas));
+    for (glyph_t glyph : std::as_const(m_glyphs))
+        QVERIFY(cache.glyphTexCoord(glyph).isValid());
+}
+
+QTEST_MAIN(tst_qmlglyphatlas)
+
+#include "tst_qmlglyphatlas.moc"
@@ -22,6 +22,7 @@
 #include <private/qguiapplication_p.h>
 #include <QtGui/qpa/qplatformintegration.h>
 #include <QRunnable>
+#include <QScopeGuard>
 #include <QSGRendererInterface>
 #include <QQuickRenderControl>
 #include <QOperatingSystemVersion>
@@ -541,6 +542,8 @@ private slots:
     void rendererInterfaceWithRenderControl();
 
     void graphicsConfiguration();
+    void frameStatistics_data();
+    void frameStatistics();
 
 private:
     QPointingDevice *touchDevice;
@@ -4053,6 +4056,87 @@ void tst_qquickwindow::graphicsConfiguration()
 #endif
 }
 
+void tst_qquickwindow::frameStatistics_data()
+{
+    QTest::addColumn<QByteArray>("qml");
+    QTest::addColumn<int>("opaqueBatchCount");
+    QTest::addColumn<int>("alphaBatchCount");
+    QTest::addColumn<qint64>("uploadedBytes");
+
+    // Both are merged batches of a single four vertex triangle strip. Merged
+    // batches get a float of z data per vertex, and six 32-bit indices since
+    // the strip is padded with degenerate triangles.
+
+    // Vertices are two floats for the position and four bytes for the color
+    QTest::newRow("rectangle")
+            << QByteArray("import QtQuick\n"
+                          "Rectangle { width: 100; height: 100; color: \"red\" }")
+            << 1 << 0 << qint64(4 * 12 + 4 * 4 + 6 * 4);
+    // Vertices are two floats each for the position and texture coordinate,
+    // the image has an alpha channel
+    QTest::newRow("image")
+            << QByteArray("import QtQuick\n"
+                          "Image { source: \"colors.png\" }")
+            << 0 << 1 << qint64(4 * 16 + 4 * 4 + 6 * 4);
+}
+
+void tst_qquickwindow::frameStatistics()
+{
+    QFETCH(QByteArray, qml);
+    QFETCH(int, opaqueBatchCount);
+    QFETCH(int, alphaBatchCount);
+    QFETCH(qint64, uploadedBytes);
+
+    // Merged index data is 16-bit or 32-bit depending on the backend
+    qputenv("QSG_RHI_UINT32_INDEX", "1");
+    auto cleanup = qScopeGuard([] { qunsetenv("QSG_RHI_UINT32_INDEX"); });
+
+    QQuickWindow window;
+    QVERIFY(!window.frameStatistics().isValid());
+    window.resize(250, 250);
+    window.setTitle(QTest::currentTestFunction());
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    if (!QSGRendererInterface::isApiRhiBased(window.rendererInterface()->graphicsApi()))
+        QSKIP("Frame statistics come from the batch renderer");
+
+    QTRY_VERIFY(window.frameStatistics().isValid());
+    const QQuickFrameStatistics empty = window.frameStatistics();
+    QVERIFY(empty.frameNumber() > 0);
+    QVERIFY(empty.polishTime() >= 0);
+    QVERIFY(empty.syncTime() >= 0);
+    QVERIFY(empty.renderPrepareTime() >= 0);
+    QVERIFY(empty.renderRecordTime() >= 0);
+    QCOMPARE(empty.opaqueBatchCount(), 0);
+    QCOMPARE(empty.alphaBatchCount(), 0);
+    QCOMPARE(empty.nodeCount(), 0);
+    QCOMPARE(empty.uploadedBytes(), qint64(0));
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(qml, dataDirectoryUrl());
+    QScopedPointer<QQuickItem> item(qobject_cast<QQuickItem *>(component.create()));
+    QVERIFY2(item, qPrintable(component.errorString()));
+    item->setParentItem(window.contentItem());
+
+    // The frame that picks up the item uploads its geometry
+    QTRY_VERIFY(window.frameStatistics().frameNumber() > empty.frameNumber());
+    const QQuickFrameStatistics stats = window.frameStatistics();
+    QCOMPARE(stats.opaqueBatchCount(), opaqueBatchCount);
+    QCOMPARE(stats.alphaBatchCount(), alphaBatchCount);
+    QCOMPARE(stats.nodeCount(), 1);
+    QCOMPARE(stats.uploadedBytes(), uploadedBytes);
+
+    // Nothing is uploaded again as long as the item doesn't change
+    window.update();
+    QTRY_VERIFY(window.frameStatistics().frameNumber() > stats.frameNumber());
+    const QQuickFrameStatistics unchanged = window.frameStatistics();
+    QCOMPARE(unchanged.opaqueBatchCount(), opaqueBatchCount);
+    QCOMPARE(unchanged.alphaBatchCount(), alphaBatchCount);
+    QCOMPARE(unchanged.nodeCount(), 1);
+    QCOMPARE(unchanged.uploadedBytes(), qint64(0));
+}
+
 QTEST_MAIN(tst_qquickwindow)
 
 #include "tst_qquickwindow.moc"
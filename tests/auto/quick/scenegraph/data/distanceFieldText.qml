@@ -0,0 +1,18 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick
+
+Rectangle {
+    width: 240
+    height: 120
+    color: "white"
+
+    Text {
+        anchors.fill: parent
+        anchors.margins: 4
+        font.pixelSize: 16
+        wrapMode: Text.WrapAnywhere
+        text: "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789!@#$%^&*()_"
+    }
+}
@@ -0,0 +1,59 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick
+
+Rectangle {
+    width: 320
+    height: 240
+    color: "white"
+
+    // Batches of nodes with identical geometry, differing only in their
+    // transform and stacking order.
+    Repeater {
+        model: 64
+        Rectangle {
+            x: (index % 16) * 20 + 2
+            y: Math.floor(index / 16) * 14 + 2
+            width: 14
+            height: 10
+            rotation: (index % 4) * 15
+            color: "steelblue"
+        }
+    }
+
+    Repeater {
+        model: 32
+        Image {
+            x: (index % 16) * 20 + 2
+            y: 60 + Math.floor(index / 16) * 20
+            width: 16
+            height: 16
+            scale: 1 - (index % 3) * 0.2
+            source: "logo-small.jpg"
+        }
+    }
+
+    Repeater {
+        model: 32
+        Image {
+            x: (index % 16) * 20 + 2
+            y: 110 + Math.floor(index / 16) * 20
+            source: "mipmap_small.png"
+        }
+    }
+
+    // Antialiased images use a shader that must not be instanced.
+    Repeater {
+        model: 32
+        Image {
+            x: (index % 16) * 20 + 2
+            y: 160 + Math.floor(index / 16) * 30
+            width: 16
+            height: 16
+            rotation: 20
+            antialiasing: true
+            source: "logo-small.jpg"
+        }
+    }
+}
@@ -0,0 +1,37 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick
+
+Rectangle {
+    width: 320
+    height: 240
+    color: "white"
+
+    // Many batches of different sizes, so that the uploads get split over
+    // several tasks.
+    Repeater {
+        model: 96
+        Rectangle {
+            x: (index % 12) * 26 + 4
+            y: Math.floor(index / 12) * 14 + 4
+            width: 22
+            height: 10
+            radius: index % 3
+            rotation: index % 5 == 0 ? 10 : 0
+            antialiasing: index % 2 == 0
+            color: Qt.hsva((index * 37 % 360) / 360, 1, 0.8, 1)
+        }
+    }
+
+    Repeater {
+        model: 12
+        Text {
+            x: 4
+            y: 120 + index * 10
+            font.pixelSize: 8
+            color: Qt.hsva((index * 53 % 360) / 360, 1, 0.6, 1)
+            text: "The quick brown fox jumps over the lazy dog " + index
+        }
+    }
+}
@@ -27,6 +27,8 @@
 #include <QtGui/private/qguiapplication_p.h>
 #include <QtGui/qpa/qplatformintegration.h>
 
+#include <QtCore/qscopeguard.h>
+
 using namespace QQuickVisualTestUtils;
 
 class PerPixelRect : public QQuickItem
@@ -89,6 +91,10 @@ private slots:
 
     void render_data();
     void render();
+    void parallelUpload_data();
+    void parallelUpload();
+    void instancing();
+    void distanceFieldGlyphCache();
 #if QT_CONFIG(opengl)
     void hideWithOtherContext();
 #endif
@@ -100,6 +106,7 @@ private slots:
 private:
     QQuickView *createView(const QString &file, QWindow *parent = nullptr, int x = -1, int y = -1, int w = -1, int h = -1);
     bool isRunningOnRhi();
+    QImage grabWithRendererSetting(const QString &file, const char *name, const QByteArray &value);
 };
 
 template <typename T> class ScopedList : public QList<T> {
@@ -452,6 +459,137 @@ void tst_SceneGraph::render()
     }
 }
 
+// The batch renderer reads its QSG_RENDERER_* settings when it is created, so
+// every grab gets a new window.
+QImage tst_SceneGraph::grabWithRendererSetting(const QString &file, const char *name,
+                                               const QByteArray &value)
+{
+    qputenv(name, value);
+    auto cleanup = qScopeGuard([name] { qunsetenv(name); });
+
+    QQuickView view;
+    view.setSource(testFileUrl(file));
+    view.setResizeMode(QQuickView::SizeViewToRootObject);
+    view.show();
+    if (!QTest::qWaitForWindowExposed(&view))
+        return QImage();
+    return view.grabWindow();
+}
+
+void tst_SceneGraph::parallelUpload_data()
+{
+    QTest::addColumn<QByteArray>("threads");
+
+    QTest::newRow("2 threads") << QByteArray("2");
+    QTest::newRow("4 threads") << QByteArray("4");
+}
+
+void tst_SceneGraph::parallelUpload()
+{
+    if (!isRunningOnRhi())
+        QSKIP("Skipping batch upload test due to not running with QRhi");
+
+    QFETCH(QByteArray, threads);
+
+    // Split the uploads regardless of the amount of vertex data
+    qputenv("QSG_RENDERER_PARALLEL_UPLOAD_THRESHOLD", "0");
+    auto cleanup = qScopeGuard([] { qunsetenv("QSG_RENDERER_PARALLEL_UPLOAD_THRESHOLD"); });
+
+    const QImage serial = grabWithRendererSetting("parallelUpload.qml",
+                                                  "QSG_RENDERER_UPLOAD_THREADS", "1");
+    QVERIFY(!serial.isNull());
+    QVERIFY(containsSomethingOtherThanWhite(serial));
+
+    const QImage parallel = grabWithRendererSetting("parallelUpload.qml",
+                                                    "QSG_RENDERER_UPLOAD_THREADS", threads);
+    QVERIFY(!parallel.isNull());
+
+    QString errorMessage;
+    QVERIFY2(compareImages(parallel, serial, &errorMessage), qPrintable(errorMessage));
+}
+
+void tst_SceneGraph::instancing()
+{
+    if (!isRunningOnRhi())
+        QSKIP("Skipping instancing test due to not running with QRhi");
+
+    const QImage merged = grabWithRendererSetting("instancing.qml",
+                                                  "QSG_RENDERER_INSTANCING_THRESHOLD", "0");
+    QVERIFY(!merged.isNull());
+    QVERIFY(containsSomethingOtherThanWhite(merged));
+
+    const QImage instanced = grabWithRendererSetting("instancing.qml",
+                                                     "QSG_RENDERER_INSTANCING_THRESHOLD", "2");
+    QVERIFY(!instanced.isNull());
+
+    QString errorMessage;
+    QVERIFY2(compareImages(instanced, merged, &errorMessage), qPrintable(errorMessage));
+}
+
+static QStringList distanceFieldCacheFiles(const QString &path)
+{
+    QStringList files;
+    QDirIterator it(path, { QStringLiteral("*.qdf") }, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+        files.append(it.next());
+    return files;
+}
+
+void tst_SceneGraph::distanceFieldGlyphCache()
+{
+    if (!isRunningOnRhi())
+        QSKIP("Skipping distance field test due to not running with QRhi");
+
+    // Glyphs generated on the render thread, without any disk cache
+    const QImage reference = grabWithRendererSetting("distanceFieldText.qml",
+                                                     "QSG_DISTANCEFIELD_ASYNC_THRESHOLD", "0");
+    QVERIFY(!reference.isNull());
+    QVERIFY(containsSomethingOtherThanWhite(reference));
+
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    qputenv("QSG_DISTANCEFIELD_CACHE_DIR", QFile::encodeName(cacheDir.path()));
+    qputenv("QSG_DISTANCEFIELD_ASYNC_THRESHOLD", "1");
+    auto cleanup = qScopeGuard([] {
+        qunsetenv("QSG_DISTANCEFIELD_CACHE_DIR");
+        qunsetenv("QSG_DISTANCEFIELD_ASYNC_THRESHOLD");
+    });
+
+    QString errorMessage;
+    {
+        // The glyphs are left out until the worker threads are done with them
+        QQuickView view;
+        view.setSource(testFileUrl("distanceFieldText.qml"));
+        view.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&view));
+        QTRY_VERIFY2(compareImages(view.grabWindow(), reference, &errorMessage),
+                     qPrintable(errorMessage));
+    }
+
+    // Every generated glyph went to the disk cache
+    QStringList files = distanceFieldCacheFiles(cacheDir.path());
+    QVERIFY(!files.isEmpty());
+
+    // A damaged entry is generated again instead of being used
+    const qint64 entrySize = QFileInfo(files.first()).size();
+    {
+        QFile damaged(files.first());
+        QVERIFY(damaged.open(QIODevice::ReadWrite));
+        QVERIFY(damaged.resize(damaged.size() / 2));
+    }
+
+    // Glyphs read back from the cache look the same as freshly generated ones
+    qputenv("QSG_DISTANCEFIELD_ASYNC_THRESHOLD", "0");
+    const QImage cached = grabWithRendererSetting("distanceFieldText.qml",
+                                                  "QSG_DISTANCEFIELD_CACHE_DIR",
+                                                  QFile::encodeName(cacheDir.path()));
+    QVERIFY(!cached.isNull());
+    QVERIFY2(compareImages(cached, reference, &errorMessage), qPrintable(errorMessage));
+
+    QCOMPARE(distanceFieldCacheFiles(cacheDir.path()).size(), files.size());
+    QCOMPARE(QFileInfo(files.first()).size(), entrySize);
+}
+
 #if QT_CONFIG(opengl)
 // Testcase for QTBUG-34898. We make another context current on another surface
 // in the GUI thread and hide the QQuickWindow while the other context is
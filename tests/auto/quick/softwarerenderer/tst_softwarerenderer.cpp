@@ -22,6 +22,7 @@ private slots:
     void initTestCase() override;
 
     void renderTarget();
+    void transparentLayerWithSmallOpaqueItem();
 };
 
 tst_SoftwareRenderer::tst_SoftwareRenderer()
@@ -93,6 +94,46 @@ void tst_SoftwareRenderer::renderTarget()
              qPrintable(errorMessage));
 }
 
+void tst_SoftwareRenderer::transparentLayerWithSmallOpaqueItem()
+{
+    if (QQuickWindow::sceneGraphBackend() != "software")
+        QSKIP("Skipping complex rendering tests due to not running with software");
+
+    // The layer is rendered into a transparent pixmap. It must be cleared even though an
+    // opaque item covers part of it, or what was painted before shows through.
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick\n"
+                      "Rectangle {\n"
+                      "    width: 20; height: 20; color: \"blue\"\n"
+                      "    Item {\n"
+                      "        width: 20; height: 20\n"
+                      "        layer.enabled: true\n"
+                      "        Rectangle { objectName: \"inner\"; width: 20; height: 20; color: \"red\" }\n"
+                      "    }\n"
+                      "}\n", QUrl());
+    QScopedPointer<QQuickItem> root(qobject_cast<QQuickItem *>(component.create()));
+    QVERIFY2(root, qPrintable(component.errorString()));
+
+    QQuickWindow window;
+    window.resize(20, 20);
+    root->setParentItem(window.contentItem());
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QImage content = window.grabWindow();
+    QCOMPARE(content.pixelColor(10, 10), QColor(Qt::red));
+
+    QQuickItem *inner = root->findChild<QQuickItem *>("inner");
+    QVERIFY(inner);
+    inner->setSize(QSizeF(4, 4));
+
+    content = window.grabWindow();
+    QCOMPARE(content.pixelColor(2, 2), QColor(Qt::red));
+    QCOMPARE(content.pixelColor(10, 10), QColor(Qt::blue));
+    QCOMPARE(content.pixelColor(19, 19), QColor(Qt::blue));
+}
+
 #include "tst_softwarerenderer.moc"
 
 QTEST_MAIN(tst_SoftwareRenderer)
@@ -0,0 +1,25 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick 2.0
+
+Item {
+    id: root
+    property int index: 0
+    property string label: "Item " + index
+    signal activated()
+
+    width: 200
+    height: 20
+    onActivated: ++index
+
+    Rectangle {
+        anchors.fill: parent
+        color: root.index % 2 ? "white" : "lightgray"
+    }
+    Text {
+        width: parent.width
+        text: root.label
+        elide: Text.ElideRight
+    }
+}
@@ -0,0 +1,19 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+import QtQuick 2.0
+
+Item {
+    property url source: "images/delegate.png"
+    property color background: "#80c0ff"
+    property color foreground: "steelblue"
+    property rect frame: "10,10,200x40"
+    property point origin: "4,4"
+    property size extent: "200x40"
+    property vector3d axis: "0,0,1"
+    property date created: "2022-10-01"
+
+    Rectangle { color: "red"; border.color: "#303030" }
+    Rectangle { color: "green"; border.color: "#303030" }
+    Rectangle { color: "blue"; border.color: "#303030" }
+}
@@ -10,6 +10,14 @@
 #include <QQmlContext>
 #include <private/qobject_p.h>
 
+#include <memory>
+#include <vector>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+#include <malloc.h>
+#define HAS_MALLINFO2
+#endif
+
 class tst_creation : public QObject
 {
     Q_OBJECT
@@ -46,6 +54,9 @@ private slots:
     void anchors_creation();
     void anchors_heightChange();
 
+    void delegate_memory_data();
+    void delegate_memory();
+
 private:
     QQmlEngine engine;
 };
@@ -278,6 +289,7 @@ void tst_creation::itemtests_qml_data()
     QTest::newRow("emptyItem") << "emptyItem.qml";
     QTest::newRow("emptyCustomItem") << "emptyCustomItem.qml";
     QTest::newRow("itemWithProperties") << "itemWithProperties.qml";
+    QTest::newRow("itemWithLiteralValues") << "itemWithLiteralValues.qml";
     QTest::newRow("itemUsingOnComponentCompleted") << "itemUsingOnComponentCompleted.qml";
     QTest::newRow("itemWithAnchoredChild") << "itemWithAnchoredChild.qml";
     QTest::newRow("itemWithChildBindedToSize") << "itemWithChildBindedToSize.qml";
@@ -419,6 +431,63 @@ void tst_creation::anchors_heightChange()
     delete obj;
 }
 
+void tst_creation::delegate_memory_data()
+{
+    QTest::addColumn<int>("measurement");
+
+    QTest::newRow("first batch") << 0;
+    QTest::newRow("retained after destruction") << 1;
+    QTest::newRow("reused") << 2;
+}
+
+void tst_creation::delegate_memory()
+{
+#ifdef HAS_MALLINFO2
+    QFETCH(int, measurement);
+
+    const int count = 1000;
+    static qint64 results[3];
+    static bool measured = false;
+
+    // Per delegate: the heap growth of the first batch, what is still allocated
+    // once it is destroyed, mostly storage kept by the recycle pools of the
+    // thread, and the heap growth of a second batch that can reuse it, as when
+    // scrolling views destroy delegates and create new ones. The pools keep
+    // what earlier benchmarks have freed, too. Run this function on its own
+    // to see all storage the first batch needs.
+    if (!measured) {
+        QQmlComponent component(&engine, TEST_FILE("delegate.qml"));
+        QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+
+        std::vector<std::unique_ptr<QObject>> delegates;
+        delegates.reserve(count);
+        auto createDelegates = [&]() {
+            for (int i = 0; i < count; ++i)
+                delegates.emplace_back(component.create());
+        };
+        auto heapSize = []() { return qint64(mallinfo2().uordblks); };
+
+        const qint64 initial = heapSize();
+        createDelegates();
+        const qint64 created = heapSize();
+        delegates.clear();
+        const qint64 destroyed = heapSize();
+        createDelegates();
+        const qint64 recreated = heapSize();
+        delegates.clear();
+
+        results[0] = created - initial;
+        results[1] = destroyed - initial;
+        results[2] = recreated - destroyed;
+        measured = true;
+    }
+
+    QTest::setBenchmarkResult(qreal(results[measurement]) / count, QTest::BytesAllocated);
+#else
+    QSKIP("Heap statistics are only available with glibc.");
+#endif
+}
+
 QTEST_MAIN(tst_creation)
 
 #include "tst_creation.moc"
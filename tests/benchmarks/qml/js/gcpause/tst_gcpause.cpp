@@ -0,0 +1,68 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtQml/qjsengine.h>
+#include <private/qv4engine_p.h>
+#include <private/qv4mm_p.h>
+
+class tst_GCPause : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void maxPause_data();
+    void maxPause();
+};
+
+void tst_GCPause::maxPause_data()
+{
+    QTest::addColumn<bool>("incremental");
+    QTest::addColumn<int>("sliceTimeLimit");
+
+    QTest::newRow("stop-the-world") << false << 0;
+    QTest::newRow("incremental, 2ms slices") << true << 2;
+    QTest::newRow("incremental, 5ms slices") << true << 5;
+}
+
+void tst_GCPause::maxPause()
+{
+    QFETCH(bool, incremental);
+    QFETCH(int, sliceTimeLimit);
+
+    QJSEngine engine;
+    QV4::MemoryManager *mm = engine.handle()->memoryManager;
+    mm->incrementalGC = incremental;
+    if (sliceTimeLimit)
+        mm->gcSliceTimeLimit = sliceTimeLimit;
+
+    // A large long-lived heap that has to be marked on every collection ...
+    QJSValue result = engine.evaluate(QStringLiteral(
+            "var retained = [];"
+            "for (var i = 0; i < 300000; ++i)"
+            "    retained.push({ index: i, name: 'item' + i, children: [i, i + 1] });"));
+    QVERIFY(!result.isError());
+
+    // ... and a stream of short-lived garbage that keeps triggering the collector.
+    const QString churn = QStringLiteral(
+            "(function() {"
+            "    var sum = 0;"
+            "    for (var i = 0; i < 200000; ++i) {"
+            "        var tmp = { a: i, b: [i, i * 2], c: 'x' + i };"
+            "        sum += tmp.b.length;"
+            "    }"
+            "    return sum;"
+            "})()");
+
+    mm->statistics.maxGCPause = 0;
+    for (int i = 0; i < 5; ++i) {
+        result = engine.evaluate(churn);
+        QVERIFY(!result.isError());
+    }
+
+    QTest::setBenchmarkResult(mm->statistics.maxGCPause, QTest::WalltimeNanoseconds);
+}
+
+QTEST_MAIN(tst_GCPause)
+
+#include "tst_gcpause.moc"
@@ -0,0 +1,129 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtQml/qjsengine.h>
+#include <private/qv4engine_p.h>
+#include <private/qv4executablecompilationunit_p.h>
+#include <private/qv4lookup_p.h>
+
+class tst_PolymorphicLookup : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void getter_data() { shapes_data(); }
+    void getter();
+    void setter_data() { shapes_data(); }
+    void setter();
+
+private:
+    void shapes_data();
+    void reportHitRate(QJSEngine *engine);
+};
+
+void tst_PolymorphicLookup::shapes_data()
+{
+    QTest::addColumn<int>("shapes");
+
+    QTest::newRow("monomorphic") << 1;
+    QTest::newRow("2 shapes") << 2;
+    QTest::newRow("4 shapes") << 4;
+    QTest::newRow("6 shapes") << 6;
+    QTest::newRow("8 shapes") << 8;
+    QTest::newRow("megamorphic (12 shapes)") << 12;
+}
+
+// Creates objects that all have a property "x", but differ in the properties added before it,
+// so that they end up with different internal classes.
+static QString createObjects(int shapes)
+{
+    return QStringLiteral(
+            "var objects = [];"
+            "for (var i = 0; i < 1200; ++i) {"
+            "    var o = {};"
+            "    for (var j = 0; j < i % %1; ++j)"
+            "        o['p' + j] = j;"
+            "    o.x = i;"
+            "    objects.push(o);"
+            "}").arg(shapes);
+}
+
+void tst_PolymorphicLookup::reportHitRate(QJSEngine *engine)
+{
+    quint64 hits = 0;
+    quint64 misses = 0;
+    int polymorphic = 0;
+    for (const QV4::ExecutableCompilationUnit *unit : engine->handle()->compilationUnits) {
+        if (!unit->runtimeLookups)
+            continue;
+        for (uint i = 0; i < unit->unitData()->lookupTableSize; ++i) {
+            const QV4::Lookup &l = unit->runtimeLookups[i];
+            if (l.getter == QV4::Lookup::getterPolymorphic
+                    || l.setter == QV4::Lookup::setterPolymorphic) {
+                ++polymorphic;
+                hits += l.polymorphicLookup.table->hits;
+                misses += l.polymorphicLookup.table->misses;
+            }
+        }
+    }
+
+    if (hits + misses == 0) {
+        qInfo("no polymorphic lookups");
+        return;
+    }
+    qInfo("%d polymorphic lookups, hit rate %.2f%%", polymorphic,
+          100.0 * double(hits) / double(hits + misses));
+}
+
+void tst_PolymorphicLookup::getter()
+{
+    QFETCH(int, shapes);
+
+    QJSEngine engine;
+    QJSValue result = engine.evaluate(createObjects(shapes));
+    QVERIFY(!result.isError());
+
+    const QString read = QStringLiteral(
+            "(function() {"
+            "    var sum = 0;"
+            "    for (var n = 0; n < 50; ++n) {"
+            "        for (var i = 0; i < objects.length; ++i)"
+            "            sum += objects[i].x;"
+            "    }"
+            "    return sum;"
+            "})()");
+
+    QBENCHMARK {
+        result = engine.evaluate(read);
+    }
+    QVERIFY(!result.isError());
+    reportHitRate(&engine);
+}
+
+void tst_PolymorphicLookup::setter()
+{
+    QFETCH(int, shapes);
+
+    QJSEngine engine;
+    QJSValue result = engine.evaluate(createObjects(shapes));
+    QVERIFY(!result.isError());
+
+    const QString write = QStringLiteral(
+            "(function() {"
+            "    for (var n = 0; n < 50; ++n) {"
+            "        for (var i = 0; i < objects.length; ++i)"
+            "            objects[i].x = n;"
+            "    }"
+            "})()");
+
+    QBENCHMARK {
+        result = engine.evaluate(write);
+    }
+    QVERIFY(!result.isError());
+    reportHitRate(&engine);
+}
+
+QTEST_MAIN(tst_PolymorphicLookup)
+
+#include "tst_polymorphiclookup.moc"
@@ -0,0 +1,139 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtTest/qsignalspy.h>
+#include <QtGui/qguiapplication.h>
+#include <QtQml/qqmlcomponent.h>
+#include <QtQuick/qquickview.h>
+#include <QtQuick/qquickitem.h>
+
+// Measures the frame time of the batch renderer for scenes with many glyphs
+// or rectangles on the RHI null backend, so that vertex preparation and upload
+// dominates. Each row sets one QSG_RENDERER_* variable, which the renderer
+// reads when it is created.
+class tst_BatchRenderer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void movingItems_data();
+    void movingItems();
+};
+
+static const char textSceneQml[] = R"(
+import QtQuick
+
+Item {
+    property int phase: 0
+    property int count: 0
+
+    Repeater {
+        model: count
+        Text {
+            // Different colors end up in different batches
+            color: Qt.hsva((index * 37 % 360) / 360, 1, 0.8, 1)
+            x: (index % 8) * 160 + (phase + index) % 16
+            y: Math.floor(index / 8) * 24
+            width: 150
+            wrapMode: Text.WrapAnywhere
+            font.pixelSize: 8
+            text: "The quick brown fox jumps over the lazy dog. ".repeat(12)
+        }
+    }
+}
+)";
+
+static const char rectangleSceneQml[] = R"(
+import QtQuick
+
+Item {
+    property int phase: 0
+    property int count: 0
+
+    Repeater {
+        model: count
+        Rectangle {
+            // Same size and color everywhere, so all geometry is identical
+            color: "steelblue"
+            x: (index % 64) * 20 + (phase + index) % 4
+            y: Math.floor(index / 64) * 12
+            width: 16
+            height: 8
+        }
+    }
+}
+)";
+
+void tst_BatchRenderer::movingItems_data()
+{
+    QTest::addColumn<QByteArray>("scene");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<QByteArray>("variable");
+    QTest::addColumn<QByteArray>("value");
+
+    for (int count : { 64, 256 }) {
+        QTest::addRow("text, serial, %d", count)
+                << QByteArray(textSceneQml) << count
+                << QByteArray("QSG_RENDERER_UPLOAD_THREADS") << QByteArray("1");
+        QTest::addRow("text, 4 threads, %d", count)
+                << QByteArray(textSceneQml) << count
+                << QByteArray("QSG_RENDERER_UPLOAD_THREADS") << QByteArray("4");
+    }
+    for (int count : { 1024, 4096 }) {
+        QTest::addRow("rectangles, merged, %d", count)
+                << QByteArray(rectangleSceneQml) << count
+                << QByteArray("QSG_RENDERER_INSTANCING_THRESHOLD") << QByteArray("0");
+        QTest::addRow("rectangles, instanced, %d", count)
+                << QByteArray(rectangleSceneQml) << count
+                << QByteArray("QSG_RENDERER_INSTANCING_THRESHOLD") << QByteArray("16");
+    }
+}
+
+void tst_BatchRenderer::movingItems()
+{
+    QFETCH(QByteArray, scene);
+    QFETCH(int, count);
+    QFETCH(QByteArray, variable);
+    QFETCH(QByteArray, value);
+
+    qputenv(variable.constData(), value);
+    QQuickView view;
+    view.resize(1280, 800);
+    auto *component = new QQmlComponent(view.engine(), &view);
+    component->setData(scene, QUrl());
+    view.setContent(QUrl(), component, component->create());
+    QQuickItem *root = view.rootObject();
+    QVERIFY(root);
+    root->setProperty("count", count);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QSignalSpy frames(&view, &QQuickWindow::frameSwapped);
+    int phase = 0;
+
+    // Get the first frame out of the way
+    root->setProperty("phase", ++phase);
+    QVERIFY(frames.wait(5000));
+    qunsetenv(variable.constData());
+
+    QBENCHMARK {
+        root->setProperty("phase", ++phase);
+        QVERIFY(frames.wait(5000));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Null);
+    // Split uploads regardless of the amount of vertex data
+    qputenv("QSG_RENDERER_PARALLEL_UPLOAD_THRESHOLD", "0");
+
+    QGuiApplication app(argc, argv);
+    tst_BatchRenderer tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "tst_batchrenderer.moc"
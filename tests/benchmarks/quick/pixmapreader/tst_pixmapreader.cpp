@@ -0,0 +1,186 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtGui/qimage.h>
+#include <QtGui/qpainter.h>
+#include <QtQml/qqmlcomponent.h>
+#include <QtQml/qqmlengine.h>
+#include <QtQuick/qquickview.h>
+
+#include <memory>
+
+// Measures how long it takes until a grid of asynchronously loaded thumbnails is complete.
+// Set QML_PIXMAP_READER_THREADS to compare different numbers of decode threads.
+class tst_PixmapReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void allLoaded_data();
+    void allLoaded();
+    void visibleLoaded_data();
+    void visibleLoaded();
+
+private:
+    QObject *createGrid(QQmlEngine *engine, int count);
+
+    QTemporaryDir m_imageDir;
+};
+
+static const int imageCount = 200;
+static const int visibleCount = 20;
+
+static const char gridQml[] = R"(
+import QtQuick
+
+Item {
+    property url dir
+    property int count
+    property int loaded: 0
+
+    Repeater {
+        model: count
+        Image {
+            asynchronous: true
+            cache: false
+            sourceSize: Qt.size(128, 128)
+            source: dir + "/image" + (index % 200) + ".png"
+            onStatusChanged: {
+                if (status === Image.Ready)
+                    ++loaded;
+            }
+        }
+    }
+}
+)";
+
+// 5 x 4 cells are in view, the rows below them are in the cache buffer and culled by the view.
+static const char viewQml[] = R"(
+import QtQuick
+
+GridView {
+    id: view
+    property url dir
+    property int visibleLoaded: 0
+
+    width: 640
+    height: 512
+    cellWidth: 128
+    cellHeight: 128
+    model: 200
+
+    delegate: Image {
+        required property int index
+
+        width: 128
+        height: 128
+        asynchronous: true
+        cache: false
+        sourceSize: Qt.size(128, 128)
+        source: view.dir + "/image" + index + ".png"
+        onStatusChanged: {
+            if (status === Image.Ready && index < 20)
+                ++view.visibleLoaded;
+        }
+    }
+}
+)";
+
+void tst_PixmapReader::initTestCase()
+{
+    QVERIFY(m_imageDir.isValid());
+
+    // Photo-like images with a lot of detail, so that decoding takes a realistic amount of time.
+    for (int i = 0; i < imageCount; ++i) {
+        QImage image(1024, 768, QImage::Format_RGB32);
+        QPainter painter(&image);
+        QLinearGradient gradient(0, 0, image.width(), image.height());
+        gradient.setColorAt(0, QColor::fromHsv((i * 37) % 360, 200, 220));
+        gradient.setColorAt(1, QColor::fromHsv((i * 91) % 360, 120, 80));
+        painter.fillRect(image.rect(), gradient);
+        for (int j = 0; j < 400; ++j) {
+            painter.setPen(QColor::fromHsv((i * 13 + j * 7) % 360, 255, 255));
+            painter.drawEllipse(QPoint((j * 97 + i) % image.width(), (j * 61 + i * 3) % image.height()),
+                                (j % 40) + 5, (j % 25) + 5);
+        }
+        painter.end();
+        QVERIFY(image.save(m_imageDir.filePath(QStringLiteral("image%1.png").arg(i))));
+    }
+
+    QFile view(m_imageDir.filePath(QStringLiteral("view.qml")));
+    QVERIFY(view.open(QIODevice::WriteOnly));
+    view.write(viewQml);
+}
+
+QObject *tst_PixmapReader::createGrid(QQmlEngine *engine, int count)
+{
+    QQmlComponent component(engine);
+    component.setData(gridQml, QUrl());
+    if (!component.isReady()) {
+        qWarning() << component.errorString();
+        return nullptr;
+    }
+
+    return component.createWithInitialProperties({
+        { QStringLiteral("dir"), QUrl::fromLocalFile(m_imageDir.path()) },
+        { QStringLiteral("count"), count },
+    });
+}
+
+void tst_PixmapReader::allLoaded_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("20 thumbnails") << 20;
+    QTest::newRow("200 thumbnails") << 200;
+}
+
+void tst_PixmapReader::allLoaded()
+{
+    QFETCH(int, count);
+
+    QQmlEngine engine;
+    QBENCHMARK {
+        std::unique_ptr<QObject> grid(createGrid(&engine, count));
+        QVERIFY(grid);
+        QTRY_COMPARE_WITH_TIMEOUT(grid->property("loaded").toInt(), count, 60000);
+    }
+}
+
+void tst_PixmapReader::visibleLoaded_data()
+{
+    QTest::addColumn<int>("cacheBuffer");
+
+    QTest::newRow("no cache buffer") << 0;
+    QTest::newRow("cache buffer of 36 rows") << 36 * 128;
+}
+
+// Time until the delegates in view of a GridView show their images. The delegates the view
+// creates in its cache buffer are culled, and their images should not hold up the visible ones.
+void tst_PixmapReader::visibleLoaded()
+{
+    QFETCH(int, cacheBuffer);
+
+    QBENCHMARK {
+        QQuickView view;
+        view.setInitialProperties({
+            { QStringLiteral("dir"), QUrl::fromLocalFile(m_imageDir.path()) },
+            { QStringLiteral("cacheBuffer"), cacheBuffer },
+        });
+        view.setSource(QUrl::fromLocalFile(m_imageDir.filePath(QStringLiteral("view.qml"))));
+        QVERIFY(view.rootObject());
+        view.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&view));
+        QTRY_COMPARE_WITH_TIMEOUT(view.rootObject()->property("visibleLoaded").toInt(),
+                                  visibleCount, 60000);
+    }
+}
+
+QTEST_MAIN(tst_PixmapReader)
+
+#include "tst_pixmapreader.moc"
@@ -0,0 +1,156 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <qtest.h>
+#include <QtTest/qsignalspy.h>
+#include <QtGui/qguiapplication.h>
+#include <QtQml/qqmlcomponent.h>
+#include <QtQuick/qquickview.h>
+#include <QtQuick/qquickitem.h>
+
+#include <memory>
+
+// Measures the frame time of the software adaptation on the offscreen platform,
+// with QSG_SOFTWARE_RENDER_THREADS set to different numbers of paint threads.
+class tst_SoftwareRenderer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fullUpdate_data();
+    void fullUpdate();
+    void smallUpdate_data();
+    void smallUpdate();
+
+private:
+    std::unique_ptr<QQuickView> createView(const QByteArray &threads);
+    void measureFrames(QQuickView *view, const char *property);
+};
+
+static const char sceneQml[] = R"(
+import QtQuick
+
+Rectangle {
+    property int phase: 0
+    property int cursor: 0
+    color: "white"
+
+    Grid {
+        columns: 16
+        spacing: 4
+        Repeater {
+            model: 160
+            Rectangle {
+                width: 76
+                height: 76
+                radius: 8
+                border.width: 2
+                border.color: Qt.hsva(((index + phase) * 7 % 360) / 360, 1, 0.5, 1)
+                gradient: Gradient {
+                    GradientStop { position: 0; color: Qt.hsva(((index + phase) * 13 % 360) / 360, 0.6, 1, 1) }
+                    GradientStop { position: 1; color: Qt.hsva(((index + phase) * 29 % 360) / 360, 0.8, 0.6, 1) }
+                }
+                Text {
+                    anchors.centerIn: parent
+                    text: index + phase
+                    font.pixelSize: 20
+                }
+            }
+        }
+    }
+
+    Rectangle {
+        x: (cursor * 17) % 1200
+        y: (cursor * 11) % 720
+        width: 64
+        height: 64
+        color: "red"
+    }
+}
+)";
+
+std::unique_ptr<QQuickView> tst_SoftwareRenderer::createView(const QByteArray &threads)
+{
+    // Read when the renderer is created
+    qputenv("QSG_SOFTWARE_RENDER_THREADS", threads);
+
+    auto view = std::make_unique<QQuickView>();
+    view->setResizeMode(QQuickView::SizeRootObjectToView);
+    view->resize(1280, 800);
+    auto *component = new QQmlComponent(view->engine(), view.get());
+    component->setData(QByteArray(sceneQml), QUrl());
+    view->setContent(QUrl(), component, component->create());
+    if (!view->rootObject())
+        return nullptr;
+    view->show();
+    if (!QTest::qWaitForWindowExposed(view.get()))
+        return nullptr;
+    return view;
+}
+
+void tst_SoftwareRenderer::measureFrames(QQuickView *view, const char *property)
+{
+    QQuickItem *root = view->rootObject();
+    QSignalSpy frames(view, &QQuickWindow::frameSwapped);
+    int value = 0;
+
+    // Get the first frame out of the way
+    root->setProperty(property, ++value);
+    QVERIFY(frames.wait(5000));
+
+    QBENCHMARK {
+        root->setProperty(property, ++value);
+        QVERIFY(frames.wait(5000));
+    }
+}
+
+static void addThreadCountRows()
+{
+    QTest::addColumn<QByteArray>("threads");
+
+    QTest::newRow("serial") << QByteArray("1");
+    QTest::newRow("2 threads") << QByteArray("2");
+    QTest::newRow("4 threads") << QByteArray("4");
+    QTest::newRow("ideal") << QByteArray("0");
+}
+
+void tst_SoftwareRenderer::fullUpdate_data()
+{
+    addThreadCountRows();
+}
+
+void tst_SoftwareRenderer::fullUpdate()
+{
+    QFETCH(QByteArray, threads);
+
+    auto view = createView(threads);
+    QVERIFY(view);
+    measureFrames(view.get(), "phase");
+}
+
+void tst_SoftwareRenderer::smallUpdate_data()
+{
+    addThreadCountRows();
+}
+
+void tst_SoftwareRenderer::smallUpdate()
+{
+    QFETCH(QByteArray, threads);
+
+    auto view = createView(threads);
+    QVERIFY(view);
+    measureFrames(view.get(), "cursor");
+}
+
+int main(int argc, char **argv)
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+
+    QGuiApplication app(argc, argv);
+    tst_SoftwareRenderer tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "tst_softwarerenderer.moc"
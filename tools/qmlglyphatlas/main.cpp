@@ -0,0 +1,339 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtGui/qguiapplication.h>
+#include <QtGui/qrawfont.h>
+#include <QtGui/qtransform.h>
+#include <QtCore/qcommandlineparser.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qmath.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qset.h>
+
+#include <QtGui/private/qdistancefield_p.h>
+#include <QtGui/private/qrawfont_p.h>
+#include <QtQuick/private/qsgareaallocator_p.h>
+#include <QtQuick/private/qsgrhidistancefieldglyphcache_p.h>
+
+#include <algorithm>
+#include <memory>
+
+// The file layout must match what QSGRhiDistanceFieldGlyphCache::loadPregeneratedCache() reads
+static const quint32 atlasMagic = 0x51444641; // "QDFA"
+static const quint32 atlasVersion = 1;
+static const quint8 qtdfMajorVersion = 5;
+static const quint8 qtdfMinorVersion = 12;
+static const int glyphPadding = 2; // QSG_RHI_DISTANCEFIELD_GLYPH_CACHE_PADDING
+static const int maxTextureCount = 16;
+
+struct Glyph
+{
+    glyph_t index = 0;
+    QPainterPath path;
+    QRectF boundingRect; // in base font size
+    QRect area; // allocated area including padding, all textures stacked vertically
+};
+
+struct Options
+{
+    QString outputDirectory;
+    QList<int> renderTypeQualities;
+    QString text;
+    bool allGlyphs = false;
+    int textureSize = 2048;
+};
+
+static void append(QByteArray &data, quint8 value)
+{
+    data.append(char(value));
+}
+
+static void append(QByteArray &data, quint16 value)
+{
+    value = qToBigEndian(value);
+    data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+static void append(QByteArray &data, quint32 value)
+{
+    value = qToBigEndian(value);
+    data.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+static quint32 toFixedPoint(qreal value)
+{
+    return quint32(qint32(qRound(value * 65536)));
+}
+
+static bool layoutGlyphs(QList<Glyph> &glyphs, QSGAreaAllocator *allocator, qreal radius)
+{
+    for (Glyph &glyph : glyphs) {
+        const QSize size(qCeil(glyph.boundingRect.width() + radius * 2) + glyphPadding * 2,
+                         qCeil(glyph.boundingRect.height() + radius * 2) + glyphPadding * 2);
+        glyph.area = allocator->allocate(size);
+        if (glyph.area.isNull())
+            return false;
+    }
+    return true;
+}
+
+static bool writeAtlas(const QRawFont &sourceFont, const QList<glyph_t> &glyphIndexes,
+                       int renderTypeQuality, const Options &options)
+{
+    const int glyphCount = QRawFontPrivate::get(sourceFont)->fontEngine->glyphCount();
+    const bool doubleResolution = qt_fontHasNarrowOutlines(sourceFont)
+            && glyphCount < QT_DISTANCEFIELD_HIGHGLYPHCOUNT();
+    const int baseFontSize = renderTypeQuality > 0 ? renderTypeQuality
+                                                   : QT_DISTANCEFIELD_BASEFONTSIZE(doubleResolution);
+    const int scale = QT_DISTANCEFIELD_SCALE(doubleResolution);
+    const qreal radius = QT_DISTANCEFIELD_RADIUS(doubleResolution) / qreal(scale);
+    const int textureSize = options.textureSize;
+
+    QRawFont font = sourceFont;
+    font.setPixelSize(baseFontSize * scale);
+
+    QList<Glyph> glyphs;
+    glyphs.reserve(glyphIndexes.size());
+    const QTransform scaleDown = QTransform::fromScale(1.0 / scale, 1.0 / scale);
+    for (glyph_t index : glyphIndexes) {
+        Glyph glyph;
+        glyph.index = index;
+        glyph.path = font.pathForGlyph(index);
+        glyph.boundingRect = scaleDown.mapRect(glyph.path.boundingRect());
+        // Empty glyphs need no space in the atlas, the glyph cache handles them itself
+        if (!glyph.boundingRect.isEmpty())
+            glyphs.append(glyph);
+    }
+
+    // Tallest first packs considerably better
+    std::sort(glyphs.begin(), glyphs.end(), [](const Glyph &a, const Glyph &b) {
+        return a.boundingRect.height() > b.boundingRect.height();
+    });
+
+    std::unique_ptr<QSGAreaAllocator> allocator;
+    int textureCount = 0;
+    do {
+        if (++textureCount > maxTextureCount) {
+            fprintf(stderr, "%s: glyphs do not fit in %d textures of %dx%d\n",
+                    qPrintable(font.familyName()), maxTextureCount, textureSize, textureSize);
+            return false;
+        }
+        allocator.reset(new QSGAreaAllocator(QSize(textureSize, textureSize * textureCount)));
+    } while (!layoutGlyphs(glyphs, allocator.get(), radius));
+
+    QList<QSize> textureSizes(textureCount, QSize(1, 1));
+    for (const Glyph &glyph : std::as_const(glyphs)) {
+        QSize &size = textureSizes[glyph.area.y() / textureSize];
+        size = size.expandedTo(QSize(glyph.area.right() + 1, glyph.area.bottom() % textureSize + 1));
+    }
+
+    QList<QByteArray> textures;
+    for (const QSize &size : std::as_const(textureSizes))
+        textures.append(QByteArray(size.width() * size.height(), 0));
+
+    QByteArray glyphRecords;
+    for (const Glyph &glyph : std::as_const(glyphs)) {
+        const int textureIndex = glyph.area.y() / textureSize;
+        const QPoint position(glyph.area.x() + glyphPadding,
+                              glyph.area.y() % textureSize + glyphPadding);
+
+        // Same placement as QSGRhiDistanceFieldGlyphCache::storeGlyphs()
+        const QDistanceField distanceField(glyph.path, glyph.index, doubleResolution);
+        const int expectedWidth = qCeil(glyph.boundingRect.width() + radius * 2);
+        const QSize &size = textureSizes.at(textureIndex);
+        const int width = qMin(qMin(distanceField.width(), expectedWidth), size.width() - position.x());
+        const int height = qMin(distanceField.height(), size.height() - position.y());
+        char *texture = textures[textureIndex].data();
+        for (int y = 0; y < height; ++y) {
+            memcpy(texture + (position.y() + y) * size.width() + position.x(),
+                   distanceField.scanLine(y), width);
+        }
+
+        append(glyphRecords, quint32(glyph.index));
+        append(glyphRecords, toFixedPoint(position.x()));
+        append(glyphRecords, toFixedPoint(position.y()));
+        append(glyphRecords, toFixedPoint(glyph.boundingRect.width()));
+        append(glyphRecords, toFixedPoint(glyph.boundingRect.height()));
+        append(glyphRecords, toFixedPoint(radius));
+        append(glyphRecords, toFixedPoint(radius));
+        append(glyphRecords, toFixedPoint(glyph.boundingRect.x()));
+        append(glyphRecords, toFixedPoint(glyph.boundingRect.y()));
+        append(glyphRecords, toFixedPoint(glyph.boundingRect.width()));
+        append(glyphRecords, toFixedPoint(glyph.boundingRect.height()));
+        append(glyphRecords, quint16(textureIndex));
+    }
+
+    QByteArray atlas;
+    append(atlas, atlasMagic);
+    append(atlas, atlasVersion);
+    atlas.append(QSGDistanceFieldGlyphCache::fontHash(sourceFont));
+    append(atlas, quint32(renderTypeQuality));
+
+    append(atlas, qtdfMajorVersion);
+    append(atlas, qtdfMinorVersion);
+    append(atlas, quint16(baseFontSize * scale));
+    append(atlas, quint32(textureSize));
+    append(atlas, quint8(doubleResolution ? 1 : 0));
+    append(atlas, quint8(glyphPadding));
+    append(atlas, quint32(glyphs.size()));
+    atlas.append(allocator->serialize());
+    for (const QSize &size : std::as_const(textureSizes)) {
+        append(atlas, quint32(0));
+        append(atlas, quint32(0));
+        append(atlas, quint32(size.width()));
+        append(atlas, quint32(size.height()));
+        append(atlas, quint8(glyphPadding));
+    }
+    atlas.append(glyphRecords);
+    for (const QByteArray &texture : std::as_const(textures))
+        atlas.append(texture);
+
+    const QString fileName = QDir(options.outputDirectory).filePath(
+                QSGRhiDistanceFieldGlyphCache::atlasFileName(sourceFont, renderTypeQuality));
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || file.write(atlas) != atlas.size() || !file.commit()) {
+        fprintf(stderr, "Cannot write %s: %s\n",
+                qPrintable(QDir::toNativeSeparators(fileName)), qPrintable(file.errorString()));
+        return false;
+    }
+
+    printf("%s %s: %d glyphs in %d textures, written to %s\n",
+           qPrintable(font.familyName()), qPrintable(font.styleName()),
+           int(glyphs.size()), textureCount, qPrintable(QDir::toNativeSeparators(fileName)));
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    // Only fonts are needed, never a screen
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("qmlglyphatlas"));
+    QCoreApplication::setApplicationVersion(QLatin1String(QT_VERSION_STR));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral(
+            "Pre-renders distance field glyphs into atlas files, which Qt Quick loads instead of "
+            "generating the glyphs when QSG_DISTANCEFIELD_ATLAS_PATH contains the output directory."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption outputOption({ QStringLiteral("o"), QStringLiteral("output-dir") },
+                                    QStringLiteral("Write the atlas files to <directory>."),
+                                    QStringLiteral("directory"), QStringLiteral("."));
+    parser.addOption(outputOption);
+    QCommandLineOption qualityOption({ QStringLiteral("q"), QStringLiteral("render-type-quality") },
+                                     QStringLiteral("Generate an atlas for Text items with this "
+                                                    "renderTypeQuality. Can be given several times. "
+                                                    "The default is Text.DefaultRenderTypeQuality."),
+                                     QStringLiteral("quality"));
+    parser.addOption(qualityOption);
+    QCommandLineOption textOption({ QStringLiteral("t"), QStringLiteral("text") },
+                                  QStringLiteral("Include the glyphs for the characters in <text>."),
+                                  QStringLiteral("text"));
+    parser.addOption(textOption);
+    QCommandLineOption textFileOption(QStringLiteral("text-file"),
+                                      QStringLiteral("Include the glyphs for the characters in "
+                                                     "the UTF-8 encoded <file>."),
+                                      QStringLiteral("file"));
+    parser.addOption(textFileOption);
+    QCommandLineOption allGlyphsOption({ QStringLiteral("a"), QStringLiteral("all-glyphs") },
+                                       QStringLiteral("Include all glyphs of the fonts."));
+    parser.addOption(allGlyphsOption);
+    QCommandLineOption textureSizeOption(QStringLiteral("texture-size"),
+                                         QStringLiteral("Use textures of <size>x<size> pixels "
+                                                        "(default: 2048)."),
+                                         QStringLiteral("size"));
+    parser.addOption(textureSizeOption);
+    parser.addPositionalArgument(QStringLiteral("fonts"), QStringLiteral("Font files."),
+                                 QStringLiteral("fonts..."));
+
+    parser.process(app);
+
+    const QStringList fontFiles = parser.positionalArguments();
+    if (fontFiles.isEmpty())
+        parser.showHelp(1);
+
+    Options options;
+    options.outputDirectory = parser.value(outputOption);
+    options.allGlyphs = parser.isSet(allGlyphsOption);
+    options.text = parser.values(textOption).join(QString());
+
+    for (const QString &value : parser.values(qualityOption)) {
+        bool ok = false;
+        const int quality = value.toInt(&ok);
+        if (!ok || quality == 0 || quality < -1) {
+            fprintf(stderr, "Invalid render type quality: %s\n", qPrintable(value));
+            return 1;
+        }
+        options.renderTypeQualities.append(quality);
+    }
+    if (options.renderTypeQualities.isEmpty())
+        options.renderTypeQualities.append(-1);
+
+    if (parser.isSet(textureSizeOption)) {
+        bool ok = false;
+        options.textureSize = parser.value(textureSizeOption).toInt(&ok);
+        if (!ok || options.textureSize < 64) {
+            fprintf(stderr, "Invalid texture size: %s\n", qPrintable(parser.value(textureSizeOption)));
+            return 1;
+        }
+    }
+
+    for (const QString &textFile : parser.values(textFileOption)) {
+        QFile file(textFile);
+        if (!file.open(QIODevice::ReadOnly)) {
+            fprintf(stderr, "Cannot read %s: %s\n", qPrintable(textFile), qPrintable(file.errorString()));
+            return 1;
+        }
+        options.text += QString::fromUtf8(file.readAll());
+    }
+
+    if (!options.allGlyphs && options.text.isEmpty()) {
+        // Printable Latin-1 characters
+        for (char16_t c = 0x20; c <= 0xff; ++c) {
+            if (c < 0x7f || c >= 0xa0)
+                options.text += QChar(c);
+        }
+    }
+
+    if (!QDir().mkpath(options.outputDirectory)) {
+        fprintf(stderr, "Cannot create %s\n", qPrintable(options.outputDirectory));
+        return 1;
+    }
+
+    bool success = true;
+    for (const QString &fontFile : fontFiles) {
+        const QRawFont font(fontFile, 12);
+        if (!font.isValid()) {
+            fprintf(stderr, "Cannot load font %s\n", qPrintable(fontFile));
+            success = false;
+            continue;
+        }
+
+        QList<glyph_t> glyphIndexes;
+        if (options.allGlyphs) {
+            const int glyphCount = QRawFontPrivate::get(font)->fontEngine->glyphCount();
+            for (int i = 0; i < glyphCount; ++i)
+                glyphIndexes.append(glyph_t(i));
+        } else {
+            const QList<quint32> indexes = font.glyphIndexesForString(options.text);
+            QSet<glyph_t> seen;
+            for (quint32 index : indexes) {
+                if (index != 0 && !seen.contains(index)) {
+                    seen.insert(index);
+                    glyphIndexes.append(index);
+                }
+            }
+        }
+
+        for (int quality : std::as_const(options.renderTypeQualities))
+            success &= writeAtlas(font, glyphIndexes, quality, options);
+    }
+
+    return success ? 0 : 1;
+}